@@ -0,0 +1,436 @@
+// Accuracy-versus-speed harness for the projection kernels.
+//
+// Sweeps image sizes, FOVs, installation angles and attitudes, evaluates every registered
+// variant of pixel_to_ned, ned_to_pixel and pixel_after_rotation against a long-double
+// reference of the same camera model, and reports error percentiles (pixels) next to ns/point.
+// Integer-output kernels are compared against the truncated reference, only where it lands in frame;
+// "mismatch" counts points whose error is large enough to change the reported pixel (>= 0.5 px).
+// A faster variant is signed off by adding it to the variant tables below and checking that
+// its max error stays within --max-px.
+//
+// Usage: accuracy_harness [--quick] [--verbose] [--points N] [--max-px X]
+
+#include "image-to-body-math/body_space.hpp"
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace p2b;
+
+namespace
+{
+
+// ---- Long-double reference of the camera model ----
+
+using Real = long double;
+
+struct RefVec
+{
+    Real x, y, z;
+};
+
+struct RefQuat
+{
+    Real w, x, y, z;
+};
+
+RefQuat to_ref(const Quaternion &q)
+{
+    return {q.w, q.x, q.y, q.z};
+}
+
+RefQuat mul(const RefQuat &a, const RefQuat &b)
+{
+    return {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+}
+
+/// q v q^-1 (exact for non-unit q)
+RefVec rotate(const RefQuat &q, const RefVec &v)
+{
+    const Real n = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    const RefQuat r = mul(mul(q, RefQuat{0, v.x, v.y, v.z}), RefQuat{q.w, -q.x, -q.y, -q.z});
+    return {r.x / n, r.y / n, r.z / n};
+}
+
+RefQuat inverse(const RefQuat &q)
+{
+    const Real n = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    return {q.w / n, -q.x / n, -q.y / n, -q.z / n};
+}
+
+struct RefCamera
+{
+    Real half_width, half_height, pixel_to_tan;
+    RefQuat cam_to_body;
+
+    RefVec pixel_to_body(Real row, Real col) const
+    {
+        const Real w_tan = (row - half_width) * pixel_to_tan;
+        const Real h_tan = (col - half_height) * pixel_to_tan;
+        const Real cos_az = 1 / std::sqrt(1 + w_tan * w_tan);
+        const Real cos_el = 1 / std::sqrt(1 + h_tan * h_tan);
+        return rotate(cam_to_body, RefVec{cos_el * cos_az, cos_el * w_tan * cos_az, h_tan * cos_el});
+    }
+
+    /// Continuous (untruncated) pixel of a body-frame direction
+    std::pair<Real, Real> body_to_pixel(const RefVec &dir_body) const
+    {
+        const RefVec c = rotate(inverse(cam_to_body), dir_body);
+        const Real w_tan = c.y / c.x;
+        const Real h_tan = c.z / std::sqrt(c.x * c.x + c.y * c.y);
+        return {w_tan / pixel_to_tan + half_width, h_tan / pixel_to_tan + half_height};
+    }
+};
+
+// ---- Kernel variants under test ----
+
+using PixelToNedFn = Vector3 (*)(PixelIndex, PixelIndex, const ImageSize &, PixelToTan, const Quaternion &,
+                                 const Quaternion &) noexcept;
+using NedToPixelFn = std::pair<PixelIndex, PixelIndex> (*)(const Vector3 &, const ImageSize &, PixelToTan,
+                                                           const Quaternion &, const Quaternion &) noexcept;
+using AfterRotationFn = std::pair<PixelIndex, PixelIndex> (*)(PixelIndex, PixelIndex, const ImageSize &, PixelToTan,
+                                                              const Quaternion &, const Quaternion &,
+                                                              const Quaternion &, bool) noexcept;
+
+template <typename Fn>
+struct Variant
+{
+    std::string_view name;
+    Fn fn;
+};
+
+const std::array PIXEL_TO_NED_VARIANTS{Variant<PixelToNedFn>{"pixel_to_ned", &pixel_to_ned}};
+const std::array NED_TO_PIXEL_VARIANTS{Variant<NedToPixelFn>{"ned_to_pixel", &ned_to_pixel}};
+const std::array AFTER_ROTATION_VARIANTS{Variant<AfterRotationFn>{"pixel_after_rotation", &pixel_after_rotation}};
+
+// ---- Sweep configuration ----
+
+struct Options
+{
+    bool quick = false;
+    bool verbose = false;
+    size_t points = 4096;
+    double max_px = 1.5; // a truncation flip on both axes is sqrt(2) px
+};
+
+struct Config
+{
+    ImageSize size;
+    double fov_deg;
+    double install_deg;
+    Quaternion attitude;
+    Quaternion delta; // inter-frame rotation for pixel_after_rotation
+};
+
+Quaternion random_unit_quaternion(std::mt19937_64 &rng, double max_angle)
+{
+    std::normal_distribution<double> axis_dist(0.0, 1.0);
+    std::uniform_real_distribution<double> angle_dist(-max_angle, max_angle);
+    const double ax = axis_dist(rng);
+    const double ay = axis_dist(rng);
+    const double az = axis_dist(rng);
+    const double n = std::sqrt(ax * ax + ay * ay + az * az);
+    const double half = angle_dist(rng) / 2.0;
+    const double s = std::sin(half) / n;
+    return Quaternion{std::cos(half), ax * s, ay * s, az * s};
+}
+
+std::vector<Config> make_sweep(const Options &opt, std::mt19937_64 &rng)
+{
+    const std::vector<ImageSize> sizes = opt.quick ? std::vector<ImageSize>{{640, 480}}
+                                                   : std::vector<ImageSize>{{320, 256}, {1920, 1080}, {7680, 4320}};
+    const std::vector<double> fovs = opt.quick ? std::vector<double>{60.0} : std::vector<double>{10.0, 60.0, 120.0};
+    const std::vector<double> installs =
+        opt.quick ? std::vector<double>{15.0} : std::vector<double>{0.0, 15.0, 45.0, 90.0};
+    const size_t attitudes = opt.quick ? 2 : 8;
+
+    std::vector<Config> sweep;
+    for (const auto &size : sizes)
+        for (const double fov : fovs)
+            for (const double install : installs)
+                for (size_t a = 0; a < attitudes; ++a)
+                    sweep.push_back({size, fov, install, random_unit_quaternion(rng, linalg3d::PI),
+                                     random_unit_quaternion(rng, 0.05)});
+    return sweep;
+}
+
+// ---- Statistics ----
+
+struct Stats
+{
+    std::vector<double> errors;
+    size_t mismatches = 0;
+    double seconds = 0.0;
+    double worst = 0.0;
+    std::string worst_config;
+
+    void add(double err, const Config &cfg)
+    {
+        errors.push_back(err);
+        if (err >= 0.5) // enough to change the reported pixel
+        {
+            ++mismatches;
+        }
+        if (err > worst)
+        {
+            worst = err;
+            worst_config = fmt::format("{}x{} fov={} install={}", cfg.size.width, cfg.size.height, cfg.fov_deg,
+                                       cfg.install_deg);
+        }
+    }
+};
+
+double percentile(std::vector<double> &v, double p)
+{
+    if (v.empty())
+    {
+        return 0.0;
+    }
+    const auto k = static_cast<size_t>(p * static_cast<double>(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+template <typename Body>
+double time_per_point(size_t n, Body &&body)
+{
+    // Repeat until at least ~20 ms elapsed to get stable ns/point
+    using clock = std::chrono::steady_clock;
+    size_t reps = 0;
+    const auto t0 = clock::now();
+    auto t1 = t0;
+    do
+    {
+        body();
+        ++reps;
+        t1 = clock::now();
+    } while (t1 - t0 < std::chrono::milliseconds(20));
+    return std::chrono::duration<double>(t1 - t0).count() / static_cast<double>(reps * n);
+}
+
+volatile uint64_t g_sink = 0;
+
+// ---- Per-config evaluation ----
+
+struct Samples
+{
+    std::vector<PixelIndex> rows, cols;
+    std::vector<Vector3> neds;
+};
+
+Samples make_samples(const Config &cfg, const RefCamera &ref, const RefQuat &att, size_t n, std::mt19937_64 &rng)
+{
+    std::uniform_int_distribution<uint64_t> row_dist(0, cfg.size.width - 1);
+    std::uniform_int_distribution<uint64_t> col_dist(0, cfg.size.height - 1);
+    std::uniform_real_distribution<double> sub(0.0, 1.0);
+    Samples s;
+    for (size_t i = 0; i < n; ++i)
+    {
+        s.rows.emplace_back(row_dist(rng));
+        s.cols.emplace_back(col_dist(rng));
+        // NED inputs from sub-pixel positions so truncation boundaries are exercised
+        const RefVec d = rotate(att, ref.pixel_to_body(static_cast<Real>(s.rows.back().value()) + sub(rng),
+                                                       static_cast<Real>(s.cols.back().value()) + sub(rng)));
+        s.neds.emplace_back(static_cast<double>(d.x), static_cast<double>(d.y), static_cast<double>(d.z));
+    }
+    return s;
+}
+
+/// Unsigned pixel outputs are only meaningful for directions that stay inside the frame
+bool in_frame(Real row, Real col, const ImageSize &size)
+{
+    return row >= 0 && col >= 0 && row < static_cast<Real>(size.width) && col < static_cast<Real>(size.height);
+}
+
+double pixel_error(Real ref_row, Real ref_col, std::pair<PixelIndex, PixelIndex> got)
+{
+    // Kernels truncate; compare against the truncated reference
+    const Real dr = std::trunc(ref_row) - static_cast<Real>(got.first.value());
+    const Real dc = std::trunc(ref_col) - static_cast<Real>(got.second.value());
+    return static_cast<double>(std::sqrt(dr * dr + dc * dc));
+}
+
+void print_row(std::string_view name, Stats &s)
+{
+    const double p50 = percentile(s.errors, 0.50);
+    const double p99 = percentile(s.errors, 0.99);
+    const double p999 = percentile(s.errors, 0.999);
+    const double n = static_cast<double>(s.errors.size());
+    fmt::print("{:<24} {:>10} {:>12.3e} {:>12.3e} {:>12.3e} {:>12.3e} {:>9.4f}% {:>9.1f}\n", name, s.errors.size(),
+               p50, p99, p999, s.worst, 100.0 * static_cast<double>(s.mismatches) / n, s.seconds * 1e9 / n);
+    if (s.worst > 0.0)
+    {
+        fmt::print("{:<24} worst at {}\n", "", s.worst_config);
+    }
+}
+
+Options parse(int argc, char **argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view a = argv[i];
+        if (a == "--quick")
+        {
+            opt.quick = true;
+            opt.points = 512;
+        }
+        else if (a == "--verbose")
+            opt.verbose = true;
+        else if (a == "--points" && i + 1 < argc)
+            opt.points = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--max-px" && i + 1 < argc)
+            opt.max_px = std::strtod(argv[++i], nullptr);
+        else
+        {
+            fmt::print(stderr, "usage: {} [--quick] [--verbose] [--points N] [--max-px X]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const Options opt = parse(argc, argv);
+    std::mt19937_64 rng(0x5eed);
+    const auto sweep = make_sweep(opt, rng);
+
+    std::vector<Stats> p2n(PIXEL_TO_NED_VARIANTS.size());
+    std::vector<Stats> n2p(NED_TO_PIXEL_VARIANTS.size());
+    std::vector<Stats> rot(AFTER_ROTATION_VARIANTS.size());
+
+    for (const auto &cfg : sweep)
+    {
+        const PixelToTan ptt = pixel_to_tan_from_fov(cfg.size, Degrees{cfg.fov_deg}.to_radians());
+        const Quaternion cam_q = cam_to_body_from_angle(Degrees{cfg.install_deg}.to_radians());
+        const Quaternion q_new = cfg.attitude * cfg.delta;
+        const RefCamera ref{static_cast<Real>(cfg.size.half_width()), static_cast<Real>(cfg.size.half_height()),
+                            static_cast<Real>(ptt.get()), to_ref(cam_q)};
+        const RefQuat att = to_ref(cfg.attitude);
+        const RefQuat att_new = to_ref(q_new);
+        const auto s = make_samples(cfg, ref, att, opt.points, rng);
+        const size_t n = s.rows.size();
+
+        for (size_t v = 0; v < PIXEL_TO_NED_VARIANTS.size(); ++v)
+        {
+            const auto fn = PIXEL_TO_NED_VARIANTS[v].fn;
+            for (size_t i = 0; i < n; ++i)
+            {
+                // Error: where the kernel's direction lands in the reference camera, vs the input pixel
+                const Vector3 d = fn(s.rows[i], s.cols[i], cfg.size, ptt, cam_q, cfg.attitude);
+                auto [r, c] = ref.body_to_pixel(rotate(inverse(att), RefVec{d.x, d.y, d.z}));
+                const Real dr = r - static_cast<Real>(s.rows[i].value());
+                const Real dc = c - static_cast<Real>(s.cols[i].value());
+                p2n[v].add(static_cast<double>(std::sqrt(dr * dr + dc * dc)), cfg);
+            }
+            p2n[v].seconds += time_per_point(n,
+                                             [&]
+                                             {
+                                                 double acc = 0.0;
+                                                 for (size_t i = 0; i < n; ++i)
+                                                     acc += fn(s.rows[i], s.cols[i], cfg.size, ptt, cam_q,
+                                                               cfg.attitude)
+                                                                .x;
+                                                 g_sink = g_sink + static_cast<uint64_t>(acc);
+                                             }) *
+                              static_cast<double>(n);
+        }
+
+        for (size_t v = 0; v < NED_TO_PIXEL_VARIANTS.size(); ++v)
+        {
+            const auto fn = NED_TO_PIXEL_VARIANTS[v].fn;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto &d = s.neds[i];
+                auto [r, c] = ref.body_to_pixel(rotate(inverse(att), RefVec{d.x, d.y, d.z}));
+                n2p[v].add(pixel_error(r, c, fn(d, cfg.size, ptt, cam_q, cfg.attitude)), cfg);
+            }
+            n2p[v].seconds += time_per_point(n,
+                                             [&]
+                                             {
+                                                 uint64_t acc = 0;
+                                                 for (size_t i = 0; i < n; ++i)
+                                                     acc += fn(s.neds[i], cfg.size, ptt, cam_q, cfg.attitude)
+                                                                .first.value();
+                                                 g_sink = g_sink + acc;
+                                             }) *
+                              static_cast<double>(n);
+        }
+
+        for (size_t v = 0; v < AFTER_ROTATION_VARIANTS.size(); ++v)
+        {
+            const auto fn = AFTER_ROTATION_VARIANTS[v].fn;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const RefVec body = ref.pixel_to_body(static_cast<Real>(s.rows[i].value()),
+                                                      static_cast<Real>(s.cols[i].value()));
+                auto [r, c] = ref.body_to_pixel(rotate(inverse(att_new), rotate(att, body)));
+                if (!in_frame(r, c, cfg.size))
+                {
+                    continue;
+                }
+                rot[v].add(
+                    pixel_error(r, c, fn(s.rows[i], s.cols[i], cfg.size, ptt, cam_q, cfg.attitude, q_new, false)),
+                    cfg);
+            }
+            rot[v].seconds += time_per_point(n,
+                                             [&]
+                                             {
+                                                 uint64_t acc = 0;
+                                                 for (size_t i = 0; i < n; ++i)
+                                                     acc += fn(s.rows[i], s.cols[i], cfg.size, ptt, cam_q,
+                                                               cfg.attitude, q_new, false)
+                                                                .first.value();
+                                                 g_sink = g_sink + acc;
+                                             }) *
+                              static_cast<double>(n);
+        }
+
+        if (opt.verbose)
+        {
+            fmt::print("config {}x{} fov={} install={} done\n", cfg.size.width, cfg.size.height, cfg.fov_deg,
+                       cfg.install_deg);
+        }
+    }
+
+    fmt::print("{} configurations x {} points (reference: long double, {} mantissa bits)\n", sweep.size(),
+               opt.points, std::numeric_limits<Real>::digits);
+    fmt::print("{:<24} {:>10} {:>12} {:>12} {:>12} {:>12} {:>10} {:>9}\n", "kernel", "points", "p50 px", "p99 px",
+               "p99.9 px", "max px", "mismatch", "ns/pt");
+
+    bool ok = true;
+    const auto report = [&](const auto &variants, std::vector<Stats> &stats)
+    {
+        for (size_t v = 0; v < variants.size(); ++v)
+        {
+            print_row(variants[v].name, stats[v]);
+            ok = ok && stats[v].worst <= opt.max_px;
+        }
+    };
+    report(PIXEL_TO_NED_VARIANTS, p2n);
+    report(NED_TO_PIXEL_VARIANTS, n2p);
+    report(AFTER_ROTATION_VARIANTS, rot);
+
+    if (!ok)
+    {
+        fmt::print("FAIL: max error exceeds {} px\n", opt.max_px);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+// Micro-benchmarks for the C++ kernels in math.hpp and body_space.hpp.
+//
+// Every function is measured in two forms:
+//   <name>/scalar/<WxH>  one call per iteration, inputs cycled from a pre-generated pool
+//   <name>/batch/<WxH>   a loop over the whole pool writing to an output array, as the
+//                        Python *_batch bindings do
+// Pixel-space kernels run for every sensor size; size-independent kernels (tangents, NED,
+// quaternions) run once. Each result carries ns_per_point and items_per_second (points/s).
+// With --perf, hardware counters add cycles, instructions, IPC, cache and branch misses per point
+// and bytes_per_point (cache-miss traffic); without counter access the flag only prints a note.
+//
+// JSON for regression tracking:
+//   kernel_bench --benchmark_out=kernels.json --benchmark_out_format=json [--perf]
+// Compare two runs with Google Benchmark's tools/compare.py.
+
+#include "image-to-body-math/body_space.hpp"
+#include "perf_counters.hpp"
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace p2b;
+
+namespace
+{
+
+// ---- Inputs ----
+
+constexpr size_t POOL = 4096; // power of two; small enough to stay cache-resident
+
+constexpr std::array SENSOR_SIZES{ImageSize{320, 256},   ImageSize{640, 512},   ImageSize{1280, 720},
+                                  ImageSize{1920, 1080}, ImageSize{3840, 2160}, ImageSize{7680, 4320}};
+
+/// Everything a kernel needs, generated once per sensor size from a fixed seed.
+struct Fixture
+{
+    ImageSize size;
+    Radians fov;
+    PixelToTan ptt;
+    Quaternion cam_q;
+    Quaternion att;
+    Quaternion att_new;
+    std::vector<PixelIndex> rows, cols;
+    std::vector<PixelTan> w_pixel_tans;
+    std::vector<double> w_tans, h_tans;
+    std::vector<Radians> azimuths, elevations;
+    std::vector<Vector3> neds, bodies;
+
+    explicit Fixture(const ImageSize &image_size)
+        : size{image_size}, fov{Degrees{60.0}.to_radians()}, ptt{pixel_to_tan_from_fov(image_size, fov)},
+          cam_q{cam_to_body_from_angle(Degrees{15.0}.to_radians())},
+          att{0.9848, 0.0, 0.0, 0.1736},       // ~20 deg yaw
+          att_new{0.9845, 0.0087, 0.0, 0.1752} // small inter-frame rotation
+    {
+        std::mt19937_64 rng(0xbe7c4);
+        std::uniform_int_distribution<uint64_t> row_dist(0, size.width - 1);
+        std::uniform_int_distribution<uint64_t> col_dist(0, size.height - 1);
+        std::uniform_real_distribution<double> tan_dist(-0.5, 0.5);
+        std::uniform_real_distribution<double> az_dist(-linalg3d::PI, linalg3d::PI);
+        std::uniform_real_distribution<double> el_dist(-1.2, 1.2);
+        for (size_t i = 0; i < POOL; ++i)
+        {
+            rows.emplace_back(row_dist(rng));
+            cols.emplace_back(col_dist(rng));
+            w_pixel_tans.push_back(pixel_tan_by_pixel_to_tan(rows.back(), size, ptt));
+            w_tans.push_back(tan_dist(rng));
+            h_tans.push_back(tan_dist(rng));
+            azimuths.emplace_back(az_dist(rng));
+            elevations.emplace_back(el_dist(rng));
+            neds.push_back(pixel_to_ned(rows.back(), cols.back(), size, ptt, cam_q, att));
+            bodies.push_back(warp_image_to_body(w_tans.back(), h_tans.back(), cam_q));
+        }
+    }
+};
+
+// ---- Runners ----
+
+std::unique_ptr<bench::PerfCounters> g_perf; // set by --perf when counters are available
+
+void report_points(benchmark::State &state,
+                   size_t points_per_iteration,
+                   std::chrono::nanoseconds elapsed,
+                   const bench::PerfSample &perf)
+{
+    const double total = static_cast<double>(points_per_iteration) * static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points_per_iteration));
+    // Plain average: a rate counter would be printed with a seconds suffix
+    state.counters["ns_per_point"] = static_cast<double>(elapsed.count()) / total;
+    if (perf.valid)
+    {
+        state.counters["cycles_per_point"] = static_cast<double>(perf.cycles) / total;
+        state.counters["instructions_per_point"] = static_cast<double>(perf.instructions) / total;
+        state.counters["IPC"] = perf.ipc();
+        state.counters["cache_misses_per_point"] = static_cast<double>(perf.cache_misses) / total;
+        state.counters["branch_misses_per_point"] = static_cast<double>(perf.branch_misses) / total;
+        state.counters["bytes_per_point"] = perf.miss_bytes() / total;
+        if (perf.multiplexed)
+        {
+            state.counters["multiplexed"] = 1.0; // counter values are scaled estimates
+        }
+    }
+}
+
+// Wall time and (with --perf) counters around a benchmark loop
+class Measurement
+{
+public:
+    Measurement() noexcept : begin_{std::chrono::steady_clock::now()}
+    {
+        if (g_perf)
+        {
+            g_perf->start();
+        }
+    }
+
+    void report(benchmark::State &state, size_t points_per_iteration) const
+    {
+        const bench::PerfSample perf = g_perf ? g_perf->stop() : bench::PerfSample{};
+        report_points(state, points_per_iteration, std::chrono::steady_clock::now() - begin_, perf);
+    }
+
+private:
+    std::chrono::steady_clock::time_point begin_;
+};
+
+template <typename Kernel>
+void run_scalar(benchmark::State &state, const Fixture &f, Kernel kernel)
+{
+    size_t i = 0;
+    const Measurement measurement;
+    for (auto _ : state)
+    {
+        auto result = kernel(f, i);
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) & (POOL - 1);
+    }
+    measurement.report(state, 1);
+}
+
+template <typename Kernel>
+void run_batch(benchmark::State &state, const Fixture &f, Kernel kernel)
+{
+    using Result = decltype(kernel(f, size_t{0}));
+    std::vector<Result> out;
+    out.reserve(POOL);
+    for (size_t i = 0; i < POOL; ++i)
+    {
+        out.push_back(kernel(f, i));
+    }
+    const Measurement measurement;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < POOL; ++i)
+        {
+            out[i] = kernel(f, i);
+        }
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+    measurement.report(state, POOL);
+}
+
+std::vector<Fixture> &fixtures()
+{
+    static std::vector<Fixture> all = []
+    {
+        std::vector<Fixture> v;
+        for (const auto &size : SENSOR_SIZES)
+        {
+            v.emplace_back(size);
+        }
+        return v;
+    }();
+    return all;
+}
+
+std::string size_label(const ImageSize &size)
+{
+    return std::to_string(size.width) + "x" + std::to_string(size.height);
+}
+
+/// Register scalar and batch forms; per sensor size when the kernel depends on it.
+template <typename Kernel>
+void add(const std::string &name, bool per_size, Kernel kernel)
+{
+    const size_t sizes = per_size ? fixtures().size() : 1;
+    for (size_t s = 0; s < sizes; ++s)
+    {
+        const Fixture *f = &fixtures()[s];
+        const std::string label = per_size ? "/" + size_label(f->size) : "";
+        benchmark::RegisterBenchmark((name + "/scalar" + label).c_str(),
+                                     [f, kernel](benchmark::State &state) { run_scalar(state, *f, kernel); });
+        benchmark::RegisterBenchmark((name + "/batch" + label).c_str(),
+                                     [f, kernel](benchmark::State &state) { run_batch(state, *f, kernel); });
+    }
+}
+
+// ---- Kernels ----
+
+void register_math()
+{
+    add("pixel_tan_from_fov", true,
+        [](const Fixture &f, size_t i) { return pixel_tan_from_fov(f.rows[i], f.size, f.fov); });
+    add("tan_to_pixel_by_fov", true,
+        [](const Fixture &f, size_t i) { return tan_to_pixel_by_fov(PixelTan{f.w_tans[i]}, f.size, f.fov); });
+    add("pixel_tan_by_pixel_to_tan", true,
+        [](const Fixture &f, size_t i) { return pixel_tan_by_pixel_to_tan(f.rows[i], f.size, f.ptt); });
+    add("angle_tan_to_pixel", true,
+        [](const Fixture &f, size_t i) { return angle_tan_to_pixel(f.w_pixel_tans[i], f.size, f.ptt); });
+    add("pixel_tan_by_pixel_to_tan_clipped", true,
+        [](const Fixture &f, size_t i)
+        { return pixel_tan_by_pixel_to_tan_clipped(f.rows[i], f.size, f.ptt, ClipThreshold{0.05}); });
+    add("tan_to_pixel_by_pixel_to_tan", true,
+        [](const Fixture &f, size_t i)
+        { return tan_to_pixel_by_pixel_to_tan(f.w_pixel_tans[i], f.size, f.ptt, false); });
+}
+
+void register_body_space()
+{
+    add("cam_to_body_from_angle", false,
+        [](const Fixture &f, size_t i) { return cam_to_body_from_angle(f.elevations[i]); });
+    add("tangents_to_ned", false, [](const Fixture &f, size_t i) { return tangents_to_ned(f.w_tans[i], f.h_tans[i]); });
+    add("ned_to_tangents", false, [](const Fixture &f, size_t i) { return ned_to_tangents(f.neds[i]); });
+    add("ned_to_azimuth_elevation", false,
+        [](const Fixture &f, size_t i) { return ned_to_azimuth_elevation(f.neds[i]); });
+    add("azimuth_elevation_to_ned", false,
+        [](const Fixture &f, size_t i) { return azimuth_elevation_to_ned(f.azimuths[i], f.elevations[i]); });
+    add("warp_image_to_body", false,
+        [](const Fixture &f, size_t i) { return warp_image_to_body(f.w_tans[i], f.h_tans[i], f.cam_q); });
+    add("warp_body_to_image", false,
+        [](const Fixture &f, size_t i) { return warp_body_to_image(f.bodies[i], f.cam_q); });
+    add("ned_at_elevation", false,
+        [](const Fixture &f, size_t i) { return ned_at_elevation(f.neds[i], f.elevations[i]); });
+    add("ned_angle_in_pixels", false,
+        [](const Fixture &f, size_t i) { return ned_angle_in_pixels(f.neds[i], f.neds[(i + 1) & (POOL - 1)], f.ptt); });
+
+    add("pixel_to_tan_from_fov", true, [](const Fixture &f, size_t i)
+        { return pixel_to_tan_from_fov(f.size, Radians{f.fov.value() + 1e-6 * static_cast<double>(i)}); });
+    add("pixel_to_ned", true,
+        [](const Fixture &f, size_t i) { return pixel_to_ned(f.rows[i], f.cols[i], f.size, f.ptt, f.cam_q, f.att); });
+    add("ned_to_pixel", true,
+        [](const Fixture &f, size_t i) { return ned_to_pixel(f.neds[i], f.size, f.ptt, f.cam_q, f.att); });
+    add("pixel_after_rotation", true,
+        [](const Fixture &f, size_t i)
+        { return pixel_after_rotation(f.rows[i], f.cols[i], f.size, f.ptt, f.cam_q, f.att, f.att_new, false); });
+    add("is_pixel_inside_frame", true,
+        [](const Fixture &f, size_t i) { return is_pixel_inside_frame(f.rows[i], f.cols[i], f.size, 0.05); });
+    add("is_ned_inside_frame", true,
+        [](const Fixture &f, size_t i)
+        { return is_ned_inside_frame(f.neds[i], f.size, f.ptt, f.cam_q, f.att_new, 0.05); });
+    add("pixel_at_elevation", true,
+        [](const Fixture &f, size_t i)
+        { return pixel_at_elevation(f.rows[i], f.cols[i], f.size, f.ptt, f.cam_q, f.att, Radians{0.0}); });
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    // Strip our own flag before Google Benchmark sees the arguments
+    int kept = 1;
+    bool want_perf = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view{argv[i]} == "--perf")
+            want_perf = true;
+        else
+            argv[kept++] = argv[i];
+    }
+    argc = kept;
+    if (want_perf)
+    {
+        g_perf = std::make_unique<bench::PerfCounters>();
+        if (!g_perf->available())
+        {
+            fmt::print(stderr, "--perf: {}; reporting timing only\n", g_perf->reason());
+            g_perf.reset();
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::AddCustomContext("pool_points", std::to_string(POOL));
+    benchmark::AddCustomContext("perf_counters", g_perf ? "on" : "off");
+    register_math();
+    register_body_space();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,179 @@
+#pragma once
+// Hardware performance counters for the benchmark executables (Linux perf_event_open).
+//
+// Opens one counter group — cycles, instructions, cache misses, branch misses — for the calling
+// thread, user space only. When the syscall is missing or denied (non-Linux, containers,
+// perf_event_paranoid > 2) the group reports available() == false with a reason, and start/stop
+// return invalid samples, so benchmarks keep running with timing only. When the PMU is shared and
+// the group only ran for part of the region, values are scaled up by enabled / running time and
+// the sample is flagged as multiplexed; a group that never ran gives an invalid sample.
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench
+{
+
+/// Counter deltas over one measured region.
+struct PerfSample
+{
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+    uint64_t branch_misses = 0;
+    bool valid = false;
+    bool multiplexed = false; ///< Values extrapolated from a partial running time
+
+    [[nodiscard]] double ipc() const noexcept
+    {
+        return cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+
+    /// Memory traffic implied by last-level cache misses (one line each).
+    [[nodiscard]] double miss_bytes() const noexcept
+    {
+        return static_cast<double>(cache_misses) * 64.0;
+    }
+
+    PerfSample &operator+=(const PerfSample &o) noexcept
+    {
+        cycles += o.cycles;
+        instructions += o.instructions;
+        cache_misses += o.cache_misses;
+        branch_misses += o.branch_misses;
+        valid = valid || o.valid;
+        multiplexed = multiplexed || o.multiplexed;
+        return *this;
+    }
+};
+
+class PerfCounters
+{
+public:
+    PerfCounters()
+    {
+#if defined(__linux__)
+        constexpr std::array<uint64_t, COUNT> configs{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = i == 0 ? 1 : 0; // the leader gates the whole group
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format =
+                PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0);
+            if (fd < 0)
+            {
+                reason_ = std::string("perf_event_open: ") + std::strerror(errno);
+                close_all();
+                return;
+            }
+            fds_[i] = static_cast<int>(fd);
+        }
+        available_ = true;
+#else
+        reason_ = "hardware counters need Linux perf_event_open";
+#endif
+    }
+
+    ~PerfCounters()
+    {
+        close_all();
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    [[nodiscard]] bool available() const noexcept
+    {
+        return available_;
+    }
+
+    /// Why counters are unavailable (empty when available).
+    [[nodiscard]] const std::string &reason() const noexcept
+    {
+        return reason_;
+    }
+
+    void start() noexcept
+    {
+#if defined(__linux__)
+        if (available_)
+        {
+            ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    [[nodiscard]] PerfSample stop() noexcept
+    {
+        PerfSample s;
+#if defined(__linux__)
+        if (!available_)
+        {
+            return s;
+        }
+        ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // Read layout: nr, time_enabled, time_running, then one value per event in creation order
+        std::array<uint64_t, COUNT + 3> buf{};
+        if (read(fds_[0], buf.data(), sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) || buf[0] != COUNT)
+        {
+            return s;
+        }
+        const uint64_t enabled = buf[1];
+        const uint64_t running = buf[2];
+        if (running == 0)
+        {
+            return s; // never scheduled on the PMU
+        }
+        s.multiplexed = running < enabled;
+        const double scale = s.multiplexed ? static_cast<double>(enabled) / static_cast<double>(running) : 1.0;
+        const auto value = [&](size_t i) { return static_cast<uint64_t>(static_cast<double>(buf[3 + i]) * scale); };
+        s.cycles = value(0);
+        s.instructions = value(1);
+        s.cache_misses = value(2);
+        s.branch_misses = value(3);
+        s.valid = true;
+#endif
+        return s;
+    }
+
+private:
+    static constexpr size_t COUNT = 4;
+
+    void close_all() noexcept
+    {
+#if defined(__linux__)
+        for (int &fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+    std::array<int, COUNT> fds_{-1, -1, -1, -1};
+    bool available_ = false;
+    std::string reason_;
+};
+
+} // namespace bench
@@ -0,0 +1,349 @@
+// End-to-end streaming scenario: per-frame latency of the full projection pipeline.
+//
+// Replays a seeded synthetic attitude trajectory (slow yaw sweep with roll/pitch oscillation and
+// vibration noise) and a detection stream (targets drifting in NED) frame by frame through
+//   1. stabilization map   pixel_after_rotation on a grid over the frame (previous -> current attitude)
+//   2. visibility          is_ned_inside_frame for every target
+//   3. projection          ned_to_pixel for the visible targets
+//   4. horizon overlay     horizon_line across all rows
+// and reports per-frame latency p50/p99/p99.9/max, jitter and deadline misses against 1/fps.
+// All inputs derive from --seed, so numbers are comparable between machines and releases.
+// --perf adds a per-stage breakdown (ns/point, IPC, bytes/point from cache misses, branch misses)
+// from hardware counters; the extra syscalls per stage slightly inflate frame latency.
+//
+// Usage: scenario_bench [--frames N] [--width W] [--height H] [--fps F] [--targets N]
+//                       [--grid-step PX] [--seed S] [--quick] [--perf]
+
+#include "image-to-body-math/elevation_contour.hpp"
+#include "perf_counters.hpp"
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace p2b;
+
+namespace
+{
+
+struct Options
+{
+    size_t frames = 3600; // one minute at 60 fps
+    ImageSize size{3840, 2160};
+    double fps = 60.0;
+    size_t targets = 20000;
+    uint64_t grid_step = 16;
+    uint64_t seed = 0x5ce7a510;
+    size_t warmup = 30;
+    bool perf = false;
+};
+
+// ---- Synthetic inputs ----
+
+Quaternion axis_angle(double x, double y, double z, double angle)
+{
+    const double s = std::sin(angle / 2.0);
+    return Quaternion{std::cos(angle / 2.0), x * s, y * s, z * s};
+}
+
+/// Attitude at time t: yaw sweep, roll/pitch oscillation and seeded vibration (yaw * pitch * roll).
+struct Trajectory
+{
+    std::vector<double> vibration; // per-frame noise, radians
+
+    Trajectory(size_t frames, std::mt19937_64 &rng)
+    {
+        std::normal_distribution<double> noise(0.0, 0.002);
+        vibration.resize(frames * 3);
+        std::generate(vibration.begin(), vibration.end(), [&] { return noise(rng); });
+    }
+
+    [[nodiscard]] Quaternion at(size_t frame, double t) const
+    {
+        const double yaw = 0.3 * t + vibration[frame * 3];
+        const double pitch = 0.05 * std::sin(2.0 * t) + vibration[frame * 3 + 1];
+        const double roll = 0.1 * std::sin(1.3 * t) + vibration[frame * 3 + 2];
+        return axis_angle(0, 0, 1, yaw) * axis_angle(0, 1, 0, pitch) * axis_angle(1, 0, 0, roll);
+    }
+};
+
+/// Targets scattered around the horizon, drifting a little every frame.
+struct DetectionStream
+{
+    std::vector<double> azimuth, elevation, d_azimuth;
+
+    DetectionStream(size_t n, std::mt19937_64 &rng)
+    {
+        std::uniform_real_distribution<double> az(-linalg3d::PI, linalg3d::PI);
+        std::uniform_real_distribution<double> el(-0.5, 0.15);
+        std::uniform_real_distribution<double> drift(-1e-3, 1e-3);
+        for (size_t i = 0; i < n; ++i)
+        {
+            azimuth.push_back(az(rng));
+            elevation.push_back(el(rng));
+            d_azimuth.push_back(drift(rng));
+        }
+    }
+
+    void advance(std::vector<Vector3> &neds)
+    {
+        for (size_t i = 0; i < azimuth.size(); ++i)
+        {
+            azimuth[i] += d_azimuth[i];
+            neds[i] = azimuth_elevation_to_ned(Radians{azimuth[i]}, Radians{elevation[i]});
+        }
+    }
+};
+
+// ---- Pipeline ----
+
+struct Frame
+{
+    std::vector<PixelIndex> grid_rows, grid_cols;
+    std::vector<std::pair<PixelIndex, PixelIndex>> stabilization;
+    std::vector<Vector3> neds;
+    std::vector<std::pair<PixelIndex, PixelIndex>> overlay;
+    std::vector<double> horizon;
+    size_t visible = 0;
+};
+
+/// Per-stage totals over the measured frames (filled only with --perf).
+struct StageProfile
+{
+    struct Stage
+    {
+        const char *name;
+        double seconds = 0.0;
+        size_t points = 0;
+        bench::PerfSample perf;
+    };
+
+    bench::PerfCounters counters;
+    std::array<Stage, 3> stages{Stage{"stabilization map", 0.0, 0, {}}, Stage{"visibility+projection", 0.0, 0, {}},
+                                Stage{"horizon line", 0.0, 0, {}}};
+
+    template <typename Body>
+    void measure(size_t stage, size_t points, Body &&body)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        counters.start();
+        body();
+        stages[stage].perf += counters.stop();
+        stages[stage].seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        stages[stage].points += points;
+    }
+};
+
+void run_frame(Frame &f,
+               const Options &opt,
+               PixelToTan ptt,
+               const Quaternion &cam_q,
+               const Quaternion &q_prev,
+               const Quaternion &q_cur,
+               StageProfile *profile)
+{
+    const auto stabilize = [&]
+    {
+        for (size_t i = 0; i < f.grid_rows.size(); ++i)
+        {
+            f.stabilization[i] =
+                pixel_after_rotation(f.grid_rows[i], f.grid_cols[i], opt.size, ptt, cam_q, q_prev, q_cur);
+        }
+    };
+    const auto project = [&]
+    {
+        f.visible = 0;
+        for (const auto &ned : f.neds)
+        {
+            if (is_ned_inside_frame(ned, opt.size, ptt, cam_q, q_cur, 0.0))
+            {
+                f.overlay[f.visible++] = ned_to_pixel(ned, opt.size, ptt, cam_q, q_cur);
+            }
+        }
+    };
+    const auto horizon = [&] { horizon_line(f.horizon, opt.size, ptt, cam_q, q_cur); };
+
+    if (profile == nullptr)
+    {
+        stabilize();
+        project();
+        horizon();
+        return;
+    }
+    profile->measure(0, f.grid_rows.size(), stabilize);
+    profile->measure(1, f.neds.size(), project);
+    profile->measure(2, f.horizon.size(), horizon);
+}
+
+// ---- Reporting ----
+
+double percentile(std::vector<double> v, double p)
+{
+    const auto k = static_cast<size_t>(p * static_cast<double>(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+Options parse(int argc, char **argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view a = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (a == "--quick")
+        {
+            opt.frames = 120;
+            opt.warmup = 10;
+        }
+        else if (a == "--frames" && has_value)
+            opt.frames = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--width" && has_value)
+            opt.size.width = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--height" && has_value)
+            opt.size.height = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--fps" && has_value)
+            opt.fps = std::strtod(argv[++i], nullptr);
+        else if (a == "--targets" && has_value)
+            opt.targets = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--grid-step" && has_value)
+            opt.grid_step = std::max<uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        else if (a == "--seed" && has_value)
+            opt.seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (a == "--perf")
+            opt.perf = true;
+        else
+        {
+            fmt::print(stderr,
+                       "usage: {} [--frames N] [--width W] [--height H] [--fps F] [--targets N] "
+                       "[--grid-step PX] [--seed S] [--quick] [--perf]\n",
+                       argv[0]);
+            std::exit(2);
+        }
+    }
+    opt.frames = std::max<size_t>(opt.frames, 1);
+    opt.warmup = std::min(opt.warmup, opt.frames / 2);
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const Options opt = parse(argc, argv);
+    std::mt19937_64 rng(opt.seed);
+    const Trajectory trajectory(opt.frames, rng);
+    DetectionStream detections(opt.targets, rng);
+
+    const PixelToTan ptt = pixel_to_tan_from_fov(opt.size, Degrees{60.0}.to_radians());
+    const Quaternion cam_q = cam_to_body_from_angle(Degrees{10.0}.to_radians());
+
+    Frame frame;
+    for (uint64_t col = 0; col < opt.size.height; col += opt.grid_step)
+    {
+        for (uint64_t row = 0; row < opt.size.width; row += opt.grid_step)
+        {
+            frame.grid_rows.emplace_back(row);
+            frame.grid_cols.emplace_back(col);
+        }
+    }
+    frame.stabilization.assign(frame.grid_rows.size(), {PixelIndex{0}, PixelIndex{0}});
+    frame.neds.resize(opt.targets);
+    frame.overlay.assign(opt.targets, {PixelIndex{0}, PixelIndex{0}});
+    frame.horizon.resize(opt.size.width);
+
+    std::unique_ptr<StageProfile> profile;
+    std::unique_ptr<StageProfile> warmup_profile; // warm-up frames are profiled too, then discarded
+    if (opt.perf)
+    {
+        profile = std::make_unique<StageProfile>();
+        warmup_profile = std::make_unique<StageProfile>();
+        if (!profile->counters.available())
+        {
+            fmt::print(stderr, "--perf: {}; stage breakdown shows timing only\n", profile->counters.reason());
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+    std::vector<double> latency_us;
+    latency_us.reserve(opt.frames);
+    size_t visible_total = 0;
+    Quaternion q_prev = trajectory.at(0, 0.0);
+    for (size_t k = 1; k <= opt.frames; ++k)
+    {
+        const double t = static_cast<double>(k) / opt.fps;
+        const Quaternion q_cur = trajectory.at(k - 1, t);
+        detections.advance(frame.neds); // input generation is not timed
+
+        const auto t0 = clock::now();
+        run_frame(frame, opt, ptt, cam_q, q_prev, q_cur,
+                  k > opt.warmup ? profile.get() : warmup_profile.get());
+        const auto t1 = clock::now();
+
+        if (k > opt.warmup)
+        {
+            latency_us.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            visible_total += frame.visible;
+        }
+        q_prev = q_cur;
+    }
+
+    const double budget_us = 1e6 / opt.fps;
+    const auto n = static_cast<double>(latency_us.size());
+    double mean = 0.0;
+    for (const double v : latency_us)
+        mean += v / n;
+    double var = 0.0;
+    for (const double v : latency_us)
+        var += (v - mean) * (v - mean) / n;
+    const auto misses = std::count_if(latency_us.begin(), latency_us.end(), [&](double v) { return v > budget_us; });
+    const double p50 = percentile(latency_us, 0.50);
+    const double p99 = percentile(latency_us, 0.99);
+    const double p999 = percentile(latency_us, 0.999);
+    const double max = *std::max_element(latency_us.begin(), latency_us.end());
+
+    fmt::print("scenario: {}x{} @ {} fps, {} targets, stabilization grid {} px ({} points), seed {:#x}\n",
+               opt.size.width, opt.size.height, opt.fps, opt.targets, opt.grid_step, frame.grid_rows.size(), opt.seed);
+    fmt::print("frames: {} measured ({} warm-up), mean visible targets {:.0f}\n", latency_us.size(), opt.warmup,
+               static_cast<double>(visible_total) / n);
+    fmt::print("latency us: p50 {:.1f}  p99 {:.1f}  p99.9 {:.1f}  max {:.1f}  mean {:.1f}\n", p50, p99, p999, max,
+               mean);
+    fmt::print("jitter us: stddev {:.1f}  p99-p50 {:.1f}\n", std::sqrt(var), p99 - p50);
+    fmt::print("deadline {:.1f} us: {} misses ({:.3f}%), headroom at p99.9 {:.1f}%\n", budget_us, misses,
+               100.0 * static_cast<double>(misses) / n, 100.0 * (1.0 - p999 / budget_us));
+
+    if (profile)
+    {
+        fmt::print("\n{:<24} {:>10} {:>8} {:>8} {:>12} {:>14}\n", "stage", "ns/point", "IPC", "cyc/pt", "bytes/point",
+                   "br-miss/point");
+        for (const auto &stage : profile->stages)
+        {
+            const double pts = static_cast<double>(std::max<size_t>(stage.points, 1));
+            if (stage.perf.valid)
+            {
+                fmt::print("{:<24} {:>10.2f} {:>8.2f} {:>8.1f} {:>12.2f} {:>14.4f}\n", stage.name,
+                           stage.seconds * 1e9 / pts, stage.perf.ipc(), static_cast<double>(stage.perf.cycles) / pts,
+                           stage.perf.miss_bytes() / pts, static_cast<double>(stage.perf.branch_misses) / pts);
+            }
+            else
+            {
+                fmt::print("{:<24} {:>10.2f} {:>8} {:>8} {:>12} {:>14}\n", stage.name, stage.seconds * 1e9 / pts, "-",
+                           "-", "-", "-");
+            }
+        }
+        if (std::any_of(profile->stages.begin(), profile->stages.end(),
+                        [](const auto &stage) { return stage.perf.multiplexed; }))
+        {
+            fmt::print("counters were multiplexed with other PMU users; values are scaled estimates\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+#pragma once
+#include "interpolation.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace p2b
+{
+
+// ---- Timestamped attitude history ----
+//
+// Fixed-capacity ring of (timestamp, attitude) samples; pushing into a full buffer drops the
+// oldest. Lookups interpolate between the two samples bracketing the query time. The segment of
+// the previous lookup is remembered, so queries that move forward in time (frames, event streams)
+// cost O(1); a jump falls back to a binary search. That cursor makes lookups mutate internal
+// state: one buffer must not be queried from several threads at once.
+
+/// One attitude sample. Timestamps are in any unit, strictly increasing within a buffer.
+struct TimedAttitude
+{
+    double timestamp{};
+    Quaternion attitude{};
+};
+
+class AttitudeBuffer
+{
+public:
+    explicit AttitudeBuffer(std::size_t capacity) : samples_(std::max<std::size_t>(capacity, 2))
+    {
+    }
+
+    /// Append a sample. Returns false (and ignores it) unless timestamp is newer than the newest.
+    bool push(double timestamp, const Quaternion &attitude) noexcept
+    {
+        if (size_ > 0 && !(timestamp > newest().timestamp))
+        {
+            return false;
+        }
+        if (size_ < samples_.size())
+        {
+            samples_[slot(size_)] = TimedAttitude{timestamp, attitude};
+            ++size_;
+        }
+        else
+        {
+            samples_[head_] = TimedAttitude{timestamp, attitude};
+            head_ = (head_ + 1) % samples_.size();
+            cursor_ = cursor_ > 0 ? cursor_ - 1 : 0;
+        }
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        head_ = 0;
+        size_ = 0;
+        cursor_ = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return samples_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /// i-th sample from the oldest (i < size()).
+    [[nodiscard]] const TimedAttitude &operator[](std::size_t i) const noexcept
+    {
+        return samples_[slot(i)];
+    }
+
+    [[nodiscard]] const TimedAttitude &oldest() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] const TimedAttitude &newest() const noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+    /// True when timestamp lies within [oldest, newest].
+    [[nodiscard]] bool covers(double timestamp) const noexcept
+    {
+        return size_ > 0 && timestamp >= oldest().timestamp && timestamp <= newest().timestamp;
+    }
+
+    /// Attitude at timestamp, interpolated between the bracketing samples; std::nullopt outside
+    /// [oldest, newest] (no extrapolation).
+    [[nodiscard]] std::optional<Quaternion> at(double timestamp,
+                                               Interpolation method = Interpolation::SLERP) const noexcept
+    {
+        if (!covers(timestamp))
+        {
+            return std::nullopt;
+        }
+        if (size_ == 1)
+        {
+            return oldest().attitude;
+        }
+        const std::size_t k = segment(timestamp);
+        const TimedAttitude &a = (*this)[k];
+        const TimedAttitude &b = (*this)[k + 1];
+        return interpolate(a.attitude, b.attitude, (timestamp - a.timestamp) / (b.timestamp - a.timestamp), method);
+    }
+
+    /// Batch lookup: out[i] = at(timestamps[i]). Sorted timestamps cost O(1) each. Entries
+    /// outside [oldest, newest] are left unchanged; returns how many timestamps were covered.
+    std::size_t at(std::span<const double> timestamps,
+                   std::span<Quaternion> out,
+                   Interpolation method = Interpolation::SLERP) const noexcept
+    {
+        std::size_t covered = 0;
+        const std::size_t n = std::min(timestamps.size(), out.size());
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (const auto q = at(timestamps[i], method))
+            {
+                out[i] = *q;
+                ++covered;
+            }
+        }
+        return covered;
+    }
+
+private:
+    [[nodiscard]] std::size_t slot(std::size_t i) const noexcept
+    {
+        return (head_ + i) % samples_.size();
+    }
+
+    // Index k of the segment [k, k + 1] holding timestamp (size_ >= 2, timestamp covered):
+    // the remembered segment or its successor when possible, otherwise a binary search.
+    [[nodiscard]] std::size_t segment(double timestamp) const noexcept
+    {
+        const std::size_t last = size_ - 2;
+        for (std::size_t k = std::min(cursor_, last); k <= std::min(cursor_ + 1, last); ++k)
+        {
+            if ((*this)[k].timestamp <= timestamp && timestamp <= (*this)[k + 1].timestamp)
+            {
+                cursor_ = k;
+                return k;
+            }
+        }
+        std::size_t lo = 0;
+        std::size_t hi = last;
+        while (lo < hi)
+        {
+            const std::size_t mid = lo + (hi - lo + 1) / 2;
+            if ((*this)[mid].timestamp <= timestamp)
+            {
+                lo = mid;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        cursor_ = lo;
+        return lo;
+    }
+
+    std::vector<TimedAttitude> samples_;
+    std::size_t head_{};
+    std::size_t size_{};
+    mutable std::size_t cursor_{};
+};
+
+} // namespace p2b
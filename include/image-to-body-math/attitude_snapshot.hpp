@@ -0,0 +1,104 @@
+#pragma once
+#include "body_space.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace p2b
+{
+
+// ---- Lock-free snapshot publication ----
+//
+// A sequence lock: one writer thread (e.g. the IMU loop) publishes a value, any number of reader
+// threads copy it out without locking. The writer never waits; a reader retries only when it
+// overlapped a write, and always returns a value exactly as published (no torn reads). The value
+// is stored as relaxed atomic words, so the protocol is free of data races under the C++ memory
+// model. Stores from more than one thread at a time must be serialized by the caller.
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class SeqLock
+{
+public:
+    explicit SeqLock(const T &initial) noexcept
+    {
+        store(initial);
+    }
+
+    /// Publish a new value (single writer).
+    void store(const T &value) noexcept
+    {
+        std::array<uint64_t, WORDS> buf{};
+        std::memcpy(buf.data(), &value, sizeof(T));
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i)
+        {
+            words_[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /// Consistent copy of the latest published value.
+    [[nodiscard]] T load() const noexcept
+    {
+        std::array<uint64_t, WORDS> buf{};
+        while (!try_read(buf))
+        {
+        }
+        return from_words(buf);
+    }
+
+    /// Number of stores so far; readers can compare it to skip work when nothing changed.
+    [[nodiscard]] uint64_t version() const noexcept
+    {
+        return seq_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    [[nodiscard]] bool try_read(std::array<uint64_t, WORDS> &buf) const noexcept
+    {
+        const uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1U)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < WORDS; ++i)
+        {
+            buf[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == before;
+    }
+
+    [[nodiscard]] static T from_words(const std::array<uint64_t, WORDS> &buf) noexcept
+    {
+        std::array<std::byte, sizeof(T)> bytes{};
+        std::memcpy(bytes.data(), buf.data(), sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+
+    std::atomic<uint64_t> seq_{0};
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+};
+
+/// What a vision thread needs to project against the latest IMU state.
+struct AttitudeSnapshot
+{
+    Quaternion cam_to_body{};
+    Quaternion attitude{};
+    double timestamp{};
+};
+
+/// Latest (cam_to_body, attitude, timestamp), published by the IMU thread and read lock-free.
+/// SeqLock<Camera> works the same way when readers should get the composed rotations too.
+using AttitudePublisher = SeqLock<AttitudeSnapshot>;
+
+} // namespace p2b
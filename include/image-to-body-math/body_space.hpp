@@ -219,7 +219,29 @@ using Quaternion = linalg3d::Quaternion;
     return is_pixel_inside_frame(row, col, image_size, boundary);
 }
 
+/// Re-target a NED direction to a new elevation, keeping its azimuth.
+/// Rescales the horizontal (north, east) component to cos(elevation) and sets down = -sin(elevation),
+/// so no inverse trigonometry is needed. cos_el/sin_el are the cosine and sine of the target elevation.
+/// A vertical input has no defined azimuth and is mapped to north (azimuth 0).
+[[nodiscard]] inline Vector3 ned_at_elevation(const Vector3 &ned, double cos_el, double sin_el) noexcept
+{
+    const double horizontal = std::sqrt(ned.x * ned.x + ned.y * ned.y);
+    if (horizontal == 0.0)
+    {
+        return Vector3{cos_el, 0.0, -sin_el};
+    }
+    const double scale = cos_el / horizontal;
+    return Vector3{ned.x * scale, ned.y * scale, -sin_el};
+}
+
+/// Re-target a NED direction to a new elevation angle, keeping its azimuth.
+[[nodiscard]] inline Vector3 ned_at_elevation(const Vector3 &ned, Radians elevation) noexcept
+{
+    return ned_at_elevation(ned, std::cos(elevation.value()), std::sin(elevation.value()));
+}
+
 /// Project a pixel to a target elevation angle, keeping the same azimuth.
+/// Closed form: pixel → NED, rescale the horizontal component, NED → pixel.
 /// Returns the pixel coordinates at the desired elevation.
 [[nodiscard]] inline std::pair<PixelIndex, PixelIndex> pixel_at_elevation(PixelIndex row,
                                                                           PixelIndex col,
@@ -230,9 +252,7 @@ using Quaternion = linalg3d::Quaternion;
                                                                           Radians desired_elevation) noexcept
 {
     const auto ned = pixel_to_ned(row, col, image_size, pixel_to_tan, cam_to_body, attitude);
-    auto [azimuth, elevation] = ned_to_azimuth_elevation(ned);
-    (void)elevation;
-    const auto new_ned = azimuth_elevation_to_ned(azimuth, desired_elevation);
+    const auto new_ned = ned_at_elevation(ned, desired_elevation);
     return ned_to_pixel(new_ned, image_size, pixel_to_tan, cam_to_body, attitude);
 }
 
@@ -0,0 +1,329 @@
+#pragma once
+#include "jacobians.hpp"
+#include "rotation_estimation.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace p2b
+{
+
+// ---- Camera installation calibration ----
+//
+// Solves for the full 3-axis cam_to_body (and optionally pixel_to_tan) from observations of known
+// NED directions: each one pairs the logged attitude with the sub-pixel position where the
+// direction was seen. Levenberg-Marquardt on the pixel reprojection error with the analytic
+// Jacobians of jacobians.hpp; the rotation is updated on the manifold, cam_to_body * exp(delta)
+// with delta in the camera frame. The problem has at most four unknowns, so each iteration is one
+// pass accumulating 4x4 normal equations. The pass is additive over observations, so long logs
+// split it into chunks on several threads (CalibrationOptions::threads) and sum the chunks.
+
+struct CalibrationObservation
+{
+    Quaternion attitude{}; ///< Body attitude when the direction was seen
+    double row{};          ///< Observed (sub-pixel) position
+    double col{};
+    Vector3 dir_ned{}; ///< Known direction (landmark, star, sun...)
+};
+
+struct CalibrationOptions
+{
+    bool estimate_pixel_to_tan = false; ///< Also refine pixel_to_tan (needs directions spread across the frame)
+    std::size_t max_iterations = 50;
+    double tolerance = 1e-12; ///< Stop when the relative cost decrease falls below this
+    std::size_t threads = 1;  ///< Threads for the normal-equation pass (0: one per hardware thread)
+};
+
+struct CalibrationResult
+{
+    Quaternion cam_to_body{Quaternion::identity()};
+    PixelToTan pixel_to_tan{1.0};
+    double rms_px{};    ///< RMS reprojection error over the used observations
+    std::size_t used{}; ///< Observations in front of the camera at the solution
+    std::size_t iterations{};
+    bool converged{};
+};
+
+/// Gauss-Newton normal equations J^T J, J^T r (unknowns: camera-frame rotation error, then
+/// pixel_to_tan) and the squared-residual sum. Chunks of observations add with +=.
+struct CalibrationNormalEquations
+{
+    std::array<std::array<double, 4>, 4> jtj{};
+    std::array<double, 4> jtr{};
+    double cost{};
+    std::size_t count{};
+
+    CalibrationNormalEquations &operator+=(const CalibrationNormalEquations &o) noexcept
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            for (std::size_t j = 0; j < 4; ++j)
+            {
+                jtj[i][j] += o.jtj[i][j];
+            }
+            jtr[i] += o.jtr[i];
+        }
+        cost += o.cost;
+        count += o.count;
+        return *this;
+    }
+};
+
+/// Normal equations of a chunk of observations at (cam_to_body, pixel_to_tan). Observations whose
+/// direction falls behind the camera are skipped.
+[[nodiscard]] inline CalibrationNormalEquations calibration_normal_equations(
+    std::span<const CalibrationObservation> observations,
+    const ImageSize &image_size,
+    PixelToTan pixel_to_tan,
+    const Quaternion &cam_to_body) noexcept
+{
+    CalibrationNormalEquations ne;
+    const double ptt = pixel_to_tan.get();
+    const Quaternion body_to_cam = cam_to_body.inverse();
+    for (const CalibrationObservation &o : observations)
+    {
+        const Vector3 d_cam = body_to_cam * (o.attitude.inverse() * o.dir_ned);
+        if (!(d_cam.x > 0.0))
+        {
+            continue;
+        }
+        auto [w, h] = detail::camera_tangents(d_cam);
+        const PixelJacobian g = detail::pixel_gradients_cam(d_cam, ptt);
+        const std::array<double, 2> residual{w / ptt + image_size.half_width() - o.row,
+                                             h / ptt + image_size.half_height() - o.col};
+        const std::array<double, 2> d_ptt{-w / (ptt * ptt), -h / (ptt * ptt)};
+        for (std::size_t k = 0; k < 2; ++k)
+        {
+            // d_cam' = exp(-delta) d_cam = d_cam + d_cam x delta  ->  g . (d_cam x delta) = (g x d_cam) . delta
+            const Vector3 d_rot = detail::cross(g[k], d_cam);
+            const std::array<double, 4> j{d_rot.x, d_rot.y, d_rot.z, d_ptt[k]};
+            for (std::size_t a = 0; a < 4; ++a)
+            {
+                for (std::size_t b = 0; b < 4; ++b)
+                {
+                    ne.jtj[a][b] += j[a] * j[b];
+                }
+                ne.jtr[a] += j[a] * residual[k];
+            }
+            ne.cost += residual[k] * residual[k];
+        }
+        ++ne.count;
+    }
+    return ne;
+}
+
+/// calibration_normal_equations split into contiguous chunks of at least ~4k observations, one
+/// per thread up to `threads` (0: one per hardware thread); the calling thread takes the first.
+/// Chunks are summed in order, so the result depends only on the chunk count.
+[[nodiscard]] inline CalibrationNormalEquations calibration_normal_equations(
+    std::span<const CalibrationObservation> observations,
+    const ImageSize &image_size,
+    PixelToTan pixel_to_tan,
+    const Quaternion &cam_to_body,
+    std::size_t threads)
+{
+    const std::size_t n = observations.size();
+    const std::size_t hw = threads > 0 ? threads : std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t chunks = std::max<std::size_t>(1, std::min(hw, n / 4096));
+    if (chunks == 1)
+    {
+        return calibration_normal_equations(observations, image_size, pixel_to_tan, cam_to_body);
+    }
+    std::vector<CalibrationNormalEquations> partial(chunks);
+    {
+        std::vector<std::jthread> workers; // joined on scope exit, also on unwind
+        workers.reserve(chunks - 1);
+        for (std::size_t c = 1; c < chunks; ++c)
+        {
+            workers.emplace_back(
+                [&, c]
+                {
+                    const std::size_t begin = n * c / chunks;
+                    partial[c] = calibration_normal_equations(
+                        observations.subspan(begin, n * (c + 1) / chunks - begin), image_size, pixel_to_tan,
+                        cam_to_body);
+                });
+        }
+        partial[0] = calibration_normal_equations(observations.first(n / chunks), image_size, pixel_to_tan,
+                                                  cam_to_body);
+    }
+    for (std::size_t c = 1; c < chunks; ++c)
+    {
+        partial[0] += partial[c];
+    }
+    return partial[0];
+}
+
+namespace detail
+{
+
+/// Solves a x = b for a symmetric positive definite 4x4 a (Cholesky). False when not SPD.
+[[nodiscard]] inline bool solve_spd4(std::array<std::array<double, 4>, 4> a,
+                                     std::array<double, 4> &x,
+                                     const std::array<double, 4> &b) noexcept
+{
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+        double d = a[j][j];
+        for (std::size_t k = 0; k < j; ++k)
+        {
+            d -= a[j][k] * a[j][k];
+        }
+        if (!(d > 0.0))
+        {
+            return false;
+        }
+        a[j][j] = std::sqrt(d);
+        for (std::size_t i = j + 1; i < 4; ++i)
+        {
+            double s = a[i][j];
+            for (std::size_t k = 0; k < j; ++k)
+            {
+                s -= a[i][k] * a[j][k];
+            }
+            a[i][j] = s / a[j][j];
+        }
+    }
+    std::array<double, 4> y{};
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        double s = b[i];
+        for (std::size_t k = 0; k < i; ++k)
+        {
+            s -= a[i][k] * y[k];
+        }
+        y[i] = s / a[i][i];
+    }
+    for (std::size_t ii = 4; ii-- > 0;)
+    {
+        double s = y[ii];
+        for (std::size_t k = ii + 1; k < 4; ++k)
+        {
+            s -= a[k][ii] * x[k];
+        }
+        x[ii] = s / a[ii][ii];
+    }
+    return true;
+}
+
+/// exp of a rotation vector as a unit quaternion.
+[[nodiscard]] inline Quaternion rotation_vector_to_quaternion(double x, double y, double z) noexcept
+{
+    const double theta = std::sqrt(x * x + y * y + z * z);
+    const double k = theta > 0.0 ? std::sin(theta / 2.0) / theta : 0.5;
+    return Quaternion{std::cos(theta / 2.0), x * k, y * k, z * k};
+}
+
+} // namespace detail
+
+/// Closed-form cam_to_body from the observations at a given pixel_to_tan (Wahba fit of camera
+/// rays onto body-frame directions): the starting point of calibrate_cam_to_body.
+[[nodiscard]] inline Quaternion initial_cam_to_body(std::span<const CalibrationObservation> observations,
+                                                    const ImageSize &image_size,
+                                                    PixelToTan pixel_to_tan) noexcept
+{
+    WahbaSolver solver;
+    for (const CalibrationObservation &o : observations)
+    {
+        solver.add(subpixel_direction(o.row, o.col, image_size, pixel_to_tan), o.attitude.inverse() * o.dir_ned);
+    }
+    return solver.solve();
+}
+
+/// Levenberg-Marquardt from (cam_to_body, pixel_to_tan). normal_equations(cam, ptt) returns the
+/// CalibrationNormalEquations summed over all observations; it is the only per-observation work.
+/// options.threads is left to normal_equations.
+template <typename NormalEquationsFn>
+[[nodiscard]] CalibrationResult solve_calibration(NormalEquationsFn &&normal_equations,
+                                                  const Quaternion &cam_to_body,
+                                                  PixelToTan pixel_to_tan,
+                                                  const CalibrationOptions &options = {})
+{
+    CalibrationResult result;
+    Quaternion cam = cam_to_body;
+    double ptt = pixel_to_tan.get();
+    CalibrationNormalEquations ne = normal_equations(cam, PixelToTan{ptt});
+    double lambda = 1e-3;
+    while (result.iterations < options.max_iterations && ne.count > 0)
+    {
+        ++result.iterations;
+        auto a = ne.jtj;
+        const std::array<double, 4> rhs{-ne.jtr[0], -ne.jtr[1], -ne.jtr[2],
+                                        options.estimate_pixel_to_tan ? -ne.jtr[3] : 0.0};
+        if (!options.estimate_pixel_to_tan) // pin pixel_to_tan: its step solves 1 * x = 0
+        {
+            a[3] = {0.0, 0.0, 0.0, 1.0};
+            a[0][3] = 0.0;
+            a[1][3] = 0.0;
+            a[2][3] = 0.0;
+        }
+        bool improved = false;
+        while (!improved && lambda < 1e12)
+        {
+            auto damped = a;
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                damped[i][i] += lambda * std::max(a[i][i], 1e-12);
+            }
+            std::array<double, 4> step{};
+            if (!detail::solve_spd4(damped, step, rhs))
+            {
+                lambda *= 10.0;
+                continue;
+            }
+            const Quaternion cam_new = cam * detail::rotation_vector_to_quaternion(step[0], step[1], step[2]);
+            const double ptt_new = ptt + step[3];
+            const CalibrationNormalEquations ne_new =
+                ptt_new > 0.0 ? normal_equations(cam_new, PixelToTan{ptt_new}) : CalibrationNormalEquations{};
+            if (ne_new.count == ne.count && ne_new.cost < ne.cost)
+            {
+                const double decrease = (ne.cost - ne_new.cost) / std::max(ne.cost, 1e-300);
+                cam = cam_new;
+                ptt = ptt_new;
+                ne = ne_new;
+                lambda = std::max(lambda / 10.0, 1e-12);
+                improved = true;
+                result.converged = decrease < options.tolerance;
+            }
+            else
+            {
+                lambda *= 10.0;
+            }
+        }
+        if (!improved) // no downhill step left: at the minimum to rounding
+        {
+            result.converged = true;
+        }
+        if (result.converged)
+        {
+            break;
+        }
+    }
+    result.cam_to_body = cam;
+    result.pixel_to_tan = PixelToTan{ptt};
+    result.used = ne.count;
+    result.rms_px = ne.count > 0 ? std::sqrt(ne.cost / (2.0 * static_cast<double>(ne.count))) : 0.0;
+    return result;
+}
+
+/// Calibrates cam_to_body (and optionally pixel_to_tan) from observations, starting from
+/// `initial` or, when absent, from initial_cam_to_body at pixel_to_tan. Each iteration's pass over
+/// the observations runs on options.threads threads.
+[[nodiscard]] inline CalibrationResult calibrate_cam_to_body(std::span<const CalibrationObservation> observations,
+                                                             const ImageSize &image_size,
+                                                             PixelToTan pixel_to_tan,
+                                                             const std::optional<Quaternion> &initial = std::nullopt,
+                                                             const CalibrationOptions &options = {})
+{
+    return solve_calibration(
+        [&](const Quaternion &cam, PixelToTan ptt)
+        { return calibration_normal_equations(observations, image_size, ptt, cam, options.threads); },
+        initial ? *initial : initial_cam_to_body(observations, image_size, pixel_to_tan), pixel_to_tan, options);
+}
+
+} // namespace p2b
@@ -0,0 +1,164 @@
+#pragma once
+#include "body_space.hpp"
+#include <utility>
+
+namespace p2b
+{
+
+// ---- Camera with prepared state ----
+//
+// Holds the intrinsics (image size, pixel-to-tan), the installation and the current attitude,
+// and keeps the composed camera <-> NED rotations so each projection costs one quaternion
+// rotation instead of two (plus an inverse). Quaternions are expected to be unit; results then
+// match the free functions up to rounding of the composed quaternion.
+
+namespace detail
+{
+
+/// Camera-frame direction for pixel tangents (the rotation-free part of warp_image_to_body).
+[[nodiscard]] inline Vector3 camera_direction(double w_tan, double h_tan) noexcept
+{
+    const double cos_az = 1.0 / std::sqrt(1.0 + w_tan * w_tan);
+    const double cos_el = 1.0 / std::sqrt(1.0 + h_tan * h_tan);
+    return Vector3{cos_el * cos_az, cos_el * w_tan * cos_az, h_tan * cos_el};
+}
+
+/// Pixel tangents of a camera-frame direction (the rotation-free part of warp_body_to_image).
+[[nodiscard]] inline std::pair<double, double> camera_tangents(const Vector3 &dir_cam) noexcept
+{
+    return {dir_cam.y / dir_cam.x, dir_cam.z / std::sqrt(dir_cam.x * dir_cam.x + dir_cam.y * dir_cam.y)};
+}
+
+} // namespace detail
+
+class Camera
+{
+public:
+    Camera(const ImageSize &image_size,
+           PixelToTan pixel_to_tan,
+           const Quaternion &cam_to_body,
+           const Quaternion &attitude = Quaternion::identity()) noexcept
+        : image_size_{image_size}, pixel_to_tan_{pixel_to_tan}, cam_to_body_{cam_to_body}, attitude_{attitude},
+          cam_to_ned_{attitude * cam_to_body}, ned_to_cam_{cam_to_ned_.inverse()}
+    {
+    }
+
+    /// Per-frame update: recomposes the camera <-> NED rotations once.
+    void set_attitude(const Quaternion &attitude) noexcept
+    {
+        attitude_ = attitude;
+        cam_to_ned_ = attitude * cam_to_body_;
+        ned_to_cam_ = cam_to_ned_.inverse();
+    }
+
+    /// Per-frame installation update for gimbaled cameras (see GimbalChain).
+    void set_cam_to_body(const Quaternion &cam_to_body) noexcept
+    {
+        cam_to_body_ = cam_to_body;
+        cam_to_ned_ = attitude_ * cam_to_body;
+        ned_to_cam_ = cam_to_ned_.inverse();
+    }
+
+    [[nodiscard]] const ImageSize &image_size() const noexcept
+    {
+        return image_size_;
+    }
+
+    [[nodiscard]] PixelToTan pixel_to_tan() const noexcept
+    {
+        return pixel_to_tan_;
+    }
+
+    [[nodiscard]] const Quaternion &cam_to_body() const noexcept
+    {
+        return cam_to_body_;
+    }
+
+    [[nodiscard]] const Quaternion &attitude() const noexcept
+    {
+        return attitude_;
+    }
+
+    /// Pixel -> NED direction at the current attitude.
+    [[nodiscard]] Vector3 pixel_to_ned(PixelIndex row, PixelIndex col) const noexcept
+    {
+        return cam_to_ned_ * detail::camera_direction(w_tan(row), h_tan(col));
+    }
+
+    /// Camera-frame direction of a pixel: the attitude-independent part of pixel_to_ned.
+    /// Compute once per pixel and pass to direction_to_ned under many attitudes.
+    [[nodiscard]] Vector3 pixel_direction(PixelIndex row, PixelIndex col) const noexcept
+    {
+        return detail::camera_direction(w_tan(row), h_tan(col));
+    }
+
+    /// Camera-frame direction (see pixel_direction) -> NED at the current attitude.
+    [[nodiscard]] Vector3 direction_to_ned(const Vector3 &dir_cam) const noexcept
+    {
+        return cam_to_ned_ * dir_cam;
+    }
+
+    /// NED direction -> pixel (truncated) at the current attitude.
+    [[nodiscard]] std::pair<PixelIndex, PixelIndex> ned_to_pixel(const Vector3 &dir_ned) const noexcept
+    {
+        auto [w, h] = detail::camera_tangents(ned_to_cam_ * dir_ned);
+        return {pixel_from_truncated(w / pixel_to_tan_.get() + image_size_.half_width()),
+                pixel_from_truncated(h / pixel_to_tan_.get() + image_size_.half_height())};
+    }
+
+    /// Rotation taking camera-frame directions at the current attitude to the camera frame at q_new.
+    /// Compute once per frame and pass to pixel_after_rotation for many pixels.
+    [[nodiscard]] Quaternion rotation_to(const Quaternion &q_new) const noexcept
+    {
+        return (q_new * cam_to_body_).inverse() * cam_to_ned_;
+    }
+
+    /// Pixel position after the body moves from the current attitude to the one behind `rotation`
+    /// (see rotation_to).
+    [[nodiscard]] std::pair<PixelIndex, PixelIndex> pixel_after_rotation(PixelIndex row,
+                                                                         PixelIndex col,
+                                                                         const Quaternion &rotation,
+                                                                         bool round_back = false) const noexcept
+    {
+        auto [w, h] = detail::camera_tangents(rotation * detail::camera_direction(w_tan(row), h_tan(col)));
+        const double row_v = w / pixel_to_tan_.get() + image_size_.half_width();
+        const double col_v = h / pixel_to_tan_.get() + image_size_.half_height();
+        return round_back ? std::pair{pixel_from_rounded(row_v), pixel_from_rounded(col_v)}
+                          : std::pair{pixel_from_truncated(row_v), pixel_from_truncated(col_v)};
+    }
+
+    /// True when the NED direction is in front of the camera and projects inside the frame margin
+    /// (same boundary semantics as is_pixel_inside_frame).
+    [[nodiscard]] bool is_inside(const Vector3 &dir_ned, double boundary) const noexcept
+    {
+        const Vector3 dir_cam = ned_to_cam_ * dir_ned;
+        if (dir_cam.x <= 0.0)
+        {
+            return false;
+        }
+        auto [w, h] = detail::camera_tangents(dir_cam);
+        return is_pixel_inside_frame(pixel_from_truncated(w / pixel_to_tan_.get() + image_size_.half_width()),
+                                     pixel_from_truncated(h / pixel_to_tan_.get() + image_size_.half_height()),
+                                     image_size_, boundary);
+    }
+
+private:
+    [[nodiscard]] double w_tan(PixelIndex row) const noexcept
+    {
+        return (static_cast<double>(row.value()) - image_size_.half_width()) * pixel_to_tan_.get();
+    }
+
+    [[nodiscard]] double h_tan(PixelIndex col) const noexcept
+    {
+        return (static_cast<double>(col.value()) - image_size_.half_height()) * pixel_to_tan_.get();
+    }
+
+    ImageSize image_size_;
+    PixelToTan pixel_to_tan_;
+    Quaternion cam_to_body_;
+    Quaternion attitude_;
+    Quaternion cam_to_ned_;
+    Quaternion ned_to_cam_;
+};
+
+} // namespace p2b
@@ -0,0 +1,228 @@
+#pragma once
+#include "body_space.hpp"
+#include <cmath>
+#include <limits>
+#include <span>
+#include <utility>
+
+namespace p2b
+{
+
+// ---- Analytic elevation contours ----
+//
+// The camera model maps pixel tangents (w_tan, h_tan) to the camera-frame direction
+//   (1, w_tan, h_tan * sqrt(1 + w_tan^2))        (up to scale)
+// so along a fixed row the direction is linear in h_tan, and the set of directions at a
+// fixed NED elevation (a cone about the vertical) is hit where a quadratic vanishes.
+// Along a fixed col the direction sweeps a circle in azimuth, solved with one acos.
+// Crossings are returned as sub-pixel coordinates before truncation; absent ones are NaN.
+
+namespace detail
+{
+
+/// Unit camera axes expressed in NED for the current attitude: forward, right (width) and down (height).
+struct ContourBasis
+{
+    Vector3 forward;
+    Vector3 right;
+    Vector3 down;
+};
+
+[[nodiscard]] inline ContourBasis contour_basis(const Quaternion &cam_to_body, const Quaternion &attitude) noexcept
+{
+    // Normalized so slightly non-unit quaternions do not bias the elevation
+    return {(attitude * (cam_to_body * Vector3{1.0, 0.0, 0.0})).normalized(),
+            (attitude * (cam_to_body * Vector3{0.0, 1.0, 0.0})).normalized(),
+            (attitude * (cam_to_body * Vector3{0.0, 0.0, 1.0})).normalized()};
+}
+
+[[nodiscard]] constexpr double dot(const Vector3 &a, const Vector3 &b) noexcept
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+constexpr double NO_CROSSING = std::numeric_limits<double>::quiet_NaN();
+
+/// Crossings (as h_tan) of a row's pixel line with the elevation cone.
+[[nodiscard]] inline std::pair<double, double> contour_h_tans_at_row(const ContourBasis &basis,
+                                                                     double w_tan,
+                                                                     double sin_el) noexcept
+{
+    const double scale = std::sqrt(1.0 + w_tan * w_tan);
+    const Vector3 a{basis.forward.x + w_tan * basis.right.x,
+                    basis.forward.y + w_tan * basis.right.y,
+                    basis.forward.z + w_tan * basis.right.z};
+    const Vector3 &b = basis.down;
+
+    // Direction a + g * b has elevation asin(sin_el) where -(a_z + g b_z) = sin_el * |a + g b|.
+    if (sin_el == 0.0)
+    {
+        if (b.z == 0.0)
+        {
+            return {NO_CROSSING, NO_CROSSING};
+        }
+        return {-a.z / b.z / scale, NO_CROSSING};
+    }
+
+    const double eps = sin_el * sin_el;
+    const double qa = b.z * b.z - eps * dot(b, b);
+    const double qb = a.z * b.z - eps * dot(a, b);
+    const double qc = a.z * a.z - eps * dot(a, a);
+
+    double g1 = NO_CROSSING;
+    double g2 = NO_CROSSING;
+    if (qa == 0.0)
+    {
+        if (qb != 0.0)
+        {
+            g1 = -qc / (2.0 * qb);
+        }
+    }
+    else
+    {
+        const double disc = qb * qb - qa * qc;
+        if (disc >= 0.0)
+        {
+            // Numerically stable pair of roots
+            const double q = -(qb + std::copysign(std::sqrt(disc), qb));
+            g1 = q / qa;
+            g2 = q != 0.0 ? qc / q : g1;
+        }
+    }
+
+    // Squaring admits the mirrored cone; keep roots on the requested side of the horizon
+    const auto on_side = [&](double g) { return !std::isnan(g) && -(a.z + g * b.z) * sin_el > 0.0; };
+    double h1 = on_side(g1) ? g1 / scale : NO_CROSSING;
+    double h2 = on_side(g2) && g2 != g1 ? g2 / scale : NO_CROSSING;
+    if (std::isnan(h1) || (!std::isnan(h2) && h2 < h1))
+    {
+        std::swap(h1, h2);
+    }
+    return {h1, h2};
+}
+
+/// Crossings (as w_tan) of a col's pixel line with the elevation cone.
+[[nodiscard]] inline std::pair<double, double> contour_w_tans_at_col(const ContourBasis &basis,
+                                                                     double h_tan,
+                                                                     double sin_el) noexcept
+{
+    // Unit direction: cos_el_cam * (cos az, sin az, h_tan) in camera frame, az in (-pi/2, pi/2).
+    // NED elevation condition: forward_z cos az + right_z sin az = k
+    const double cos_el_cam = 1.0 / std::sqrt(1.0 + h_tan * h_tan);
+    const double k = -sin_el / cos_el_cam - h_tan * basis.down.z;
+    const double a = basis.forward.z;
+    const double b = basis.right.z;
+    const double rho = std::sqrt(a * a + b * b);
+    if (rho == 0.0 || std::fabs(k) > rho)
+    {
+        return {NO_CROSSING, NO_CROSSING};
+    }
+
+    const double phi = std::atan2(b, a);
+    const double delta = std::acos(k / rho);
+    const auto to_w_tan = [](double az)
+    {
+        // Wrap into (-pi, pi] and keep the forward half-plane the camera model can represent
+        const double wrapped = std::remainder(az, 2.0 * linalg3d::PI);
+        return std::fabs(wrapped) < linalg3d::PI / 2.0 ? std::tan(wrapped) : NO_CROSSING;
+    };
+    double w1 = to_w_tan(phi - delta);
+    double w2 = delta != 0.0 ? to_w_tan(phi + delta) : NO_CROSSING;
+    if (std::isnan(w1) || (!std::isnan(w2) && w2 < w1))
+    {
+        std::swap(w1, w2);
+    }
+    return {w1, w2};
+}
+
+} // namespace detail
+
+/// Col coordinates where the given row crosses the NED elevation contour.
+/// Returns up to two crossings in ascending order (sub-pixel, NaN when absent).
+/// Crossings may fall outside [0, height]; callers clip to the frame.
+[[nodiscard]] inline std::pair<double, double> elevation_contour_at_row(PixelIndex row,
+                                                                        const ImageSize &image_size,
+                                                                        PixelToTan pixel_to_tan,
+                                                                        const Quaternion &cam_to_body,
+                                                                        const Quaternion &attitude,
+                                                                        Radians elevation) noexcept
+{
+    const auto basis = detail::contour_basis(cam_to_body, attitude);
+    const double w_tan = (static_cast<double>(row.value()) - image_size.half_width()) * pixel_to_tan.get();
+    auto [h1, h2] = detail::contour_h_tans_at_row(basis, w_tan, std::sin(elevation.value()));
+    return {h1 / pixel_to_tan.get() + image_size.half_height(), h2 / pixel_to_tan.get() + image_size.half_height()};
+}
+
+/// Row coordinates where the given col crosses the NED elevation contour.
+/// Returns up to two crossings in ascending order (sub-pixel, NaN when absent).
+/// Crossings may fall outside [0, width]; callers clip to the frame.
+[[nodiscard]] inline std::pair<double, double> elevation_contour_at_col(PixelIndex col,
+                                                                        const ImageSize &image_size,
+                                                                        PixelToTan pixel_to_tan,
+                                                                        const Quaternion &cam_to_body,
+                                                                        const Quaternion &attitude,
+                                                                        Radians elevation) noexcept
+{
+    const auto basis = detail::contour_basis(cam_to_body, attitude);
+    const double h_tan = (static_cast<double>(col.value()) - image_size.half_height()) * pixel_to_tan.get();
+    auto [w1, w2] = detail::contour_w_tans_at_col(basis, h_tan, std::sin(elevation.value()));
+    return {w1 / pixel_to_tan.get() + image_size.half_width(), w2 / pixel_to_tan.get() + image_size.half_width()};
+}
+
+/// Rasterize an elevation contour across rows: out[i] receives the col crossings of row i.
+/// The attitude is composed once; each row costs a handful of flops and one sqrt.
+inline void elevation_contour_cols(std::span<std::pair<double, double>> out,
+                                   const ImageSize &image_size,
+                                   PixelToTan pixel_to_tan,
+                                   const Quaternion &cam_to_body,
+                                   const Quaternion &attitude,
+                                   Radians elevation) noexcept
+{
+    const auto basis = detail::contour_basis(cam_to_body, attitude);
+    const double sin_el = std::sin(elevation.value());
+    const double ptt = pixel_to_tan.get();
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        const double w_tan = (static_cast<double>(i) - image_size.half_width()) * ptt;
+        auto [h1, h2] = detail::contour_h_tans_at_row(basis, w_tan, sin_el);
+        out[i] = {h1 / ptt + image_size.half_height(), h2 / ptt + image_size.half_height()};
+    }
+}
+
+/// Rasterize an elevation contour across cols: out[j] receives the row crossings of col j.
+inline void elevation_contour_rows(std::span<std::pair<double, double>> out,
+                                   const ImageSize &image_size,
+                                   PixelToTan pixel_to_tan,
+                                   const Quaternion &cam_to_body,
+                                   const Quaternion &attitude,
+                                   Radians elevation) noexcept
+{
+    const auto basis = detail::contour_basis(cam_to_body, attitude);
+    const double sin_el = std::sin(elevation.value());
+    const double ptt = pixel_to_tan.get();
+    for (size_t j = 0; j < out.size(); ++j)
+    {
+        const double h_tan = (static_cast<double>(j) - image_size.half_height()) * ptt;
+        auto [w1, w2] = detail::contour_w_tans_at_col(basis, h_tan, sin_el);
+        out[j] = {w1 / ptt + image_size.half_width(), w2 / ptt + image_size.half_width()};
+    }
+}
+
+/// Rasterize the horizon (0 elevation): out[i] receives the col of the horizon at row i.
+/// The horizon crosses each row at most once; NaN when the row never reaches it.
+inline void horizon_line(std::span<double> out,
+                         const ImageSize &image_size,
+                         PixelToTan pixel_to_tan,
+                         const Quaternion &cam_to_body,
+                         const Quaternion &attitude) noexcept
+{
+    const auto basis = detail::contour_basis(cam_to_body, attitude);
+    const double ptt = pixel_to_tan.get();
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        const double w_tan = (static_cast<double>(i) - image_size.half_width()) * ptt;
+        out[i] = detail::contour_h_tans_at_row(basis, w_tan, 0.0).first / ptt + image_size.half_height();
+    }
+}
+
+} // namespace p2b
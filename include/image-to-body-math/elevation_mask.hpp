@@ -0,0 +1,184 @@
+#pragma once
+#include "elevation_contour.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace p2b
+{
+
+// ---- Sky / ground masks from attitude ----
+//
+// A mask buffer is row-major over the image: one line per col (height index), each line
+// holding `width` pixels indexed by row — mask[col * width + row], i.e. numpy shape (height, width).
+// Each line meets the threshold contour at most twice, so it splits into at most three runs
+// whose side is decided by one direction evaluation each: O(height) math for the whole frame.
+
+/// Which side of the elevation threshold a mask selects.
+enum class MaskSide : uint8_t
+{
+    ABOVE, ///< elevation above threshold (sky)
+    BELOW  ///< elevation at or below threshold (ground)
+};
+
+/// A run of selected pixels on one col: rows [row_begin, row_end).
+struct MaskSpan
+{
+    uint64_t col{};
+    uint64_t row_begin{};
+    uint64_t row_end{};
+};
+
+namespace detail
+{
+
+/// Sine of the NED elevation of the ray through pixel tangents (w_tan, h_tan).
+[[nodiscard]] inline double sin_elevation_at(const ContourBasis &basis, double w_tan, double h_tan) noexcept
+{
+    const double g = h_tan * std::sqrt(1.0 + w_tan * w_tan);
+    const Vector3 d{basis.forward.x + w_tan * basis.right.x + g * basis.down.x,
+                    basis.forward.y + w_tan * basis.right.y + g * basis.down.y,
+                    basis.forward.z + w_tan * basis.right.z + g * basis.down.z};
+    return -d.z / std::sqrt(dot(d, d));
+}
+
+/// First pixel index at or after a sub-pixel boundary, clamped to [0, width].
+[[nodiscard]] inline uint64_t first_pixel_after(double boundary, uint64_t width) noexcept
+{
+    if (!(boundary > 0.0))
+    {
+        return 0;
+    }
+    const double up = std::ceil(boundary);
+    return up >= static_cast<double>(width) ? width : static_cast<uint64_t>(up);
+}
+
+/// Selected runs on one col (at most two). Returns the number written to `out`.
+[[nodiscard]] inline size_t mask_spans_at_col(const ContourBasis &basis,
+                                              uint64_t col,
+                                              const ImageSize &image_size,
+                                              double pixel_to_tan,
+                                              double sin_threshold,
+                                              MaskSide side,
+                                              std::array<MaskSpan, 2> &out) noexcept
+{
+    const double h_tan = (static_cast<double>(col) - image_size.half_height()) * pixel_to_tan;
+    auto [w1, w2] = contour_w_tans_at_col(basis, h_tan, sin_threshold);
+
+    std::array<uint64_t, 4> cuts{0, 0, 0, 0};
+    size_t n_cuts = 1;
+    for (const double w : {w1, w2})
+    {
+        if (!std::isnan(w))
+        {
+            cuts[n_cuts++] = first_pixel_after(w / pixel_to_tan + image_size.half_width(), image_size.width);
+        }
+    }
+    cuts[n_cuts++] = image_size.width;
+
+    size_t count = 0;
+    for (size_t k = 0; k + 1 < n_cuts; ++k)
+    {
+        const uint64_t begin = cuts[k];
+        const uint64_t end = cuts[k + 1];
+        if (begin >= end)
+        {
+            continue;
+        }
+        const uint64_t mid = begin + (end - begin) / 2;
+        const double w_tan = (static_cast<double>(mid) - image_size.half_width()) * pixel_to_tan;
+        const bool above = sin_elevation_at(basis, w_tan, h_tan) > sin_threshold;
+        if (above != (side == MaskSide::ABOVE))
+        {
+            continue;
+        }
+        if (count > 0 && out[count - 1].row_end == begin)
+        {
+            out[count - 1].row_end = end; // tangent crossing: merge touching runs
+        }
+        else
+        {
+            out[count++] = MaskSpan{col, begin, end};
+        }
+    }
+    return count;
+}
+
+/// Sine of the effective threshold: the margin (pixels, converted at the image center) moves
+/// the boundary away from the selected side, so positive margins shrink the selection.
+[[nodiscard]] inline double mask_sin_threshold(Radians threshold,
+                                               double margin_px,
+                                               PixelToTan pixel_to_tan,
+                                               MaskSide side) noexcept
+{
+    const double margin = std::atan(margin_px * pixel_to_tan.get());
+    return std::sin(threshold.value() + (side == MaskSide::ABOVE ? margin : -margin));
+}
+
+} // namespace detail
+
+/// Run-length sky/ground mask: every run of pixels on the requested side of the elevation threshold.
+/// margin_px pulls the boundary into the selected side by about that many pixels (negative grows it).
+/// Runs are ordered by col, then by row.
+[[nodiscard]] inline std::vector<MaskSpan> elevation_mask_spans(const ImageSize &image_size,
+                                                                PixelToTan pixel_to_tan,
+                                                                const Quaternion &cam_to_body,
+                                                                const Quaternion &attitude,
+                                                                Radians threshold,
+                                                                double margin_px,
+                                                                MaskSide side)
+{
+    const auto basis = detail::contour_basis(cam_to_body, attitude);
+    const double sin_thr = detail::mask_sin_threshold(threshold, margin_px, pixel_to_tan, side);
+
+    std::vector<MaskSpan> spans;
+    spans.reserve(image_size.height);
+    std::array<MaskSpan, 2> line{};
+    for (uint64_t col = 0; col < image_size.height; ++col)
+    {
+        const size_t n = detail::mask_spans_at_col(basis, col, image_size, pixel_to_tan.get(), sin_thr, side, line);
+        spans.insert(spans.end(), line.begin(), line.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    return spans;
+}
+
+/// Fill a row-major (height x width) uint8 mask: `value` on the selected side, 0 elsewhere.
+/// Each line is written with at most five memsets. Lines that do not fit in `mask` are skipped.
+inline void fill_elevation_mask(std::span<uint8_t> mask,
+                                const ImageSize &image_size,
+                                PixelToTan pixel_to_tan,
+                                const Quaternion &cam_to_body,
+                                const Quaternion &attitude,
+                                Radians threshold,
+                                double margin_px,
+                                MaskSide side,
+                                uint8_t value = 255) noexcept
+{
+    if (image_size.width == 0)
+    {
+        return;
+    }
+    const auto basis = detail::contour_basis(cam_to_body, attitude);
+    const double sin_thr = detail::mask_sin_threshold(threshold, margin_px, pixel_to_tan, side);
+    const uint64_t lines = std::min<uint64_t>(image_size.height, mask.size() / image_size.width);
+
+    std::array<MaskSpan, 2> line{};
+    for (uint64_t col = 0; col < lines; ++col)
+    {
+        uint8_t *base = mask.data() + col * image_size.width;
+        const size_t n = detail::mask_spans_at_col(basis, col, image_size, pixel_to_tan.get(), sin_thr, side, line);
+        uint64_t cursor = 0;
+        for (size_t k = 0; k < n; ++k)
+        {
+            std::memset(base + cursor, 0, line[k].row_begin - cursor);
+            std::memset(base + line[k].row_begin, value, line[k].row_end - line[k].row_begin);
+            cursor = line[k].row_end;
+        }
+        std::memset(base + cursor, 0, image_size.width - cursor);
+    }
+}
+
+} // namespace p2b
@@ -0,0 +1,316 @@
+#pragma once
+#include "body_space.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace p2b
+{
+
+// ---- Gimbal joint chain ----
+//
+// cam_to_body of a pan/tilt/roll gimbal:
+//
+//   cam_to_body = base * Rz(pan) * Ry(-tilt) * Rx(roll) * sensor
+//
+// `base` is the fixed mount of the gimbal on the body and `sensor` the fixed alignment of the
+// camera on the last joint. With both identity and pan = roll = 0 this is cam_to_body_from_angle:
+// positive tilt looks down, positive pan turns toward body +y (right) and roll turns the camera
+// about its optical axis. Each joint is a single-axis quaternion, so composing one costs eight
+// multiplies; GimbalChain keeps the joint half-angle trig and the partial products of the chain,
+// and an update recomputes only from the first joint whose angle changed.
+
+/// Fixed parts of the chain.
+struct GimbalMount
+{
+    Quaternion base{Quaternion::identity()};   ///< Body <- pan-joint frame
+    Quaternion sensor{Quaternion::identity()}; ///< Roll-joint frame <- camera
+};
+
+/// Joint angles, applied pan (about z), then tilt (about y, positive down), then roll (about x).
+struct GimbalAngles
+{
+    Radians pan{0.0};
+    Radians tilt{0.0};
+    Radians roll{0.0};
+};
+
+namespace detail
+{
+
+/// cos and sin of half a joint angle: the joint's quaternion (c, s on its axis).
+struct HalfAngle
+{
+    double c{1.0};
+    double s{0.0};
+
+    [[nodiscard]] static HalfAngle of(double angle) noexcept
+    {
+        return {std::cos(angle / 2.0), std::sin(angle / 2.0)};
+    }
+};
+
+/// q * (c, 0, 0, s)
+[[nodiscard]] constexpr Quaternion mul_z(const Quaternion &q, HalfAngle a) noexcept
+{
+    return Quaternion{q.w * a.c - q.z * a.s, q.x * a.c + q.y * a.s, q.y * a.c - q.x * a.s, q.z * a.c + q.w * a.s};
+}
+
+/// q * (c, 0, s, 0)
+[[nodiscard]] constexpr Quaternion mul_y(const Quaternion &q, HalfAngle a) noexcept
+{
+    return Quaternion{q.w * a.c - q.y * a.s, q.x * a.c - q.z * a.s, q.y * a.c + q.w * a.s, q.z * a.c + q.x * a.s};
+}
+
+/// q * (c, s, 0, 0)
+[[nodiscard]] constexpr Quaternion mul_x(const Quaternion &q, HalfAngle a) noexcept
+{
+    return Quaternion{q.w * a.c - q.x * a.s, q.x * a.c + q.w * a.s, q.y * a.c + q.z * a.s, q.z * a.c - q.y * a.s};
+}
+
+} // namespace detail
+
+/// cam_to_body of a gimbal at the given joint angles (one-off; see GimbalChain for streams).
+[[nodiscard]] inline Quaternion gimbal_cam_to_body(const GimbalMount &mount, const GimbalAngles &angles) noexcept
+{
+    const Quaternion pan = detail::mul_z(mount.base, detail::HalfAngle::of(angles.pan.value()));
+    const Quaternion tilt = detail::mul_y(pan, detail::HalfAngle::of(-angles.tilt.value()));
+    return detail::mul_x(tilt, detail::HalfAngle::of(angles.roll.value())) * mount.sensor;
+}
+
+/// Gimbal chain with cached joint trig and partial products, for per-frame joint updates.
+class GimbalChain
+{
+public:
+    explicit GimbalChain(const GimbalMount &mount = {}, const GimbalAngles &angles = {}) noexcept
+        : mount_{mount}, pan_{angles.pan.value()}, tilt_{angles.tilt.value()}, roll_{angles.roll.value()},
+          pan_half_{detail::HalfAngle::of(pan_)}, tilt_half_{detail::HalfAngle::of(-tilt_)},
+          roll_half_{detail::HalfAngle::of(roll_)}
+    {
+        update_from_pan();
+    }
+
+    /// Per-frame update: only the trig of joints whose angle changed is recomputed, and the chain
+    /// only from the first changed joint on.
+    void set_angles(const GimbalAngles &angles) noexcept
+    {
+        const bool pan_changed = angles.pan.value() != pan_;
+        const bool tilt_changed = angles.tilt.value() != tilt_;
+        const bool roll_changed = angles.roll.value() != roll_;
+        if (pan_changed)
+        {
+            pan_ = angles.pan.value();
+            pan_half_ = detail::HalfAngle::of(pan_);
+        }
+        if (tilt_changed)
+        {
+            tilt_ = angles.tilt.value();
+            tilt_half_ = detail::HalfAngle::of(-tilt_);
+        }
+        if (roll_changed)
+        {
+            roll_ = angles.roll.value();
+            roll_half_ = detail::HalfAngle::of(roll_);
+        }
+        if (pan_changed)
+        {
+            update_from_pan();
+        }
+        else if (tilt_changed)
+        {
+            update_from_tilt();
+        }
+        else if (roll_changed)
+        {
+            update_from_roll();
+        }
+    }
+
+    void set_pan(Radians pan) noexcept
+    {
+        set_angles({pan, Radians{tilt_}, Radians{roll_}});
+    }
+
+    void set_tilt(Radians tilt) noexcept
+    {
+        set_angles({Radians{pan_}, tilt, Radians{roll_}});
+    }
+
+    void set_roll(Radians roll) noexcept
+    {
+        set_angles({Radians{pan_}, Radians{tilt_}, roll});
+    }
+
+    [[nodiscard]] GimbalAngles angles() const noexcept
+    {
+        return {Radians{pan_}, Radians{tilt_}, Radians{roll_}};
+    }
+
+    [[nodiscard]] const GimbalMount &mount() const noexcept
+    {
+        return mount_;
+    }
+
+    /// Camera-to-body rotation at the current joint angles.
+    [[nodiscard]] const Quaternion &cam_to_body() const noexcept
+    {
+        return cam_to_body_;
+    }
+
+private:
+    // Everything downstream of a changed joint is recomposed; the upstream products are kept
+    void update_from_pan() noexcept
+    {
+        after_pan_ = detail::mul_z(mount_.base, pan_half_);
+        update_from_tilt();
+    }
+
+    void update_from_tilt() noexcept
+    {
+        after_tilt_ = detail::mul_y(after_pan_, tilt_half_);
+        update_from_roll();
+    }
+
+    void update_from_roll() noexcept
+    {
+        cam_to_body_ = detail::mul_x(after_tilt_, roll_half_) * mount_.sensor;
+    }
+
+    GimbalMount mount_;
+    double pan_{};
+    double tilt_{};
+    double roll_{};
+    detail::HalfAngle pan_half_;
+    detail::HalfAngle tilt_half_; ///< Of -tilt
+    detail::HalfAngle roll_half_;
+    Quaternion after_pan_{Quaternion::identity()};  ///< base * Rz(pan)
+    Quaternion after_tilt_{Quaternion::identity()}; ///< base * Rz(pan) * Ry(-tilt)
+    Quaternion cam_to_body_{Quaternion::identity()};
+};
+
+// ---- Pointing (inverse kinematics) ----
+//
+// Pan/tilt that put a NED direction on the image center (camera +x). With the target in the
+// pan-joint frame, g = (attitude * base)^-1 * dir, and the optical axis in the tilt-joint frame,
+// a = Rx(roll) * sensor * x, the chain gives:
+//
+//   tilt:  a_x sin(tilt) + a_z cos(tilt) = g_z   ->   tilt = asin(g_z / hypot(a_x, a_z)) - atan2(a_z, a_x)
+//          (or the flipped branch pi - asin(...) - atan2(...))
+//   pan:   atan2(g_y, g_x) - atan2(a_y, a_x cos(tilt) - a_z sin(tilt))
+//
+// Everything but g is fixed per (attitude, mount, roll), so GimbalPointing prepares it once and
+// each target costs one rotation and a few inverse trig calls. Of the branches (and the pan
+// equivalents modulo 2 pi) within the joint limits, the one nearest the current angles wins.
+
+struct GimbalLimits
+{
+    Radians pan_min{-linalg3d::PI};
+    Radians pan_max{linalg3d::PI};
+    Radians tilt_min{-linalg3d::PI / 2.0};
+    Radians tilt_max{linalg3d::PI / 2.0};
+};
+
+struct GimbalPointingResult
+{
+    GimbalAngles angles{}; ///< Roll is the current roll, unchanged
+    bool reachable{};      ///< False: target outside the joint limits; angles are then the nearest clamped command
+};
+
+class GimbalPointing
+{
+public:
+    /// Prepares the pointing solve for one attitude. `current` chooses among equivalent
+    /// solutions and fixes the roll.
+    GimbalPointing(const GimbalMount &mount,
+                   const Quaternion &attitude,
+                   const GimbalAngles &current = {},
+                   const GimbalLimits &limits = {}) noexcept
+        : ned_to_pan_{(attitude * mount.base).inverse()}, current_{current}, limits_{limits}
+    {
+        const Quaternion roll = detail::mul_x(Quaternion::identity(), detail::HalfAngle::of(current.roll.value()));
+        const Vector3 axis = roll * mount.sensor * Vector3{1.0, 0.0, 0.0};
+        ax_ = axis.x;
+        ay_ = axis.y;
+        az_ = axis.z;
+        tilt_reach_ = std::sqrt(ax_ * ax_ + az_ * az_);
+        tilt_offset_ = std::atan2(az_, ax_);
+    }
+
+    /// Joint angles centering `dir_ned` (need not be unit).
+    [[nodiscard]] GimbalPointingResult solve(const Vector3 &dir_ned) const noexcept
+    {
+        const Vector3 g = ned_to_pan_ * dir_ned;
+        const double norm = std::sqrt(g.x * g.x + g.y * g.y + g.z * g.z);
+        const double ratio = g.z / (norm * tilt_reach_);
+        const bool elevation_reachable = std::fabs(ratio) <= 1.0 + 1e-12;
+        const double lift = std::asin(std::clamp(ratio, -1.0, 1.0));
+        // Straight along the pan axis any pan works: keep the current one
+        const bool on_pan_axis = g.x * g.x + g.y * g.y <= 1e-24 * norm * norm;
+        const double target_azimuth = std::atan2(g.y, g.x);
+
+        GimbalPointingResult best;
+        best.angles.roll = current_.roll;
+        double best_cost = std::numeric_limits<double>::infinity();
+        for (const double branch : {lift, linalg3d::PI - lift})
+        {
+            const double tilt = std::remainder(branch - tilt_offset_, 2.0 * linalg3d::PI);
+            const double pan = on_pan_axis ? current_.pan.value() : pan_for(tilt, target_azimuth);
+            const auto [pan_cmd, pan_ok] = nearest_pan(pan);
+            const bool tilt_ok = tilt >= limits_.tilt_min.value() && tilt <= limits_.tilt_max.value();
+            const double tilt_cmd = std::clamp(tilt, limits_.tilt_min.value(), limits_.tilt_max.value());
+            const bool reachable = elevation_reachable && pan_ok && tilt_ok;
+            const double d_pan = pan_cmd - current_.pan.value();
+            const double d_tilt = tilt_cmd - current_.tilt.value();
+            // Reachable branches first, then the smallest slew
+            const double cost = (reachable ? 0.0 : 1e6) + d_pan * d_pan + d_tilt * d_tilt;
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best.angles.pan = Radians{pan_cmd};
+                best.angles.tilt = Radians{tilt_cmd};
+                best.reachable = reachable;
+            }
+        }
+        return best;
+    }
+
+private:
+    // Pan putting the optical axis, tilted by `tilt`, on the target azimuth
+    [[nodiscard]] double pan_for(double tilt, double target_azimuth) const noexcept
+    {
+        return target_azimuth - std::atan2(ay_, ax_ * std::cos(tilt) - az_ * std::sin(tilt));
+    }
+
+    // Equivalent of `pan` (mod 2 pi) nearest the current pan within the limits; clamped and false if none
+    [[nodiscard]] std::pair<double, bool> nearest_pan(double pan) const noexcept
+    {
+        const double two_pi = 2.0 * linalg3d::PI;
+        const double lo = limits_.pan_min.value();
+        const double hi = limits_.pan_max.value();
+        const double near = current_.pan.value() + std::remainder(pan - current_.pan.value(), two_pi);
+        double best = std::clamp(near, lo, hi);
+        bool found = false;
+        for (const double candidate : {near, near - two_pi, near + two_pi})
+        {
+            if (candidate >= lo && candidate <= hi &&
+                (!found || std::fabs(candidate - current_.pan.value()) < std::fabs(best - current_.pan.value())))
+            {
+                best = candidate;
+                found = true;
+            }
+        }
+        return {best, found};
+    }
+
+    Quaternion ned_to_pan_;
+    GimbalAngles current_;
+    GimbalLimits limits_;
+    double ax_{1.0}; ///< Optical axis in the tilt-joint frame
+    double ay_{};
+    double az_{};
+    double tilt_reach_{1.0}; ///< hypot(ax, az): the largest |g_z| tilting can reach
+    double tilt_offset_{};   ///< atan2(az, ax)
+};
+
+} // namespace p2b
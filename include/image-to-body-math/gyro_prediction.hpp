@@ -0,0 +1,96 @@
+#pragma once
+#include "camera.hpp"
+#include <cmath>
+
+namespace p2b
+{
+
+// ---- Gyro-rate pixel-motion prediction ----
+//
+// Over a short interval the body turns by the small rotation vector delta = rates * dt (body
+// frame). To first order a camera-frame direction d then moves by d x delta_cam, which gives the
+// pixel displacement in closed form from the pixel's own tangents: no quaternion composition, no
+// normalization. The neglected second-order term is bounded by ERROR_GAIN * |delta|^2 *
+// (1 + w^2 + h^2)^2 in tangent units (w, h the pixel tangents), with the gain fitted
+// conservatively over fields of view up to ~110 degrees and rotations up to ~10 degrees. Pixels
+// whose estimate exceeds the caller's tolerance take the exact path instead.
+
+/// Predicted displacement of a pixel (new - old, in pixels).
+struct PixelMotion
+{
+    double d_row{};
+    double d_col{};
+    double error_px{}; ///< Estimated error of the first-order prediction
+    bool exact{};      ///< True when the exact rotation was used (error_px above the tolerance)
+};
+
+class GyroPredictor
+{
+public:
+    static constexpr double ERROR_GAIN = 1.25;
+
+    GyroPredictor(const ImageSize &image_size,
+                  PixelToTan pixel_to_tan,
+                  const Quaternion &cam_to_body,
+                  double max_error_px = 0.1) noexcept
+        : image_size_{image_size}, pixel_to_tan_{pixel_to_tan}, cam_to_body_{cam_to_body}, max_error_px_{max_error_px}
+    {
+    }
+
+    /// Per-interval update from body angular rates (rad/s, body axes) held over dt seconds.
+    void set_rates(const Vector3 &body_rates, double dt) noexcept
+    {
+        const Vector3 delta_body{body_rates.x * dt, body_rates.y * dt, body_rates.z * dt};
+        delta_ = cam_to_body_.inverse() * delta_body;
+        theta_sq_ = delta_.x * delta_.x + delta_.y * delta_.y + delta_.z * delta_.z;
+
+        // Exact camera rotation old -> new: cam^-1 * exp(delta)^-1 * cam
+        const double theta = std::sqrt(theta_sq_);
+        const double half = theta / 2.0;
+        const double k = theta > 0.0 ? std::sin(half) / theta : 0.5;
+        const Quaternion step{std::cos(half), delta_body.x * k, delta_body.y * k, delta_body.z * k};
+        rotation_ = cam_to_body_.inverse() * step.inverse() * cam_to_body_;
+    }
+
+    void set_max_error(double max_error_px) noexcept
+    {
+        max_error_px_ = max_error_px;
+    }
+
+    /// Camera-frame rotation over the interval; the same quantity as Camera::rotation_to.
+    [[nodiscard]] const Quaternion &rotation() const noexcept
+    {
+        return rotation_;
+    }
+
+    /// Displacement of the (sub-pixel) position (row, col) over the interval.
+    [[nodiscard]] PixelMotion predict(double row, double col) const noexcept
+    {
+        const double ptt = pixel_to_tan_.get();
+        const double w = (row - image_size_.half_width()) * ptt;
+        const double h = (col - image_size_.half_height()) * ptt;
+        const double r2 = 1.0 + w * w + h * h;
+        const double error_px = ERROR_GAIN * theta_sq_ * r2 * r2 / ptt;
+        if (error_px > max_error_px_)
+        {
+            auto [w_new, h_new] = detail::camera_tangents(rotation_ * detail::camera_direction(w, h));
+            return PixelMotion{(w_new - w) / ptt, (h_new - h) / ptt, error_px, true};
+        }
+        // d(w, h) for d' = d + d x delta with d ~ (1, w, h * rho)
+        const double rho = std::sqrt(1.0 + w * w);
+        const double dw = h * rho * (delta_.x + w * delta_.y) - (1.0 + w * w) * delta_.z;
+        const double dh = (delta_.y - w * delta_.x) * (1.0 + h * h) / rho;
+        return PixelMotion{dw / ptt, dh / ptt, error_px, false};
+    }
+
+private:
+    ImageSize image_size_;
+    PixelToTan pixel_to_tan_;
+    Quaternion cam_to_body_;
+    double max_error_px_;
+    Vector3 delta_{};
+    double theta_sq_{};
+    Quaternion rotation_{Quaternion::identity()};
+};
+
+} // namespace p2b
@@ -0,0 +1,60 @@
+#pragma once
+#include "body_space.hpp"
+#include <cmath>
+#include <cstdint>
+
+namespace p2b
+{
+
+// ---- Attitude interpolation ----
+//
+// Both take the shorter arc (b is negated when a·b < 0) and expect unit quaternions.
+
+/// Normalized linear interpolation: cheap, constant-speed only for small angles.
+[[nodiscard]] inline Quaternion nlerp(const Quaternion &a, const Quaternion &b, double t) noexcept
+{
+    const double dot = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    const double sb = dot < 0.0 ? -t : t;
+    const double sa = 1.0 - t;
+    const double w = sa * a.w + sb * b.w;
+    const double x = sa * a.x + sb * b.x;
+    const double y = sa * a.y + sb * b.y;
+    const double z = sa * a.z + sb * b.z;
+    const double inv_n = 1.0 / std::sqrt(w * w + x * x + y * y + z * z);
+    return Quaternion{w * inv_n, x * inv_n, y * inv_n, z * inv_n};
+}
+
+/// Spherical linear interpolation: constant angular rate from a (t = 0) to b (t = 1).
+/// Falls back to nlerp only when the quaternions are parallel to rounding (angle below ~1e-6 rad),
+/// where the two agree to machine precision.
+[[nodiscard]] inline Quaternion slerp(const Quaternion &a, const Quaternion &b, double t) noexcept
+{
+    const double dot = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    const double cos_theta = std::fabs(dot);
+    if (cos_theta > 1.0 - 1e-12)
+    {
+        return nlerp(a, b, t);
+    }
+    const double theta = std::acos(cos_theta);
+    const double inv_sin = 1.0 / std::sin(theta);
+    const double sa = std::sin((1.0 - t) * theta) * inv_sin;
+    const double sb = (dot < 0.0 ? -1.0 : 1.0) * std::sin(t * theta) * inv_sin;
+    return Quaternion{sa * a.w + sb * b.w, sa * a.x + sb * b.x, sa * a.y + sb * b.y, sa * a.z + sb * b.z};
+}
+
+/// Interpolation method for attitude lookups.
+enum class Interpolation : uint8_t
+{
+    SLERP, ///< Constant angular rate
+    NLERP  ///< Cheaper; matches SLERP closely for the small steps between IMU samples
+};
+
+[[nodiscard]] inline Quaternion interpolate(const Quaternion &a,
+                                            const Quaternion &b,
+                                            double t,
+                                            Interpolation method) noexcept
+{
+    return method == Interpolation::SLERP ? slerp(a, b, t) : nlerp(a, b, t);
+}
+
+} // namespace p2b
@@ -0,0 +1,115 @@
+#pragma once
+#include "camera.hpp"
+#include <array>
+
+namespace p2b
+{
+
+// ---- Analytic Jacobians ----
+//
+// Derivatives of the continuous pixel position (row_v, col_v) — the value ned_to_pixel and
+// pixel_after_rotation truncate or round — for EKF and bundle-adjustment linearization, returned
+// together with the projection. Each Jacobian is two gradients (row_v, col_v), stored as Vector3.
+// Attitude derivatives are with respect to a body-frame small-angle error phi (radians):
+// attitude' = attitude * exp(phi), the usual error-state convention.
+
+/// Gradients d(row_v)/dx and d(col_v)/dx.
+using PixelJacobian = std::array<Vector3, 2>;
+
+/// ned_to_pixel with d(pixel)/d(dir_ned) and d(pixel)/d(attitude error).
+struct NedToPixelJacobian
+{
+    double row{};
+    double col{};
+    PixelJacobian d_dir{};
+    PixelJacobian d_attitude{};
+};
+
+/// pixel_after_rotation with d(pixel)/d(q_old error) and d(pixel)/d(q_new error).
+struct PixelAfterRotationJacobian
+{
+    double row{};
+    double col{};
+    PixelJacobian d_q_old{};
+    PixelJacobian d_q_new{};
+};
+
+namespace detail
+{
+
+[[nodiscard]] constexpr Vector3 cross(const Vector3 &a, const Vector3 &b) noexcept
+{
+    return Vector3{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+/// Gradients of the pixel position with respect to the camera-frame direction:
+/// w = y / x and h = z / hypot(x, y), scaled by 1 / pixel_to_tan.
+[[nodiscard]] inline PixelJacobian pixel_gradients_cam(const Vector3 &d, double pixel_to_tan) noexcept
+{
+    const double k = 1.0 / pixel_to_tan;
+    const double rho2 = d.x * d.x + d.y * d.y;
+    const double rho = std::sqrt(rho2);
+    const double z_rho3 = d.z / (rho2 * rho);
+    return {Vector3{-d.y / (d.x * d.x) * k, k / d.x, 0.0},
+            Vector3{-d.x * z_rho3 * k, -d.y * z_rho3 * k, k / rho}};
+}
+
+} // namespace detail
+
+/// Continuous projection of a NED direction with its Jacobians.
+[[nodiscard]] inline NedToPixelJacobian ned_to_pixel_jacobian(const Vector3 &dir_ned,
+                                                              const ImageSize &image_size,
+                                                              PixelToTan pixel_to_tan,
+                                                              const Quaternion &cam_to_body,
+                                                              const Quaternion &attitude) noexcept
+{
+    const Quaternion cam_to_ned = attitude * cam_to_body;
+    const Vector3 d_cam = cam_to_ned.inverse() * dir_ned;
+    auto [w, h] = detail::camera_tangents(d_cam);
+    const PixelJacobian g = detail::pixel_gradients_cam(d_cam, pixel_to_tan.get());
+
+    NedToPixelJacobian out;
+    out.row = w / pixel_to_tan.get() + image_size.half_width();
+    out.col = h / pixel_to_tan.get() + image_size.half_height();
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        // d_cam = M^T dir_ned                     -> g M^T       = (M g)^T
+        // d_cam' = d_cam + d_cam x (C^T phi)      -> g [d_cam]x C^T = (C (g x d_cam))^T
+        out.d_dir[i] = cam_to_ned * g[i];
+        out.d_attitude[i] = cam_to_body * detail::cross(g[i], d_cam);
+    }
+    return out;
+}
+
+/// Continuous pixel position after the body moves from q_old to q_new, with its Jacobians.
+[[nodiscard]] inline PixelAfterRotationJacobian pixel_after_rotation_jacobian(PixelIndex row,
+                                                                              PixelIndex col,
+                                                                              const ImageSize &image_size,
+                                                                              PixelToTan pixel_to_tan,
+                                                                              const Quaternion &cam_to_body,
+                                                                              const Quaternion &q_old,
+                                                                              const Quaternion &q_new) noexcept
+{
+    const double w0 = (static_cast<double>(row.value()) - image_size.half_width()) * pixel_to_tan.get();
+    const double h0 = (static_cast<double>(col.value()) - image_size.half_height()) * pixel_to_tan.get();
+    const Vector3 d_body_old = cam_to_body * detail::camera_direction(w0, h0);
+    const Quaternion old_to_new = q_new.inverse() * q_old; // body frame at q_old -> at q_new
+    const Vector3 d_cam = cam_to_body.inverse() * (old_to_new * d_body_old);
+    auto [w, h] = detail::camera_tangents(d_cam);
+    const PixelJacobian g = detail::pixel_gradients_cam(d_cam, pixel_to_tan.get());
+
+    PixelAfterRotationJacobian out;
+    out.row = w / pixel_to_tan.get() + image_size.half_width();
+    out.col = h / pixel_to_tan.get() + image_size.half_height();
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        // q_new error: as for ned_to_pixel. q_old error: d_cam' = C^T R (d_b + phi x d_b), so
+        // g C^T R (-[d_b]x) = (d_b x k)^T with k = R^T C g.
+        const Vector3 k = old_to_new.inverse() * (cam_to_body * g[i]);
+        out.d_q_new[i] = cam_to_body * detail::cross(g[i], d_cam);
+        out.d_q_old[i] = detail::cross(d_body_old, k);
+    }
+    return out;
+}
+
+} // namespace p2b
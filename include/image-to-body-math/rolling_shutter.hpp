@@ -0,0 +1,166 @@
+#pragma once
+#include "camera.hpp"
+#include "interpolation.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace p2b
+{
+
+// ---- Rolling-shutter camera ----
+//
+// A CMOS sensor reads the frame out one line at a time, so each line sees a different attitude.
+// Readout lines run along the width, i.e. a line is a fixed `col` (the height index), read from
+// col = 0 to col = height - 1. The attitude of every line is interpolated (slerp) once in
+// set_attitudes and kept as composed camera <-> NED rotations, so a projection costs the same as
+// Camera: one table lookup plus one quaternion rotation. ned_to_pixel has to find the line the
+// direction lands on and iterates (two or three lookups for realistic body rates).
+
+class RollingShutterCamera
+{
+public:
+    RollingShutterCamera(const ImageSize &image_size, PixelToTan pixel_to_tan, const Quaternion &cam_to_body)
+        : image_size_{image_size}, pixel_to_tan_{pixel_to_tan}, cam_to_body_{cam_to_body},
+          body_to_cam_{cam_to_body.inverse()}, cam_to_ned_(std::max<uint64_t>(image_size.height, 1), cam_to_body),
+          ned_to_cam_(cam_to_ned_.size(), body_to_cam_)
+    {
+    }
+
+    /// Per-frame update from the attitudes at which the first and the last line are read.
+    void set_attitudes(const Quaternion &first_line, const Quaternion &last_line) noexcept
+    {
+        const double last = static_cast<double>(cam_to_ned_.size() - 1);
+        for (std::size_t line = 0; line < cam_to_ned_.size(); ++line)
+        {
+            const double t = last > 0.0 ? static_cast<double>(line) / last : 0.0;
+            set_line(line, slerp(first_line, last_line, t));
+        }
+    }
+
+    /// Per-frame update from an attitude series: samples[k] is the attitude `k * sample_interval`
+    /// after the first line is read, and the last line is read `readout_time` after the first.
+    /// Lines outside the series take the nearest sample.
+    void set_attitudes(std::span<const Quaternion> samples, double sample_interval, double readout_time) noexcept
+    {
+        if (samples.empty())
+        {
+            return;
+        }
+        const double last = static_cast<double>(cam_to_ned_.size() - 1);
+        const double last_sample = static_cast<double>(samples.size() - 1);
+        for (std::size_t line = 0; line < cam_to_ned_.size(); ++line)
+        {
+            const double t = last > 0.0 ? readout_time * static_cast<double>(line) / last : 0.0;
+            const double pos = std::clamp(sample_interval > 0.0 ? t / sample_interval : 0.0, 0.0, last_sample);
+            const auto k = std::min(static_cast<std::size_t>(pos), samples.size() > 1 ? samples.size() - 2 : 0);
+            set_line(line, samples.size() > 1 ? slerp(samples[k], samples[k + 1], pos - static_cast<double>(k))
+                                              : samples[0]);
+        }
+    }
+
+    [[nodiscard]] const ImageSize &image_size() const noexcept
+    {
+        return image_size_;
+    }
+
+    [[nodiscard]] PixelToTan pixel_to_tan() const noexcept
+    {
+        return pixel_to_tan_;
+    }
+
+    [[nodiscard]] const Quaternion &cam_to_body() const noexcept
+    {
+        return cam_to_body_;
+    }
+
+    /// Interpolated body attitude of a readout line (clamped to the frame).
+    [[nodiscard]] Quaternion line_attitude(PixelIndex col) const noexcept
+    {
+        return cam_to_ned_[line_of(col)] * body_to_cam_;
+    }
+
+    /// Pixel -> NED direction at the attitude of the pixel's readout line.
+    [[nodiscard]] Vector3 pixel_to_ned(PixelIndex row, PixelIndex col) const noexcept
+    {
+        return cam_to_ned_[line_of(col)] * detail::camera_direction(w_tan(row), h_tan(col));
+    }
+
+    /// NED direction -> pixel (truncated) on the readout line it is seen from.
+    [[nodiscard]] std::pair<PixelIndex, PixelIndex> ned_to_pixel(const Vector3 &dir_ned) const noexcept
+    {
+        return project(dir_ned, false);
+    }
+
+    /// Pixel position in `next` (typically the following frame) of the direction seen at (row, col)
+    /// in this one. Both frames use their own per-line attitudes.
+    [[nodiscard]] std::pair<PixelIndex, PixelIndex> pixel_after_rotation(PixelIndex row,
+                                                                         PixelIndex col,
+                                                                         const RollingShutterCamera &next,
+                                                                         bool round_back = false) const noexcept
+    {
+        return next.project(pixel_to_ned(row, col), round_back, line_of(col));
+    }
+
+private:
+    // The direction's line is not known before projecting: start from the hinted line (the middle
+    // one without a hint), re-project on the line the result falls on, and stop when the line no
+    // longer changes.
+    [[nodiscard]] std::pair<PixelIndex, PixelIndex> project(const Vector3 &dir_ned,
+                                                            bool round_back,
+                                                            std::size_t line = SIZE_MAX) const noexcept
+    {
+        constexpr int MAX_ITERATIONS = 4;
+        const double max_line = static_cast<double>(cam_to_ned_.size() - 1);
+        line = line == SIZE_MAX ? cam_to_ned_.size() / 2 : std::min(line, cam_to_ned_.size() - 1);
+        double row_v = 0.0;
+        double col_v = 0.0;
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+        {
+            auto [w, h] = detail::camera_tangents(ned_to_cam_[line] * dir_ned);
+            row_v = w / pixel_to_tan_.get() + image_size_.half_width();
+            col_v = h / pixel_to_tan_.get() + image_size_.half_height();
+            const auto next_line = static_cast<std::size_t>(std::clamp(col_v, 0.0, max_line));
+            if (next_line == line)
+            {
+                break;
+            }
+            line = next_line;
+        }
+        return round_back ? std::pair{pixel_from_rounded(row_v), pixel_from_rounded(col_v)}
+                          : std::pair{pixel_from_truncated(row_v), pixel_from_truncated(col_v)};
+    }
+
+    void set_line(std::size_t line, const Quaternion &attitude) noexcept
+    {
+        cam_to_ned_[line] = attitude * cam_to_body_;
+        ned_to_cam_[line] = cam_to_ned_[line].inverse();
+    }
+
+    [[nodiscard]] std::size_t line_of(PixelIndex col) const noexcept
+    {
+        return static_cast<std::size_t>(std::min<uint64_t>(col.value(), cam_to_ned_.size() - 1));
+    }
+
+    [[nodiscard]] double w_tan(PixelIndex row) const noexcept
+    {
+        return (static_cast<double>(row.value()) - image_size_.half_width()) * pixel_to_tan_.get();
+    }
+
+    [[nodiscard]] double h_tan(PixelIndex col) const noexcept
+    {
+        return (static_cast<double>(col.value()) - image_size_.half_height()) * pixel_to_tan_.get();
+    }
+
+    ImageSize image_size_;
+    PixelToTan pixel_to_tan_;
+    Quaternion cam_to_body_;
+    Quaternion body_to_cam_;
+    std::vector<Quaternion> cam_to_ned_; // one per readout line
+    std::vector<Quaternion> ned_to_cam_;
+};
+
+} // namespace p2b
@@ -0,0 +1,204 @@
+#pragma once
+#include "camera.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+namespace p2b
+{
+
+// ---- Rotation from correspondences (Wahba's problem) ----
+//
+// The inverse of pixel_after_rotation: given directions seen before and after a rotation, find the
+// rotation R minimizing sum w_i |to_i - R from_i|^2. The pairs are folded into a 3x3 correlation
+// matrix in one pass; R is then the dominant eigenvector of a symmetric 4x4 matrix built from it
+// (Horn's closed form, equivalent to the SVD/Kabsch solution but with no reflection case to
+// repair), found with a few Jacobi sweeps. The cost is O(N) plus a constant, and the accumulator
+// can be reused to refit inlier subsets without touching the pixels again.
+
+namespace detail
+{
+
+/// Unit eigenvector of the largest eigenvalue of a symmetric 4x4 matrix (cyclic Jacobi).
+[[nodiscard]] inline std::array<double, 4> dominant_eigenvector(std::array<std::array<double, 4>, 4> a) noexcept
+{
+    std::array<std::array<double, 4>, 4> v{};
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        v[i][i] = 1.0;
+    }
+    for (int sweep = 0; sweep < 16; ++sweep)
+    {
+        double off = 0.0;
+        double diag = 0.0;
+        for (std::size_t p = 0; p < 4; ++p)
+        {
+            diag += a[p][p] * a[p][p];
+            for (std::size_t q = p + 1; q < 4; ++q)
+            {
+                off += a[p][q] * a[p][q];
+            }
+        }
+        if (off <= 1e-30 * diag || off == 0.0)
+        {
+            break;
+        }
+        for (std::size_t p = 0; p < 3; ++p)
+        {
+            for (std::size_t q = p + 1; q < 4; ++q)
+            {
+                if (a[p][q] == 0.0)
+                {
+                    continue;
+                }
+                const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                const double t = std::copysign(1.0, theta) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    const double akp = a[k][p];
+                    const double akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    const double apk = a[p][k];
+                    const double aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    const double vkp = v[k][p];
+                    const double vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < 4; ++i)
+    {
+        if (a[i][i] > a[best][best])
+        {
+            best = i;
+        }
+    }
+    return {v[0][best], v[1][best], v[2][best], v[3][best]};
+}
+
+} // namespace detail
+
+/// Weighted direction pairs folded into the correlation matrix of Wahba's problem.
+class WahbaSolver
+{
+public:
+    /// Add a pair: `to` is `from` after the rotation. Directions need not be unit; each pair
+    /// effectively weighs weight * |from| * |to|.
+    void add(const Vector3 &from, const Vector3 &to, double weight = 1.0) noexcept
+    {
+        const std::array<double, 3> f{from.x * weight, from.y * weight, from.z * weight};
+        const std::array<double, 3> t{to.x, to.y, to.z};
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                s_[i][j] += f[i] * t[j];
+            }
+        }
+        ++size_;
+    }
+
+    void clear() noexcept
+    {
+        s_ = {};
+        size_ = 0;
+    }
+
+    /// Number of pairs added since construction or clear().
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// Rotation R (unit, w >= 0) taking `from` directions onto `to` directions. Needs at least
+    /// two non-parallel pairs; otherwise the result is one of the many exact fits.
+    [[nodiscard]] Quaternion solve() const noexcept
+    {
+        const auto &s = s_; // s[i][j] = sum w from_i to_j, axes 0..2 = x, y, z
+        const std::array<std::array<double, 4>, 4> n{{
+            {s[0][0] + s[1][1] + s[2][2], s[1][2] - s[2][1], s[2][0] - s[0][2], s[0][1] - s[1][0]},
+            {s[1][2] - s[2][1], s[0][0] - s[1][1] - s[2][2], s[0][1] + s[1][0], s[2][0] + s[0][2]},
+            {s[2][0] - s[0][2], s[0][1] + s[1][0], -s[0][0] + s[1][1] - s[2][2], s[1][2] + s[2][1]},
+            {s[0][1] - s[1][0], s[2][0] + s[0][2], s[1][2] + s[2][1], -s[0][0] - s[1][1] + s[2][2]},
+        }};
+        const auto q = detail::dominant_eigenvector(n);
+        const double sign = q[0] < 0.0 ? -1.0 : 1.0;
+        const double inv_n = sign / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        return Quaternion{q[0] * inv_n, q[1] * inv_n, q[2] * inv_n, q[3] * inv_n};
+    }
+
+private:
+    std::array<std::array<double, 3>, 3> s_{};
+    std::size_t size_{};
+};
+
+/// Least-squares rotation taking from[i] onto to[i] (optionally weighted; weights may be empty).
+[[nodiscard]] inline Quaternion estimate_rotation(std::span<const Vector3> from,
+                                                  std::span<const Vector3> to,
+                                                  std::span<const double> weights = {}) noexcept
+{
+    WahbaSolver solver;
+    const std::size_t n = std::min(from.size(), to.size());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        solver.add(from[i], to[i], i < weights.size() ? weights[i] : 1.0);
+    }
+    return solver.solve();
+}
+
+/// Camera-frame unit direction of a sub-pixel position (row, col).
+[[nodiscard]] inline Vector3 subpixel_direction(double row,
+                                                double col,
+                                                const ImageSize &image_size,
+                                                PixelToTan pixel_to_tan) noexcept
+{
+    return detail::camera_direction((row - image_size.half_width()) * pixel_to_tan.get(),
+                                    (col - image_size.half_height()) * pixel_to_tan.get());
+}
+
+/// Camera-frame rotation between two frames from matched (row, col) positions: pixels_a[i] in
+/// the first frame shows the same direction as pixels_b[i] in the second. The result is the
+/// quantity Camera::rotation_to returns, so it feeds Camera::pixel_after_rotation directly.
+[[nodiscard]] inline Quaternion estimate_rotation_from_pixels(std::span<const std::array<double, 2>> pixels_a,
+                                                              std::span<const std::array<double, 2>> pixels_b,
+                                                              const ImageSize &image_size,
+                                                              PixelToTan pixel_to_tan,
+                                                              std::span<const double> weights = {}) noexcept
+{
+    WahbaSolver solver;
+    const std::size_t n = std::min(pixels_a.size(), pixels_b.size());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        solver.add(subpixel_direction(pixels_a[i][0], pixels_a[i][1], image_size, pixel_to_tan),
+                   subpixel_direction(pixels_b[i][0], pixels_b[i][1], image_size, pixel_to_tan),
+                   i < weights.size() ? weights[i] : 1.0);
+    }
+    return solver.solve();
+}
+
+/// Body attitude after a measured camera-frame rotation (see Camera::rotation_to):
+/// q_new = q_old * cam_to_body * rotation^-1 * cam_to_body^-1.
+[[nodiscard]] inline Quaternion attitude_after_rotation(const Quaternion &q_old,
+                                                        const Quaternion &cam_to_body,
+                                                        const Quaternion &rotation) noexcept
+{
+    return q_old * cam_to_body * rotation.inverse() * cam_to_body.inverse();
+}
+
+} // namespace p2b
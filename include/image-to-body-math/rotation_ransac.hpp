@@ -0,0 +1,279 @@
+#pragma once
+#include "rotation_estimation.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace p2b
+{
+
+// ---- Robust rotation from correspondences (RANSAC) ----
+//
+// Rotation-only RANSAC over matched pixels: two matches fix a rotation, so hypotheses come from
+// 2-point samples solved with WahbaSolver. Every hypothesis is scored against all matches with a
+// truncated-quadratic (MSAC) cost on the reprojection error in pixels. Scoring maps each ray
+// through the rotation homography (u, v) = (y / x, z / x) and scales the v error by the match's
+// own 1 / sqrt(1 + w^2): exact in the row axis, first-order in the col axis, and free of square
+// roots. With no branches or calls left, the loop over the structure-of-arrays buffers
+// vectorizes; the buffers live in the estimator and are reused from frame to frame. The
+// iteration count adapts to the best inlier ratio found so far, and the winner is refit by least
+// squares over its inliers.
+
+struct RansacOptions
+{
+    double threshold_px = 1.0;       ///< Inlier reprojection error (pixels)
+    std::size_t max_iterations = 256; ///< Upper bound on hypotheses
+    double confidence = 0.999;        ///< Stop once an outlier-free sample is this likely to have been drawn
+    uint64_t seed = 0;                ///< Sampling seed: equal inputs and seed give equal results
+};
+
+struct RotationRansacResult
+{
+    Quaternion rotation{Quaternion::identity()}; ///< Least-squares refit over the inliers
+    std::size_t inliers{};                       ///< Matches within threshold_px of the refit rotation
+    std::size_t iterations{};                    ///< Hypotheses drawn
+    bool success{};                              ///< False without two well-separated matches agreeing
+};
+
+namespace detail
+{
+
+/// Row-major rotation matrix of a unit quaternion.
+[[nodiscard]] constexpr std::array<double, 9> rotation_matrix(const Quaternion &q) noexcept
+{
+    const double xx = q.x * q.x;
+    const double yy = q.y * q.y;
+    const double zz = q.z * q.z;
+    const double xy = q.x * q.y;
+    const double xz = q.x * q.z;
+    const double yz = q.y * q.z;
+    const double wx = q.w * q.x;
+    const double wy = q.w * q.y;
+    const double wz = q.w * q.z;
+    return {1.0 - 2.0 * (yy + zz), 2.0 * (xy - wz),       2.0 * (xz + wy),
+            2.0 * (xy + wz),       1.0 - 2.0 * (xx + zz), 2.0 * (yz - wx),
+            2.0 * (xz - wy),       2.0 * (yz + wx),       1.0 - 2.0 * (xx + yy)};
+}
+
+} // namespace detail
+
+class RotationRansac
+{
+public:
+    RotationRansac(const ImageSize &image_size, PixelToTan pixel_to_tan) noexcept
+        : image_size_{image_size}, pixel_to_tan_{pixel_to_tan}
+    {
+    }
+
+    /// Camera-frame rotation taking pixels_a[i] onto pixels_b[i] for the inlier matches (see
+    /// estimate_rotation_from_pixels), robust to outliers.
+    RotationRansacResult estimate(std::span<const std::array<double, 2>> pixels_a,
+                                  std::span<const std::array<double, 2>> pixels_b,
+                                  const RansacOptions &options = {})
+    {
+        load(pixels_a, pixels_b);
+        const std::size_t n = ax_.size();
+        RotationRansacResult result;
+        if (n < 2)
+        {
+            std::fill(inlier_.begin(), inlier_.end(), uint8_t{0});
+            return result;
+        }
+
+        const double tan_threshold = options.threshold_px * pixel_to_tan_.get();
+        const double t2 = tan_threshold * tan_threshold;
+        // Two matches closer than a few pixels on the sphere fix the rotation poorly
+        const double min_sin = 4.0 * tan_threshold;
+        std::mt19937_64 rng(options.seed);
+
+        double best_cost = static_cast<double>(n) * t2 + 1.0;
+        Quaternion best{Quaternion::identity()};
+        bool found = false;
+        std::size_t needed = options.max_iterations;
+        while (result.iterations < std::min(needed, options.max_iterations))
+        {
+            ++result.iterations;
+            const std::size_t i = rng() % n;
+            const std::size_t j = rng() % (n - 1);
+            const std::size_t k = j < i ? j : j + 1;
+            const Vector3 a_i{ax_[i], ay_[i], az_[i]};
+            const Vector3 a_k{ax_[k], ay_[k], az_[k]};
+            const double cos_ik = a_i.x * a_k.x + a_i.y * a_k.y + a_i.z * a_k.z;
+            if (1.0 - cos_ik * cos_ik < min_sin * min_sin)
+            {
+                continue;
+            }
+            WahbaSolver sample;
+            sample.add(a_i, b_direction(i));
+            sample.add(a_k, b_direction(k));
+            const Quaternion hypothesis = sample.solve();
+            residuals(hypothesis, t2);
+            const double cost = msac_cost(t2);
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best = hypothesis;
+                found = true;
+                needed = required_iterations(count_inliers(t2), n, options.confidence);
+            }
+        }
+
+        if (!found) // every sample degenerate: matches too close together
+        {
+            std::fill(inlier_.begin(), inlier_.end(), uint8_t{0});
+            return result;
+        }
+
+        // Least-squares refit over the inliers of the best hypothesis, then final classification
+        residuals(best, t2);
+        WahbaSolver refit;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (err2_[i] < t2)
+            {
+                refit.add(Vector3{ax_[i], ay_[i], az_[i]}, b_direction(i));
+            }
+        }
+        if (refit.size() >= 2)
+        {
+            best = refit.solve();
+        }
+        residuals(best, t2);
+        result.rotation = best;
+        result.inliers = count_inliers(t2);
+        result.success = result.inliers >= 2;
+        return result;
+    }
+
+    /// Per-match inlier flags (1 = inlier) of the last estimate, in input order.
+    [[nodiscard]] std::span<const uint8_t> inlier_mask() const noexcept
+    {
+        return inlier_;
+    }
+
+private:
+    // Unit rays of pixels_a (SoA); pinhole coordinates and col-error scale of pixels_b
+    void load(std::span<const std::array<double, 2>> pixels_a, std::span<const std::array<double, 2>> pixels_b)
+    {
+        const std::size_t n = std::min(pixels_a.size(), pixels_b.size());
+        for (auto *v : {&ax_, &ay_, &az_, &bu_, &bv_, &b_inv_rho_, &err2_})
+        {
+            v->resize(n);
+        }
+        inlier_.resize(n);
+        const double ptt = pixel_to_tan_.get();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Vector3 a = subpixel_direction(pixels_a[i][0], pixels_a[i][1], image_size_, pixel_to_tan_);
+            ax_[i] = a.x;
+            ay_[i] = a.y;
+            az_[i] = a.z;
+            const double w = (pixels_b[i][0] - image_size_.half_width()) * ptt;
+            const double h = (pixels_b[i][1] - image_size_.half_height()) * ptt;
+            const double rho = std::sqrt(1.0 + w * w);
+            bu_[i] = w;
+            bv_[i] = h * rho;
+            b_inv_rho_[i] = 1.0 / rho;
+        }
+    }
+
+    [[nodiscard]] Vector3 b_direction(std::size_t i) const noexcept
+    {
+        return detail::camera_direction(bu_[i], bv_[i] * b_inv_rho_[i]);
+    }
+
+    // Squared tangent errors of a hypothesis into err2_ (always above t2 for points that rotate
+    // behind the camera). Pixel error = tangent error / pixel_to_tan in both axes; h = v / sqrt(1 + w^2).
+    void residuals(const Quaternion &rotation, double t2) noexcept
+    {
+        const auto m = detail::rotation_matrix(rotation);
+        const std::size_t n = ax_.size();
+        const double *ax = ax_.data();
+        const double *ay = ay_.data();
+        const double *az = az_.data();
+        const double *bu = bu_.data();
+        const double *bv = bv_.data();
+        const double *b_inv_rho = b_inv_rho_.data();
+        double *err2 = err2_.data();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double x = m[0] * ax[i] + m[1] * ay[i] + m[2] * az[i];
+            const double y = m[3] * ax[i] + m[4] * ay[i] + m[5] * az[i];
+            const double z = m[6] * ax[i] + m[7] * ay[i] + m[8] * az[i];
+            const double inv_x = 1.0 / x;
+            const double ew = y * inv_x - bu[i];
+            const double eh = (z * inv_x - bv[i]) * b_inv_rho[i];
+            const double e2 = ew * ew + eh * eh;
+            err2[i] = e2 + (t2 - std::copysign(t2, x)); // + 2 t2 behind the camera, without a compare
+        }
+    }
+
+    // Truncated-quadratic cost of err2_
+    [[nodiscard]] double msac_cost(double t2) const noexcept
+    {
+        const std::size_t n = err2_.size();
+        const double *err2 = err2_.data();
+        // Four independent partial sums keep the reduction vectorizable without -ffast-math
+        std::array<double, 4> acc{};
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            for (std::size_t lane = 0; lane < 4; ++lane)
+            {
+                acc[lane] += std::min(t2, err2[i + lane]); // t2 for NaN too
+            }
+        }
+        for (; i < n; ++i)
+        {
+            acc[0] += std::min(t2, err2[i]);
+        }
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+
+    // Inlier flags and count from err2_
+    std::size_t count_inliers(double t2) noexcept
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < err2_.size(); ++i)
+        {
+            inlier_[i] = static_cast<uint8_t>(err2_[i] < t2);
+            count += inlier_[i];
+        }
+        return count;
+    }
+
+    // Hypotheses needed to draw one all-inlier 2-point sample with the given confidence
+    [[nodiscard]] static std::size_t required_iterations(std::size_t inliers, std::size_t n, double confidence) noexcept
+    {
+        const double ratio = static_cast<double>(inliers) / static_cast<double>(n);
+        const double p_good = ratio * ratio;
+        if (p_good >= 1.0)
+        {
+            return 1;
+        }
+        if (p_good <= 0.0)
+        {
+            return SIZE_MAX;
+        }
+        const double k = std::ceil(std::log(1.0 - confidence) / std::log(1.0 - p_good));
+        return k < 1e9 ? static_cast<std::size_t>(std::max(k, 1.0)) : SIZE_MAX;
+    }
+
+    ImageSize image_size_;
+    PixelToTan pixel_to_tan_;
+    std::vector<double> ax_;
+    std::vector<double> ay_;
+    std::vector<double> az_;
+    std::vector<double> bu_;
+    std::vector<double> bv_;
+    std::vector<double> b_inv_rho_;
+    std::vector<double> err2_;
+    std::vector<uint8_t> inlier_;
+};
+
+} // namespace p2b
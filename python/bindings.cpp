@@ -1,20 +1,45 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
 #include <nanobind/stl/pair.h>
+#include <nanobind/stl/tuple.h>
 
+#include <memory>
+#include <optional>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
+#include "image-to-body-math/attitude_buffer.hpp"
 #include "image-to-body-math/body_space.hpp"
+#include "image-to-body-math/calibration.hpp"
+#include "image-to-body-math/camera.hpp"
+#include "image-to-body-math/elevation_contour.hpp"
+#include "image-to-body-math/elevation_mask.hpp"
+#include "image-to-body-math/gimbal.hpp"
+#include "image-to-body-math/gyro_prediction.hpp"
+#include "image-to-body-math/jacobians.hpp"
 #include "image-to-body-math/math.hpp"
+#include "image-to-body-math/rolling_shutter.hpp"
+#include "image-to-body-math/rotation_estimation.hpp"
+#include "image-to-body-math/rotation_ransac.hpp"
 
 namespace nb = nanobind;
 using namespace nb::literals;
 
 using Vec3In = nb::ndarray<const double, nb::shape<3>, nb::c_contig, nb::device::cpu>;
 using QuatIn = nb::ndarray<const double, nb::shape<4>, nb::c_contig, nb::device::cpu>;
-using U64_1D = nb::ndarray<const uint64_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
-using F64_1D = nb::ndarray<const double, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
-using F64_2D = nb::ndarray<const double, nb::ndim<2>, nb::c_contig, nb::device::cpu>;
+// Batch inputs: any strides (column slices, interleaved pairs) are read in place.
+// Pixel indices accept uint16/int32/uint32/int64/uint64 and are dispatched on dtype at runtime.
+using IndexIn = nb::ndarray<nb::ro, nb::device::cpu>;
+using F64_1D = nb::ndarray<const double, nb::ndim<1>, nb::device::cpu>;
+using F64_2D = nb::ndarray<const double, nb::ndim<2>, nb::device::cpu>;
+
+// Fast scalar convention: plain Python floats / tuples in and out, no ndarray round-trip
+using Vec3T = std::tuple<double, double, double>;
+using QuatT = std::tuple<double, double, double, double>;
+using PixelT = std::pair<uint64_t, uint64_t>;
 
 // ---- Zero-copy helpers ----
 
@@ -30,6 +55,26 @@ static p2b::Vector3 to_vec3(Vec3In a)
     return p2b::Vector3{d[0], d[1], d[2]};
 }
 
+static p2b::Quaternion to_quat(const QuatT &q)
+{
+    return p2b::Quaternion{std::get<0>(q), std::get<1>(q), std::get<2>(q), std::get<3>(q)};
+}
+
+static p2b::Vector3 to_vec3(const Vec3T &v)
+{
+    return p2b::Vector3{std::get<0>(v), std::get<1>(v), std::get<2>(v)};
+}
+
+static Vec3T to_tuple(const p2b::Vector3 &v)
+{
+    return {v.x, v.y, v.z};
+}
+
+static PixelT to_tuple(const std::pair<p2b::PixelIndex, p2b::PixelIndex> &px)
+{
+    return {px.first.value(), px.second.value()};
+}
+
 static auto make_vec3(const p2b::Vector3 &v)
 {
     auto *data = new double[3]{v.x, v.y, v.z};
@@ -37,6 +82,219 @@ static auto make_vec3(const p2b::Vector3 &v)
     return nb::ndarray<nb::numpy, double, nb::shape<3>>(data, {3}, owner);
 }
 
+// Contour crossings are written as std::pair<double, double> into an (N,2) float64 buffer
+static_assert(sizeof(std::pair<double, double>) == 2 * sizeof(double));
+
+static std::span<std::pair<double, double>> as_crossings(double *data, size_t n)
+{
+    return {reinterpret_cast<std::pair<double, double> *>(data), n};
+}
+
+// ---- Batch helpers ----
+
+// Heap buffer owned by a capsule, exposed as an (n,) array
+template <typename T>
+static auto batch_output(T *data, size_t n)
+{
+    nb::capsule owner(data, [](void *p) noexcept { delete[] static_cast<T *>(p); });
+    size_t shape[1] = {n};
+    return nb::ndarray<nb::numpy, T>(data, 1, shape, owner);
+}
+
+// Heap buffer owned by a capsule, exposed as an (n, cols) array
+template <typename T>
+static auto batch_output(T *data, size_t n, size_t cols)
+{
+    nb::capsule owner(data, [](void *p) noexcept { delete[] static_cast<T *>(p); });
+    size_t shape[2] = {n, cols};
+    return nb::ndarray<nb::numpy, T>(data, 2, shape, owner);
+}
+
+// Heap buffer owned by a capsule, exposed as an (m, n, cols) array
+template <typename T>
+static auto batch_output(T *data, size_t m, size_t n, size_t cols)
+{
+    nb::capsule owner(data, [](void *p) noexcept { delete[] static_cast<T *>(p); });
+    size_t shape[3] = {m, n, cols};
+    return nb::ndarray<nb::numpy, T>(data, 3, shape, owner);
+}
+
+// Same, for a buffer held by a unique_ptr until the capsule takes it over
+template <typename T, typename... Extents>
+static auto batch_output(std::unique_ptr<T[]> data, Extents... extents)
+{
+    return batch_output(data.release(), extents...);
+}
+
+// Writes a PixelJacobian as a row-major 2x3 block
+static void write_jacobian(double *out, const p2b::PixelJacobian &j)
+{
+    for (size_t i = 0; i < 2; ++i)
+    {
+        out[i * 3] = j[i].x;
+        out[i * 3 + 1] = j[i].y;
+        out[i * 3 + 2] = j[i].z;
+    }
+}
+
+static void require_same_length(size_t a, size_t b, const char *names)
+{
+    if (a != b)
+        throw std::invalid_argument(std::string(names) + " must have same length");
+}
+
+// ---- Strided input views ----
+
+// One strided column of an input array; Out is the element type handed to the kernel
+template <typename T, typename Out = T>
+struct Column
+{
+    const T *data;
+    int64_t stride; // in elements
+
+    Out operator[](size_t i) const noexcept
+    {
+        return static_cast<Out>(data[static_cast<int64_t>(i) * stride]);
+    }
+};
+
+static Column<double> f64_column(const F64_1D &a)
+{
+    return {a.data(), a.stride(0)};
+}
+
+// (N,3) rows of any layout, read as Vector3 (x, y, z)
+struct Vec3Rows
+{
+    const double *data;
+    int64_t row_stride;
+    int64_t col_stride;
+
+    p2b::Vector3 operator[](size_t i) const noexcept
+    {
+        const double *p = data + static_cast<int64_t>(i) * row_stride;
+        return p2b::Vector3{p[0], p[col_stride], p[2 * col_stride]};
+    }
+};
+
+static Vec3Rows vec3_rows(const F64_2D &a, const char *name)
+{
+    if (a.shape(1) != 3)
+        throw std::invalid_argument(std::string(name) + " must have shape (N, 3)");
+    return {a.data(), a.stride(0), a.stride(1)};
+}
+
+// A (pan, tilt, roll) row read through vec3_rows
+static p2b::GimbalAngles to_gimbal_angles(const p2b::Vector3 &row)
+{
+    return {p2b::Radians{row.x}, p2b::Radians{row.y}, p2b::Radians{row.z}};
+}
+
+static p2b::GimbalLimits to_gimbal_limits(double pan_min, double pan_max, double tilt_min, double tilt_max)
+{
+    if (!(pan_min <= pan_max) || !(tilt_min <= tilt_max))
+        throw std::invalid_argument("gimbal limits must be ordered (min <= max)");
+    return {p2b::Radians{pan_min}, p2b::Radians{pan_max}, p2b::Radians{tilt_min}, p2b::Radians{tilt_max}};
+}
+
+// (N,4) quaternion rows [w, x, y, z] of any layout; a stride-0 broadcast repeats one quaternion
+struct QuatRows
+{
+    const double *data;
+    int64_t row_stride;
+    int64_t col_stride;
+
+    p2b::Quaternion operator[](size_t i) const noexcept
+    {
+        const double *p = data + static_cast<int64_t>(i) * row_stride;
+        return p2b::Quaternion{p[0], p[col_stride], p[2 * col_stride], p[3 * col_stride]};
+    }
+};
+
+static QuatRows quat_rows(const F64_2D &a, const char *name)
+{
+    if (a.shape(1) != 4)
+        throw std::invalid_argument(std::string(name) + " must have shape (M, 4)");
+    return {a.data(), a.stride(0), a.stride(1)};
+}
+
+static QuatRows quat_rows(const F64_2D &a, size_t n, const char *name)
+{
+    if (a.shape(0) != n || a.shape(1) != 4)
+        throw std::invalid_argument(std::string(name) + " must have shape (N, 4) matching the points");
+    return {a.data(), a.stride(0), a.stride(1)};
+}
+
+// Calls f(std::type_identity<T>{}) for the index element type T of dtype dt
+template <typename F>
+static void visit_index_dtype(nb::dlpack::dtype dt, F &&f)
+{
+    if (dt == nb::dtype<uint64_t>())
+        f(std::type_identity<uint64_t>{});
+    else if (dt == nb::dtype<int64_t>())
+        f(std::type_identity<int64_t>{});
+    else if (dt == nb::dtype<uint32_t>())
+        f(std::type_identity<uint32_t>{});
+    else if (dt == nb::dtype<int32_t>())
+        f(std::type_identity<int32_t>{});
+    else if (dt == nb::dtype<uint16_t>())
+        f(std::type_identity<uint16_t>{});
+    else
+        throw std::invalid_argument("pixel indices must be uint16, int32, uint32, int64 or uint64");
+}
+
+// Pixel indices of one dtype read in place. Validated on construction, so kernels
+// can allocate their output before visiting.
+struct IndexColumns
+{
+    nb::dlpack::dtype dtype;
+    const void *first;
+    const void *second; // null for a single column
+    int64_t first_stride;
+    int64_t second_stride;
+    size_t n;
+
+    template <typename F>
+    void visit(F &&f) const
+    {
+        visit_index_dtype(dtype,
+                          [&]<typename T>(std::type_identity<T>)
+                          {
+                              f(Column<T, uint64_t>{static_cast<const T *>(first), first_stride},
+                                Column<T, uint64_t>{static_cast<const T *>(second), second_stride});
+                          });
+    }
+};
+
+static IndexColumns index_column(const IndexIn &a, const char *name)
+{
+    if (a.ndim() != 1)
+        throw std::invalid_argument(std::string(name) + " must be 1-D");
+    visit_index_dtype(a.dtype(), [](auto) {});
+    return {a.dtype(), a.data(), nullptr, a.stride(0), 0, a.shape(0)};
+}
+
+// (rows, cols) as two 1-D arrays of the same dtype, or rows as an (N,2) array with cols None
+static IndexColumns pixel_pairs(const IndexIn &rows, const std::optional<IndexIn> &cols)
+{
+    if (!cols)
+    {
+        if (rows.ndim() != 2 || rows.shape(1) != 2)
+            throw std::invalid_argument("pixels must have shape (N, 2) when cols is None");
+        visit_index_dtype(rows.dtype(), [](auto) {});
+        const auto *base = static_cast<const char *>(rows.data());
+        return {rows.dtype(), base, base + rows.stride(1) * (rows.dtype().bits / 8), rows.stride(0), rows.stride(0),
+                rows.shape(0)};
+    }
+    if (rows.ndim() != 1 || cols->ndim() != 1)
+        throw std::invalid_argument("rows and cols must be 1-D");
+    require_same_length(cols->shape(0), rows.shape(0), "rows and cols");
+    if (!(rows.dtype() == cols->dtype()))
+        throw std::invalid_argument("rows and cols must have the same dtype");
+    visit_index_dtype(rows.dtype(), [](auto) {});
+    return {rows.dtype(), rows.data(), cols->data(), rows.stride(0), cols->stride(0), rows.shape(0)};
+}
+
 static auto make_quat(const p2b::Quaternion &q)
 {
     auto *data = new double[4]{q.w, q.x, q.y, q.z};
@@ -59,6 +317,10 @@ NB_MODULE(_core, m)
              [](const p2b::ImageSize &s)
              { return "ImageSize(width=" + std::to_string(s.width) + ", height=" + std::to_string(s.height) + ")"; });
 
+    nb::enum_<p2b::MaskSide>(m, "MaskSide")
+        .value("ABOVE", p2b::MaskSide::ABOVE, "Elevation above threshold (sky)")
+        .value("BELOW", p2b::MaskSide::BELOW, "Elevation at or below threshold (ground)");
+
     // ============================================================
     //  1D pixel-tangent conversions  (math.hpp)
     // ============================================================
@@ -209,6 +471,11 @@ NB_MODULE(_core, m)
         "dir_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "boundary"_a,
         "Check if NED direction projects inside frame.");
 
+    m.def(
+        "ned_at_elevation",
+        [](Vec3In ned, double el) { return make_vec3(p2b::ned_at_elevation(to_vec3(ned), p2b::Radians{el})); },
+        "dir_ned"_a, "elevation"_a, "Re-target NED direction to an elevation (radians), keeping azimuth.");
+
     m.def(
         "pixel_at_elevation",
         [](uint64_t row, uint64_t col, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att,
@@ -228,38 +495,606 @@ NB_MODULE(_core, m)
         "pixel_to_tan"_a, "Angular separation between NED vectors as pixel distance.");
 
     // ============================================================
-    //  Batch (vectorized) — zero-copy input via reinterpret_cast
+    //  Elevation contours  (elevation_contour.hpp)
+    // ============================================================
+
+    m.def(
+        "elevation_contour_at_row",
+        [](uint64_t row, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att, double el)
+        {
+            return p2b::elevation_contour_at_row(p2b::PixelIndex{row}, p2b::ImageSize{w, h}, p2b::PixelToTan{p2t},
+                                                 to_quat(cam), to_quat(att), p2b::Radians{el});
+        },
+        "row"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "elevation"_a,
+        "Col crossings (ascending, NaN if absent) of a row with an elevation contour.");
+
+    m.def(
+        "elevation_contour_at_col",
+        [](uint64_t col, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att, double el)
+        {
+            return p2b::elevation_contour_at_col(p2b::PixelIndex{col}, p2b::ImageSize{w, h}, p2b::PixelToTan{p2t},
+                                                 to_quat(cam), to_quat(att), p2b::Radians{el});
+        },
+        "col"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "elevation"_a,
+        "Row crossings (ascending, NaN if absent) of a col with an elevation contour.");
+
+    m.def(
+        "elevation_contour_cols",
+        [](uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att, double el)
+        {
+            const size_t n = w;
+            auto *out = new double[n * 2];
+            p2b::elevation_contour_cols(as_crossings(out, n), p2b::ImageSize{w, h}, p2b::PixelToTan{p2t},
+                                        to_quat(cam), to_quat(att), p2b::Radians{el});
+            return batch_output(out, n, 2);
+        },
+        "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "elevation"_a,
+        "Elevation contour col crossings for every row. Returns (width,2) float64 array.");
+
+    m.def(
+        "elevation_contour_rows",
+        [](uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att, double el)
+        {
+            const size_t n = h;
+            auto *out = new double[n * 2];
+            p2b::elevation_contour_rows(as_crossings(out, n), p2b::ImageSize{w, h}, p2b::PixelToTan{p2t},
+                                        to_quat(cam), to_quat(att), p2b::Radians{el});
+            return batch_output(out, n, 2);
+        },
+        "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "elevation"_a,
+        "Elevation contour row crossings for every col. Returns (height,2) float64 array.");
+
+    m.def(
+        "horizon_line",
+        [](uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att)
+        {
+            const size_t n = w;
+            auto *out = new double[n];
+            p2b::horizon_line({out, n}, p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam), to_quat(att));
+            return batch_output(out, n);
+        },
+        "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "Horizon col for every row (NaN where absent). Returns (width,) float64 array.");
+
+    // ============================================================
+    //  Sky / ground masks  (elevation_mask.hpp)
+    // ============================================================
+
+    m.def(
+        "elevation_mask",
+        [](uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att, double thr, double margin, p2b::MaskSide side,
+           uint8_t value)
+        {
+            const size_t n = w * h;
+            auto *out = new uint8_t[n];
+            p2b::fill_elevation_mask({out, n}, p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam), to_quat(att),
+                                     p2b::Radians{thr}, margin, side, value);
+            return batch_output(out, h, w);
+        },
+        "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "threshold"_a, "margin_px"_a = 0.0,
+        "side"_a = p2b::MaskSide::ABOVE, "value"_a = 255,
+        "Sky/ground mask filled per run. Returns (height, width) uint8 array.");
+
+    m.def(
+        "elevation_mask_spans",
+        [](uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att, double thr, double margin, p2b::MaskSide side)
+        {
+            const auto spans = p2b::elevation_mask_spans(p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam),
+                                                         to_quat(att), p2b::Radians{thr}, margin, side);
+            const size_t n = spans.size();
+            auto *out = new uint64_t[n * 3];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i * 3] = spans[i].col;
+                out[i * 3 + 1] = spans[i].row_begin;
+                out[i * 3 + 2] = spans[i].row_end;
+            }
+            return batch_output(out, n, 3);
+        },
+        "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "threshold"_a, "margin_px"_a = 0.0,
+        "side"_a = p2b::MaskSide::ABOVE,
+        "Run-length sky/ground mask. Returns (K,3) uint64 array of [col, row_begin, row_end).");
+
+    // ============================================================
+    //  Fast scalar convention  (submodule "fast")
+    //  Quaternions are (w, x, y, z) and vectors (x, y, z) as plain tuples or
+    //  any length-4/3 sequence; results are tuples. No ndarray is created.
+    // ============================================================
+
+    auto fast = m.def_submodule("fast", "Low-overhead scalar calls: tuples/floats in, tuples out.");
+
+    fast.def(
+        "cam_to_body_from_angle",
+        [](double angle) -> QuatT
+        {
+            const auto q = p2b::cam_to_body_from_angle(p2b::Radians{angle});
+            return {q.w, q.x, q.y, q.z};
+        },
+        "angle_rad"_a, "Camera-to-body quaternion (w, x, y, z) from installation angle.");
+
+    fast.def(
+        "tangents_to_ned", [](double wt, double ht) { return to_tuple(p2b::tangents_to_ned(wt, ht)); }, "w_tan"_a,
+        "h_tan"_a, "Tangent pair -> NED direction (x, y, z).");
+
+    fast.def(
+        "ned_to_tangents", [](const Vec3T &ned) { return p2b::ned_to_tangents(to_vec3(ned)); }, "ned"_a,
+        "NED direction -> (w_tan, h_tan).");
+
+    fast.def(
+        "ned_to_azimuth_elevation",
+        [](const Vec3T &ned) -> std::pair<double, double>
+        {
+            auto [az, el] = p2b::ned_to_azimuth_elevation(to_vec3(ned));
+            return {az.value(), el.value()};
+        },
+        "ned"_a, "NED direction -> (azimuth, elevation) in radians.");
+
+    fast.def(
+        "azimuth_elevation_to_ned",
+        [](double az, double el)
+        { return to_tuple(p2b::azimuth_elevation_to_ned(p2b::Radians{az}, p2b::Radians{el})); },
+        "azimuth"_a, "elevation"_a, "Azimuth/elevation (radians) -> NED direction (x, y, z).");
+
+    fast.def(
+        "warp_image_to_body",
+        [](double wt, double ht, const QuatT &q) { return to_tuple(p2b::warp_image_to_body(wt, ht, to_quat(q))); },
+        "w_tan"_a, "h_tan"_a, "cam_to_body"_a, "Image tangents -> body-frame direction (x, y, z).");
+
+    fast.def(
+        "warp_body_to_image",
+        [](const Vec3T &dir, const QuatT &q) { return p2b::warp_body_to_image(to_vec3(dir), to_quat(q)); },
+        "dir_body"_a, "cam_to_body"_a, "Body-frame direction -> (w_tan, h_tan).");
+
+    fast.def(
+        "pixel_to_ned",
+        [](uint64_t row, uint64_t col, uint64_t w, uint64_t h, double p2t, const QuatT &cam, const QuatT &att)
+        {
+            return to_tuple(p2b::pixel_to_ned(p2b::PixelIndex{row}, p2b::PixelIndex{col}, p2b::ImageSize{w, h},
+                                              p2b::PixelToTan{p2t}, to_quat(cam), to_quat(att)));
+        },
+        "row"_a, "col"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "Pixel -> NED direction (x, y, z).");
+
+    fast.def(
+        "ned_to_pixel",
+        [](const Vec3T &ned, uint64_t w, uint64_t h, double p2t, const QuatT &cam, const QuatT &att)
+        {
+            return to_tuple(p2b::ned_to_pixel(to_vec3(ned), p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam),
+                                              to_quat(att)));
+        },
+        "dir_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "NED direction -> pixel (row, col).");
+
+    fast.def(
+        "pixel_after_rotation",
+        [](uint64_t row, uint64_t col, uint64_t w, uint64_t h, double p2t, const QuatT &cam, const QuatT &qo,
+           const QuatT &qn, bool rb)
+        {
+            return to_tuple(p2b::pixel_after_rotation(p2b::PixelIndex{row}, p2b::PixelIndex{col},
+                                                      p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam),
+                                                      to_quat(qo), to_quat(qn), rb));
+        },
+        "row"_a, "col"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "q_old"_a, "q_new"_a,
+        "round_back"_a = false, "Pixel position (row, col) after body rotation change.");
+
+    fast.def(
+        "is_ned_inside_frame",
+        [](const Vec3T &ned, uint64_t w, uint64_t h, double p2t, const QuatT &cam, const QuatT &att, double boundary)
+        {
+            return p2b::is_ned_inside_frame(to_vec3(ned), p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam),
+                                            to_quat(att), boundary);
+        },
+        "dir_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "boundary"_a,
+        "Check if NED direction projects inside frame.");
+
+    fast.def(
+        "ned_at_elevation",
+        [](const Vec3T &ned, double el) { return to_tuple(p2b::ned_at_elevation(to_vec3(ned), p2b::Radians{el})); },
+        "dir_ned"_a, "elevation"_a, "Re-target NED direction to an elevation (radians), keeping azimuth.");
+
+    fast.def(
+        "pixel_at_elevation",
+        [](uint64_t row, uint64_t col, uint64_t w, uint64_t h, double p2t, const QuatT &cam, const QuatT &att,
+           double el)
+        {
+            return to_tuple(p2b::pixel_at_elevation(p2b::PixelIndex{row}, p2b::PixelIndex{col}, p2b::ImageSize{w, h},
+                                                    p2b::PixelToTan{p2t}, to_quat(cam), to_quat(att),
+                                                    p2b::Radians{el}));
+        },
+        "row"_a, "col"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "desired_elevation"_a, "Project pixel to target elevation, preserving azimuth.");
+
+    fast.def(
+        "ned_angle_in_pixels",
+        [](const Vec3T &n1, const Vec3T &n2, double p2t)
+        { return p2b::ned_angle_in_pixels(to_vec3(n1), to_vec3(n2), p2b::PixelToTan{p2t}); }, "ned1"_a, "ned2"_a,
+        "pixel_to_tan"_a, "Angular separation between NED vectors as pixel distance.");
+
+    // ============================================================
+    //  Camera with prepared state  (camera.hpp)
+    //  Intrinsics, installation and attitude are converted once; scalar
+    //  methods use the tuple convention, batch methods take/return arrays.
+    // ============================================================
+
+    nb::class_<p2b::Camera>(m, "Camera")
+        .def(
+            "__init__",
+            [](p2b::Camera *self, uint64_t w, uint64_t h, double p2t, const QuatT &cam, const QuatT &att)
+            { new (self) p2b::Camera(p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam), to_quat(att)); },
+            "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a = QuatT{1.0, 0.0, 0.0, 0.0})
+        .def_prop_ro("width", [](const p2b::Camera &c) { return c.image_size().width; })
+        .def_prop_ro("height", [](const p2b::Camera &c) { return c.image_size().height; })
+        .def_prop_ro("pixel_to_tan", [](const p2b::Camera &c) { return c.pixel_to_tan().get(); })
+        .def_prop_ro("cam_to_body",
+                     [](const p2b::Camera &c) -> QuatT
+                     {
+                         const auto &q = c.cam_to_body();
+                         return {q.w, q.x, q.y, q.z};
+                     })
+        .def_prop_ro("attitude",
+                     [](const p2b::Camera &c) -> QuatT
+                     {
+                         const auto &q = c.attitude();
+                         return {q.w, q.x, q.y, q.z};
+                     })
+        .def(
+            "set_attitude", [](p2b::Camera &c, const QuatT &att) { c.set_attitude(to_quat(att)); }, "attitude"_a,
+            "Per-frame attitude update (w, x, y, z).")
+        .def(
+            "set_cam_to_body", [](p2b::Camera &c, const QuatT &cam) { c.set_cam_to_body(to_quat(cam)); },
+            "cam_to_body"_a, "Per-frame installation update (w, x, y, z), e.g. from a gimbal.")
+        .def(
+            "pixel_to_ned",
+            [](const p2b::Camera &c, uint64_t row, uint64_t col)
+            { return to_tuple(c.pixel_to_ned(p2b::PixelIndex{row}, p2b::PixelIndex{col})); },
+            "row"_a, "col"_a, "Pixel -> NED direction (x, y, z).")
+        .def(
+            "ned_to_pixel",
+            [](const p2b::Camera &c, const Vec3T &ned) { return to_tuple(c.ned_to_pixel(to_vec3(ned))); },
+            "dir_ned"_a, "NED direction -> pixel (row, col).")
+        .def(
+            "pixel_after_rotation",
+            [](const p2b::Camera &c, uint64_t row, uint64_t col, const QuatT &q_new, bool rb)
+            {
+                const auto rotation = c.rotation_to(to_quat(q_new));
+                return to_tuple(c.pixel_after_rotation(p2b::PixelIndex{row}, p2b::PixelIndex{col}, rotation, rb));
+            },
+            "row"_a, "col"_a, "q_new"_a, "round_back"_a = false,
+            "Pixel position (row, col) after the body moves from the current attitude to q_new.")
+        .def(
+            "is_inside", [](const p2b::Camera &c, const Vec3T &ned, double boundary)
+            { return c.is_inside(to_vec3(ned), boundary); }, "dir_ned"_a, "boundary"_a = 0.0,
+            "Check if NED direction projects inside frame.")
+        .def(
+            "pixel_to_ned_batch",
+            [](const p2b::Camera &c, IndexIn rows, std::optional<IndexIn> cols)
+            {
+                const auto px = pixel_pairs(rows, cols);
+                const size_t n = px.n;
+                auto *out = new double[n * 3];
+                px.visit(
+                    [&](auto r, auto cl)
+                    {
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            const auto ned = c.pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{cl[i]});
+                            out[i * 3] = ned.x;
+                            out[i * 3 + 1] = ned.y;
+                            out[i * 3 + 2] = ned.z;
+                        }
+                    });
+                return batch_output(out, n, 3);
+            },
+            "rows"_a, "cols"_a.none(), "Batch pixels -> NED directions. Returns (N,3) array.")
+        .def(
+            "ned_to_pixel_batch",
+            [](const p2b::Camera &c, F64_2D dirs)
+            {
+                const size_t n = dirs.shape(0);
+                const auto vecs = vec3_rows(dirs, "dirs_ned");
+                auto *out = new uint64_t[n * 2];
+                for (size_t i = 0; i < n; ++i)
+                {
+                    auto [row, col] = c.ned_to_pixel(vecs[i]);
+                    out[i * 2] = row.value();
+                    out[i * 2 + 1] = col.value();
+                }
+                return batch_output(out, n, 2);
+            },
+            "dirs_ned"_a, "Batch NED directions -> pixels. Returns (N,2) uint64 array.")
+        .def(
+            "pixel_after_rotation_batch",
+            [](const p2b::Camera &c, IndexIn rows, std::optional<IndexIn> cols, const QuatT &q_new, bool rb)
+            {
+                const auto px = pixel_pairs(rows, cols);
+                const size_t n = px.n;
+                const auto rotation = c.rotation_to(to_quat(q_new)); // composed once for the whole batch
+                auto *out = new uint64_t[n * 2];
+                px.visit(
+                    [&](auto r, auto cl)
+                    {
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            auto [row, col] =
+                                c.pixel_after_rotation(p2b::PixelIndex{r[i]}, p2b::PixelIndex{cl[i]}, rotation, rb);
+                            out[i * 2] = row.value();
+                            out[i * 2 + 1] = col.value();
+                        }
+                    });
+                return batch_output(out, n, 2);
+            },
+            "rows"_a, "cols"_a.none(), "q_new"_a, "round_back"_a = false,
+            "Batch pixel positions after rotation to q_new. Returns (N,2) uint64 array.")
+        .def(
+            "is_inside_batch",
+            [](const p2b::Camera &c, F64_2D dirs, double boundary)
+            {
+                const size_t n = dirs.shape(0);
+                const auto vecs = vec3_rows(dirs, "dirs_ned");
+                auto *out = new bool[n];
+                for (size_t i = 0; i < n; ++i)
+                {
+                    out[i] = c.is_inside(vecs[i], boundary);
+                }
+                return batch_output(out, n);
+            },
+            "dirs_ned"_a, "boundary"_a = 0.0, "Batch visibility check. Returns (N,) bool array.")
+        .def("__repr__",
+             [](const p2b::Camera &c)
+             {
+                 return "Camera(width=" + std::to_string(c.image_size().width) +
+                        ", height=" + std::to_string(c.image_size().height) +
+                        ", pixel_to_tan=" + std::to_string(c.pixel_to_tan().get()) + ")";
+             });
+
+    // ============================================================
+    //  Rolling-shutter camera  (rolling_shutter.hpp)
+    //  Per-line attitudes are interpolated once per frame; same
+    //  tuple / array conventions as Camera.
+    // ============================================================
+
+    using RsCamera = p2b::RollingShutterCamera;
+    nb::class_<RsCamera>(m, "RollingShutterCamera")
+        .def(
+            "__init__",
+            [](RsCamera *self, uint64_t w, uint64_t h, double p2t, const QuatT &cam)
+            { new (self) RsCamera(p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam)); },
+            "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a)
+        .def_prop_ro("width", [](const RsCamera &c) { return c.image_size().width; })
+        .def_prop_ro("height", [](const RsCamera &c) { return c.image_size().height; })
+        .def_prop_ro("pixel_to_tan", [](const RsCamera &c) { return c.pixel_to_tan().get(); })
+        .def_prop_ro("cam_to_body",
+                     [](const RsCamera &c) -> QuatT
+                     {
+                         const auto &q = c.cam_to_body();
+                         return {q.w, q.x, q.y, q.z};
+                     })
+        .def(
+            "set_attitudes", [](RsCamera &c, const QuatT &first, const QuatT &last)
+            { c.set_attitudes(to_quat(first), to_quat(last)); }, "first_line"_a, "last_line"_a,
+            "Per-frame update from the attitudes at which the first and last lines are read.")
+        .def(
+            "set_attitude_series",
+            [](RsCamera &c, F64_2D samples, double sample_interval, double readout_time)
+            {
+                const size_t k = samples.shape(0);
+                if (k == 0)
+                    throw std::invalid_argument("samples must not be empty");
+                const auto q = quat_rows(samples, "samples");
+                std::vector<p2b::Quaternion> series(k);
+                for (size_t i = 0; i < k; ++i)
+                {
+                    series[i] = q[i];
+                }
+                c.set_attitudes(series, sample_interval, readout_time);
+            },
+            "samples"_a, "sample_interval"_a, "readout_time"_a,
+            "Per-frame update from (K,4) attitudes spaced sample_interval apart, starting at the first line.")
+        .def(
+            "line_attitude",
+            [](const RsCamera &c, uint64_t col) -> QuatT
+            {
+                const auto q = c.line_attitude(p2b::PixelIndex{col});
+                return {q.w, q.x, q.y, q.z};
+            },
+            "col"_a, "Interpolated attitude (w, x, y, z) of readout line col.")
+        .def(
+            "pixel_to_ned",
+            [](const RsCamera &c, uint64_t row, uint64_t col)
+            { return to_tuple(c.pixel_to_ned(p2b::PixelIndex{row}, p2b::PixelIndex{col})); },
+            "row"_a, "col"_a, "Pixel -> NED direction (x, y, z) at its line's attitude.")
+        .def(
+            "ned_to_pixel",
+            [](const RsCamera &c, const Vec3T &ned) { return to_tuple(c.ned_to_pixel(to_vec3(ned))); },
+            "dir_ned"_a, "NED direction -> pixel (row, col) on the line it is seen from.")
+        .def(
+            "pixel_after_rotation",
+            [](const RsCamera &c, uint64_t row, uint64_t col, const RsCamera &next, bool rb)
+            { return to_tuple(c.pixel_after_rotation(p2b::PixelIndex{row}, p2b::PixelIndex{col}, next, rb)); },
+            "row"_a, "col"_a, "next_frame"_a, "round_back"_a = false,
+            "Pixel position (row, col) in the next frame of the direction seen at (row, col).")
+        .def(
+            "pixel_to_ned_batch",
+            [](const RsCamera &c, IndexIn rows, std::optional<IndexIn> cols)
+            {
+                const auto px = pixel_pairs(rows, cols);
+                const size_t n = px.n;
+                auto *out = new double[n * 3];
+                px.visit(
+                    [&](auto r, auto cl)
+                    {
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            const auto ned = c.pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{cl[i]});
+                            out[i * 3] = ned.x;
+                            out[i * 3 + 1] = ned.y;
+                            out[i * 3 + 2] = ned.z;
+                        }
+                    });
+                return batch_output(out, n, 3);
+            },
+            "rows"_a, "cols"_a.none(), "Batch pixels -> NED directions. Returns (N,3) array.")
+        .def(
+            "ned_to_pixel_batch",
+            [](const RsCamera &c, F64_2D dirs)
+            {
+                const size_t n = dirs.shape(0);
+                const auto vecs = vec3_rows(dirs, "dirs_ned");
+                auto *out = new uint64_t[n * 2];
+                for (size_t i = 0; i < n; ++i)
+                {
+                    auto [row, col] = c.ned_to_pixel(vecs[i]);
+                    out[i * 2] = row.value();
+                    out[i * 2 + 1] = col.value();
+                }
+                return batch_output(out, n, 2);
+            },
+            "dirs_ned"_a, "Batch NED directions -> pixels. Returns (N,2) uint64 array.")
+        .def(
+            "pixel_after_rotation_batch",
+            [](const RsCamera &c, IndexIn rows, std::optional<IndexIn> cols, const RsCamera &next, bool rb)
+            {
+                const auto px = pixel_pairs(rows, cols);
+                const size_t n = px.n;
+                auto *out = new uint64_t[n * 2];
+                px.visit(
+                    [&](auto r, auto cl)
+                    {
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            auto [row, col] =
+                                c.pixel_after_rotation(p2b::PixelIndex{r[i]}, p2b::PixelIndex{cl[i]}, next, rb);
+                            out[i * 2] = row.value();
+                            out[i * 2 + 1] = col.value();
+                        }
+                    });
+                return batch_output(out, n, 2);
+            },
+            "rows"_a, "cols"_a.none(), "next_frame"_a, "round_back"_a = false,
+            "Batch pixel positions in the next frame. Returns (N,2) uint64 array.")
+        .def("__repr__",
+             [](const RsCamera &c)
+             {
+                 return "RollingShutterCamera(width=" + std::to_string(c.image_size().width) +
+                        ", height=" + std::to_string(c.image_size().height) +
+                        ", pixel_to_tan=" + std::to_string(c.pixel_to_tan().get()) + ")";
+             });
+
+    // ============================================================
+    //  Timestamped attitude history  (attitude_buffer.hpp)
+    // ============================================================
+
+    nb::enum_<p2b::Interpolation>(m, "Interpolation")
+        .value("SLERP", p2b::Interpolation::SLERP, "Spherical linear interpolation (constant rate)")
+        .value("NLERP", p2b::Interpolation::NLERP, "Normalized linear interpolation (cheaper)");
+
+    nb::class_<p2b::AttitudeBuffer>(m, "AttitudeBuffer")
+        .def(nb::init<size_t>(), "capacity"_a)
+        .def("__len__", &p2b::AttitudeBuffer::size)
+        .def_prop_ro("capacity", &p2b::AttitudeBuffer::capacity)
+        .def_prop_ro("span",
+                     [](const p2b::AttitudeBuffer &b) -> std::optional<std::pair<double, double>>
+                     {
+                         if (b.empty())
+                             return std::nullopt;
+                         return std::pair{b.oldest().timestamp, b.newest().timestamp};
+                     })
+        .def("clear", &p2b::AttitudeBuffer::clear)
+        .def(
+            "push", [](p2b::AttitudeBuffer &b, double t, const QuatT &q) { return b.push(t, to_quat(q)); },
+            "timestamp"_a, "attitude"_a,
+            "Append a sample (w, x, y, z). Returns False (ignored) unless newer than the newest.")
+        .def(
+            "push_batch",
+            [](p2b::AttitudeBuffer &b, F64_1D times, F64_2D quats)
+            {
+                const size_t n = times.shape(0);
+                const auto t = f64_column(times);
+                const auto q = quat_rows(quats, n, "attitudes");
+                size_t accepted = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    accepted += b.push(t[i], q[i]) ? 1 : 0;
+                }
+                return accepted;
+            },
+            "timestamps"_a, "attitudes"_a, "Append (N,) timestamps with (N,4) attitudes. Returns the number accepted.")
+        .def(
+            "at",
+            [](const p2b::AttitudeBuffer &b, double t, p2b::Interpolation method) -> std::optional<QuatT>
+            {
+                const auto q = b.at(t, method);
+                if (!q)
+                    return std::nullopt;
+                return QuatT{q->w, q->x, q->y, q->z};
+            },
+            "timestamp"_a, "method"_a = p2b::Interpolation::SLERP,
+            "Interpolated attitude (w, x, y, z) at timestamp, or None outside the buffered span.")
+        .def(
+            "at_batch",
+            [](const p2b::AttitudeBuffer &b, F64_1D times, p2b::Interpolation method)
+            {
+                const size_t n = times.shape(0);
+                const auto t = f64_column(times);
+                auto *out = new double[n * 4];
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const auto q = b.at(t[i], method);
+                    if (!q)
+                    {
+                        delete[] out;
+                        throw std::invalid_argument("timestamp " + std::to_string(t[i]) +
+                                                    " is outside the buffered span");
+                    }
+                    out[i * 4] = q->w;
+                    out[i * 4 + 1] = q->x;
+                    out[i * 4 + 2] = q->y;
+                    out[i * 4 + 3] = q->z;
+                }
+                return batch_output(out, n, 4);
+            },
+            "timestamps"_a, "method"_a = p2b::Interpolation::SLERP,
+            "Attitudes at (N,) timestamps as (N,4) [w,x,y,z]; sorted timestamps cost O(1) each.")
+        .def("__repr__",
+             [](const p2b::AttitudeBuffer &b)
+             {
+                 return "AttitudeBuffer(size=" + std::to_string(b.size()) +
+                        ", capacity=" + std::to_string(b.capacity()) + ")";
+             });
+
+    // ============================================================
+    //  Batch (vectorized) — strided inputs read in place
     // ============================================================
 
     m.def(
         "pixel_to_ned_batch",
-        [](U64_1D rows, U64_1D cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att)
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att)
         {
-            const size_t n = rows.shape(0);
-            if (cols.shape(0) != n)
-                throw std::invalid_argument("rows and cols must have same length");
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
 
             const auto qc = to_quat(cam);
             const auto qa = to_quat(att);
             const p2b::ImageSize img{w, h};
             const p2b::PixelToTan pt{p2t};
-            const uint64_t *r = rows.data();
-            const uint64_t *c = cols.data();
 
             auto *out = new double[n * 3];
-            for (size_t i = 0; i < n; ++i)
-            {
-                const auto ned = p2b::pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, pt, qc, qa);
-                out[i * 3] = ned.x;
-                out[i * 3 + 1] = ned.y;
-                out[i * 3 + 2] = ned.z;
-            }
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const auto ned =
+                            p2b::pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, pt, qc, qa);
+                        out[i * 3] = ned.x;
+                        out[i * 3 + 1] = ned.y;
+                        out[i * 3 + 2] = ned.z;
+                    }
+                });
 
-            nb::capsule owner(out, [](void *p) noexcept { delete[] static_cast<double *>(p); });
-            size_t shape[2] = {n, 3};
-            return nb::ndarray<nb::numpy, double>(out, 2, shape, owner);
+            return batch_output(out, n, 3);
         },
-        "rows"_a, "cols"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
         "Batch pixels -> NED directions. Returns (N,3) array.");
 
     m.def(
@@ -267,17 +1102,13 @@ NB_MODULE(_core, m)
         [](F64_2D dirs, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att)
         {
             const size_t n = dirs.shape(0);
-            if (dirs.shape(1) != 3)
-                throw std::invalid_argument("dirs_ned must have shape (N, 3)");
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
 
             const auto qc = to_quat(cam);
             const auto qa = to_quat(att);
             const p2b::ImageSize img{w, h};
             const p2b::PixelToTan pt{p2t};
 
-            // Zero-copy: Vector3 is {double x, y, z} — identical layout to double[3]
-            const auto *vecs = reinterpret_cast<const p2b::Vector3 *>(dirs.data());
-
             auto *out = new uint64_t[n * 2];
             for (size_t i = 0; i < n; ++i)
             {
@@ -286,56 +1117,87 @@ NB_MODULE(_core, m)
                 out[i * 2 + 1] = col.value();
             }
 
-            nb::capsule owner(out, [](void *p) noexcept { delete[] static_cast<uint64_t *>(p); });
-            size_t shape[2] = {n, 2};
-            return nb::ndarray<nb::numpy, uint64_t>(out, 2, shape, owner);
+            return batch_output(out, n, 2);
         },
         "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
         "Batch NED directions -> pixels. Returns (N,2) uint64 array.");
 
     m.def(
         "pixel_after_rotation_batch",
-        [](U64_1D rows, U64_1D cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn qo, QuatIn qn, bool rb)
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn qo,
+           QuatIn qn, bool rb)
         {
-            const size_t n = rows.shape(0);
-            if (cols.shape(0) != n)
-                throw std::invalid_argument("rows and cols must have same length");
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
 
             const auto qc = to_quat(cam);
             const auto q_old = to_quat(qo);
             const auto q_new = to_quat(qn);
             const p2b::ImageSize img{w, h};
             const p2b::PixelToTan pt{p2t};
-            const uint64_t *r = rows.data();
-            const uint64_t *c = cols.data();
 
             auto *out = new uint64_t[n * 2];
-            for (size_t i = 0; i < n; ++i)
-            {
-                auto [rn, cn] = p2b::pixel_after_rotation(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, pt, qc,
-                                                          q_old, q_new, rb);
-                out[i * 2] = rn.value();
-                out[i * 2 + 1] = cn.value();
-            }
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        auto [rn, cn] = p2b::pixel_after_rotation(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img,
+                                                                  pt, qc, q_old, q_new, rb);
+                        out[i * 2] = rn.value();
+                        out[i * 2 + 1] = cn.value();
+                    }
+                });
 
-            nb::capsule owner(out, [](void *p) noexcept { delete[] static_cast<uint64_t *>(p); });
-            size_t shape[2] = {n, 2};
-            return nb::ndarray<nb::numpy, uint64_t>(out, 2, shape, owner);
+            return batch_output(out, n, 2);
         },
-        "rows"_a, "cols"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "q_old"_a, "q_new"_a,
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "q_old"_a, "q_new"_a,
         "round_back"_a = false, "Batch pixel positions after rotation. Returns (N,2) uint64 array.");
 
+    m.def(
+        "pixel_at_elevation_batch",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att,
+           double el)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+
+            const auto qc = to_quat(cam);
+            const auto qa = to_quat(att);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            const double cos_el = std::cos(el);
+            const double sin_el = std::sin(el);
+
+            auto *out = new uint64_t[n * 2];
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const auto ned =
+                            p2b::pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, pt, qc, qa);
+                        auto [rn, cn] = p2b::ned_to_pixel(p2b::ned_at_elevation(ned, cos_el, sin_el), img, pt, qc, qa);
+                        out[i * 2] = rn.value();
+                        out[i * 2 + 1] = cn.value();
+                    }
+                });
+
+            return batch_output(out, n, 2);
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "desired_elevation"_a, "Batch project pixels to target elevation. Returns (N,2) uint64 array.");
+
     m.def(
         "warp_image_to_body_batch",
         [](F64_1D wt, F64_1D ht, QuatIn cam)
         {
             const size_t n = wt.shape(0);
-            if (ht.shape(0) != n)
-                throw std::invalid_argument("w_tans and h_tans must have same length");
+            require_same_length(ht.shape(0), n, "w_tans and h_tans");
 
             const auto qc = to_quat(cam);
-            const double *w = wt.data();
-            const double *h = ht.data();
+            const auto w = f64_column(wt);
+            const auto h = f64_column(ht);
 
             auto *out = new double[n * 3];
             for (size_t i = 0; i < n; ++i)
@@ -346,10 +1208,975 @@ NB_MODULE(_core, m)
                 out[i * 3 + 2] = v.z;
             }
 
-            nb::capsule owner(out, [](void *p) noexcept { delete[] static_cast<double *>(p); });
-            size_t shape[2] = {n, 3};
-            return nb::ndarray<nb::numpy, double>(out, 2, shape, owner);
+            return batch_output(out, n, 3);
         },
         "w_tans"_a, "h_tans"_a, "cam_to_body"_a,
         "Batch image tangent pairs -> body-frame directions. Returns (N,3) array.");
+
+    // ---- 1D conversions (math.hpp): one value per pixel / tangent ----
+
+    m.def(
+        "pixel_tan_from_fov_batch",
+        [](IndexIn pixels, uint64_t w, uint64_t h, double fov)
+        {
+            const auto idx = index_column(pixels, "pixels");
+            const size_t n = idx.n;
+            const p2b::ImageSize img{w, h};
+            const p2b::Radians f{fov};
+            auto *out = new double[n];
+            idx.visit(
+                [&](auto px, auto)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        out[i] = p2b::pixel_tan_from_fov(p2b::PixelIndex{px[i]}, img, f).get();
+                    }
+                });
+            return batch_output(out, n);
+        },
+        "pixels"_a, "width"_a, "height"_a, "fov_rad"_a, "Batch pixel index -> tangent via FOV. Returns (N,) array.");
+
+    m.def(
+        "tan_to_pixel_by_fov_batch",
+        [](F64_1D tans, uint64_t w, uint64_t h, double fov)
+        {
+            const size_t n = tans.shape(0);
+            const p2b::ImageSize img{w, h};
+            const p2b::Radians f{fov};
+            const auto t = f64_column(tans);
+            auto *out = new uint64_t[n];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = p2b::tan_to_pixel_by_fov(p2b::PixelTan{t[i]}, img, f).value();
+            }
+            return batch_output(out, n);
+        },
+        "pixel_tans"_a, "width"_a, "height"_a, "fov_rad"_a,
+        "Batch tangent -> pixel index via FOV. Returns (N,) uint64 array.");
+
+    m.def(
+        "pixel_tan_by_pixel_to_tan_batch",
+        [](IndexIn pixels, uint64_t w, uint64_t h, double p2t)
+        {
+            const auto idx = index_column(pixels, "pixels");
+            const size_t n = idx.n;
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            auto *out = new double[n];
+            idx.visit(
+                [&](auto px, auto)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        out[i] = p2b::pixel_tan_by_pixel_to_tan(p2b::PixelIndex{px[i]}, img, pt).get();
+                    }
+                });
+            return batch_output(out, n);
+        },
+        "pixels"_a, "width"_a, "height"_a, "pixel_to_tan"_a,
+        "Batch pixel index -> tangent via pixel-to-tan factor. Returns (N,) array.");
+
+    m.def(
+        "angle_tan_to_pixel_batch",
+        [](F64_1D tans, uint64_t w, uint64_t h, double p2t)
+        {
+            const size_t n = tans.shape(0);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            const auto t = f64_column(tans);
+            auto *out = new uint64_t[n];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = p2b::angle_tan_to_pixel(p2b::PixelTan{t[i]}, img, pt).value();
+            }
+            return batch_output(out, n);
+        },
+        "angle_tans"_a, "width"_a, "height"_a, "pixel_to_tan"_a,
+        "Batch angular tangent -> pixel index. Returns (N,) uint64 array.");
+
+    m.def(
+        "pixel_tan_by_pixel_to_tan_clipped_batch",
+        [](IndexIn pixels, uint64_t w, uint64_t h, double p2t, double thr)
+        {
+            const auto idx = index_column(pixels, "pixels");
+            const size_t n = idx.n;
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            const p2b::ClipThreshold ct{thr};
+            auto *out = new double[n];
+            idx.visit(
+                [&](auto px, auto)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        out[i] = p2b::pixel_tan_by_pixel_to_tan_clipped(p2b::PixelIndex{px[i]}, img, pt, ct).get();
+                    }
+                });
+            return batch_output(out, n);
+        },
+        "pixels"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "threshold"_a,
+        "Batch pixel -> tangent with dead-zone clipping. Returns (N,) array.");
+
+    m.def(
+        "tan_to_pixel_by_pixel_to_tan_batch",
+        [](F64_1D tans, uint64_t w, uint64_t h, double p2t, bool round_back)
+        {
+            const size_t n = tans.shape(0);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            const auto t = f64_column(tans);
+            auto *out = new uint64_t[n];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = p2b::tan_to_pixel_by_pixel_to_tan(p2b::PixelTan{t[i]}, img, pt, round_back).value();
+            }
+            return batch_output(out, n);
+        },
+        "pixel_tans"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "round_back"_a = false,
+        "Batch tangent -> pixel index via pixel-to-tan factor. Returns (N,) uint64 array.");
+
+    m.def(
+        "pixel_to_tan_from_fov_batch",
+        [](F64_1D fovs, uint64_t w, uint64_t h)
+        {
+            const size_t n = fovs.shape(0);
+            const p2b::ImageSize img{w, h};
+            const auto f = f64_column(fovs);
+            auto *out = new double[n];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = p2b::pixel_to_tan_from_fov(img, p2b::Radians{f[i]}).get();
+            }
+            return batch_output(out, n);
+        },
+        "fovs_rad"_a, "width"_a, "height"_a, "Batch pixel-to-tan factors for many FOVs. Returns (N,) array.");
+
+    // ---- Body space (body_space.hpp): one row per direction ----
+
+    m.def(
+        "cam_to_body_from_angle_batch",
+        [](F64_1D angles)
+        {
+            const size_t n = angles.shape(0);
+            const auto a = f64_column(angles);
+            auto *out = new double[n * 4];
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto q = p2b::cam_to_body_from_angle(p2b::Radians{a[i]});
+                out[i * 4] = q.w;
+                out[i * 4 + 1] = q.x;
+                out[i * 4 + 2] = q.y;
+                out[i * 4 + 3] = q.z;
+            }
+            return batch_output(out, n, 4);
+        },
+        "angles_rad"_a, "Batch camera-to-body quaternions [w,x,y,z]. Returns (N,4) array.");
+
+    m.def(
+        "tangents_to_ned_batch",
+        [](F64_1D wt, F64_1D ht)
+        {
+            const size_t n = wt.shape(0);
+            require_same_length(ht.shape(0), n, "w_tans and h_tans");
+            const auto w = f64_column(wt);
+            const auto h = f64_column(ht);
+            auto *out = new double[n * 3];
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto v = p2b::tangents_to_ned(w[i], h[i]);
+                out[i * 3] = v.x;
+                out[i * 3 + 1] = v.y;
+                out[i * 3 + 2] = v.z;
+            }
+            return batch_output(out, n, 3);
+        },
+        "w_tans"_a, "h_tans"_a, "Batch tangent pairs -> NED directions. Returns (N,3) array.");
+
+    m.def(
+        "ned_to_tangents_batch",
+        [](F64_2D dirs)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "neds");
+            auto *out = new double[n * 2];
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto [w, h] = p2b::ned_to_tangents(vecs[i]);
+                out[i * 2] = w;
+                out[i * 2 + 1] = h;
+            }
+            return batch_output(out, n, 2);
+        },
+        "neds"_a, "Batch NED directions -> tangent pairs (w_tan, h_tan). Returns (N,2) array.");
+
+    m.def(
+        "ned_to_azimuth_elevation_batch",
+        [](F64_2D dirs)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "neds");
+            auto *out = new double[n * 2];
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto [az, el] = p2b::ned_to_azimuth_elevation(vecs[i]);
+                out[i * 2] = az.value();
+                out[i * 2 + 1] = el.value();
+            }
+            return batch_output(out, n, 2);
+        },
+        "neds"_a, "Batch NED directions -> (azimuth, elevation) in radians. Returns (N,2) array.");
+
+    m.def(
+        "azimuth_elevation_to_ned_batch",
+        [](F64_1D azimuths, F64_1D elevations)
+        {
+            const size_t n = azimuths.shape(0);
+            require_same_length(elevations.shape(0), n, "azimuths and elevations");
+            const auto az = f64_column(azimuths);
+            const auto el = f64_column(elevations);
+            auto *out = new double[n * 3];
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto v = p2b::azimuth_elevation_to_ned(p2b::Radians{az[i]}, p2b::Radians{el[i]});
+                out[i * 3] = v.x;
+                out[i * 3 + 1] = v.y;
+                out[i * 3 + 2] = v.z;
+            }
+            return batch_output(out, n, 3);
+        },
+        "azimuths"_a, "elevations"_a, "Batch azimuth/elevation (radians) -> NED directions. Returns (N,3) array.");
+
+    m.def(
+        "warp_body_to_image_batch",
+        [](F64_2D dirs, QuatIn cam)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_body");
+            const auto qc = to_quat(cam);
+            auto *out = new double[n * 2];
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto [w, h] = p2b::warp_body_to_image(vecs[i], qc);
+                out[i * 2] = w;
+                out[i * 2 + 1] = h;
+            }
+            return batch_output(out, n, 2);
+        },
+        "dirs_body"_a, "cam_to_body"_a, "Batch body-frame directions -> image tangent pairs. Returns (N,2) array.");
+
+    m.def(
+        "is_pixel_inside_frame_batch",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double boundary)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+            const p2b::ImageSize img{w, h};
+            auto *out = new bool[n];
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        out[i] =
+                            p2b::is_pixel_inside_frame(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, boundary);
+                    }
+                });
+            return batch_output(out, n);
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "boundary"_a,
+        "Batch pixel-inside-frame check with safety margin. Returns (N,) bool array.");
+
+    m.def(
+        "is_ned_inside_frame_batch",
+        [](F64_2D dirs, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att, double boundary)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const auto qc = to_quat(cam);
+            const auto qa = to_quat(att);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            auto *out = new bool[n];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = p2b::is_ned_inside_frame(vecs[i], img, pt, qc, qa, boundary);
+            }
+            return batch_output(out, n);
+        },
+        "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a, "boundary"_a,
+        "Batch NED visibility check. Returns (N,) bool array.");
+
+    m.def(
+        "ned_at_elevation_batch",
+        [](F64_2D dirs, double el)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const double cos_el = std::cos(el);
+            const double sin_el = std::sin(el);
+            auto *out = new double[n * 3];
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto v = p2b::ned_at_elevation(vecs[i], cos_el, sin_el);
+                out[i * 3] = v.x;
+                out[i * 3 + 1] = v.y;
+                out[i * 3 + 2] = v.z;
+            }
+            return batch_output(out, n, 3);
+        },
+        "dirs_ned"_a, "elevation"_a,
+        "Batch re-target NED directions to an elevation (radians), keeping azimuth. Returns (N,3) array.");
+
+    m.def(
+        "ned_angle_in_pixels_batch",
+        [](F64_2D a, F64_2D b, double p2t)
+        {
+            const size_t n = a.shape(0);
+            require_same_length(b.shape(0), n, "neds1 and neds2");
+            const auto va = vec3_rows(a, "neds1");
+            const auto vb = vec3_rows(b, "neds2");
+            const p2b::PixelToTan pt{p2t};
+            auto *out = new double[n];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = p2b::ned_angle_in_pixels(va[i], vb[i], pt);
+            }
+            return batch_output(out, n);
+        },
+        "neds1"_a, "neds2"_a, "pixel_to_tan"_a,
+        "Batch angular separation between paired NED vectors as pixel distance. Returns (N,) array.");
+
+    // ---- Per-point attitudes: one (N,4) quaternion per point ----
+    // The Python wrappers dispatch here when the attitude argument holds many rotations.
+
+    m.def(
+        "pixel_to_ned_batch_per_point",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, F64_2D atts)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+            const auto qa = quat_rows(atts, n, "attitudes");
+            const auto qc = to_quat(cam);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+
+            auto *out = new double[n * 3];
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const auto ned =
+                            p2b::pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, pt, qc, qa[i]);
+                        out[i * 3] = ned.x;
+                        out[i * 3 + 1] = ned.y;
+                        out[i * 3 + 2] = ned.z;
+                    }
+                });
+            return batch_output(out, n, 3);
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitudes"_a,
+        "Batch pixels -> NED directions, attitude per point (N,4). Returns (N,3) array.");
+
+    m.def(
+        "ned_to_pixel_batch_per_point",
+        [](F64_2D dirs, uint64_t w, uint64_t h, double p2t, QuatIn cam, F64_2D atts)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const auto qa = quat_rows(atts, n, "attitudes");
+            const auto qc = to_quat(cam);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+
+            auto *out = new uint64_t[n * 2];
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto [row, col] = p2b::ned_to_pixel(vecs[i], img, pt, qc, qa[i]);
+                out[i * 2] = row.value();
+                out[i * 2 + 1] = col.value();
+            }
+            return batch_output(out, n, 2);
+        },
+        "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitudes"_a,
+        "Batch NED directions -> pixels, attitude per point (N,4). Returns (N,2) uint64 array.");
+
+    m.def(
+        "pixel_after_rotation_batch_per_point",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, F64_2D qos,
+           F64_2D qns, bool rb)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+            const auto q_old = quat_rows(qos, n, "q_old");
+            const auto q_new = quat_rows(qns, n, "q_new");
+            const auto qc = to_quat(cam);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+
+            auto *out = new uint64_t[n * 2];
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        auto [rn, cn] = p2b::pixel_after_rotation(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img,
+                                                                  pt, qc, q_old[i], q_new[i], rb);
+                        out[i * 2] = rn.value();
+                        out[i * 2 + 1] = cn.value();
+                    }
+                });
+            return batch_output(out, n, 2);
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "q_old"_a, "q_new"_a,
+        "round_back"_a = false,
+        "Batch pixel positions after rotation, (N,4) q_old / q_new per point. Returns (N,2) uint64 array.");
+
+    m.def(
+        "pixel_at_elevation_batch_per_point",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, F64_2D atts,
+           double el)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+            const auto qa = quat_rows(atts, n, "attitudes");
+            const auto qc = to_quat(cam);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            const double cos_el = std::cos(el);
+            const double sin_el = std::sin(el);
+
+            auto *out = new uint64_t[n * 2];
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const auto q = qa[i];
+                        const auto ned =
+                            p2b::pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, pt, qc, q);
+                        auto [rn, cn] = p2b::ned_to_pixel(p2b::ned_at_elevation(ned, cos_el, sin_el), img, pt, qc, q);
+                        out[i * 2] = rn.value();
+                        out[i * 2 + 1] = cn.value();
+                    }
+                });
+            return batch_output(out, n, 2);
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitudes"_a,
+        "desired_elevation"_a,
+        "Batch project pixels to target elevation, attitude per point. Returns (N,2) uint64 array.");
+
+    m.def(
+        "is_ned_inside_frame_batch_per_point",
+        [](F64_2D dirs, uint64_t w, uint64_t h, double p2t, QuatIn cam, F64_2D atts, double boundary)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const auto qa = quat_rows(atts, n, "attitudes");
+            const auto qc = to_quat(cam);
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            auto *out = new bool[n];
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = p2b::is_ned_inside_frame(vecs[i], img, pt, qc, qa[i], boundary);
+            }
+            return batch_output(out, n);
+        },
+        "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitudes"_a, "boundary"_a,
+        "Batch NED visibility check, attitude per point (N,4). Returns (N,) bool array.");
+
+    // ---- Broadcast: M attitudes x N points -> (M, N, ...) ----
+    // Each attitude's composed rotation is built once; the loops run without the GIL, so
+    // callers can split M across threads.
+
+    m.def(
+        "pixel_to_ned_broadcast",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, F64_2D atts)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+            const auto qa = quat_rows(atts, "attitudes");
+            const size_t n_att = atts.shape(0);
+            p2b::Camera camera{p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam)};
+
+            // Camera-frame directions do not depend on the attitude: one pass over the pixels
+            std::vector<p2b::Vector3> dirs(n);
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        dirs[i] = camera.pixel_direction(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]});
+                    }
+                });
+
+            auto *out = new double[n_att * n * 3];
+            {
+                nb::gil_scoped_release release;
+                for (size_t k = 0; k < n_att; ++k)
+                {
+                    camera.set_attitude(qa[k]);
+                    double *o = out + k * n * 3;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const auto ned = camera.direction_to_ned(dirs[i]);
+                        o[i * 3] = ned.x;
+                        o[i * 3 + 1] = ned.y;
+                        o[i * 3 + 2] = ned.z;
+                    }
+                }
+            }
+            return batch_output(out, n_att, n, 3);
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitudes"_a,
+        "Pixels under each of M attitudes -> NED directions. Returns (M,N,3) array.");
+
+    m.def(
+        "ned_to_pixel_broadcast",
+        [](F64_2D dirs, uint64_t w, uint64_t h, double p2t, QuatIn cam, F64_2D atts)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const auto qa = quat_rows(atts, "attitudes");
+            const size_t n_att = atts.shape(0);
+            p2b::Camera camera{p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam)};
+
+            auto *out = new uint64_t[n_att * n * 2];
+            {
+                nb::gil_scoped_release release;
+                for (size_t k = 0; k < n_att; ++k)
+                {
+                    camera.set_attitude(qa[k]);
+                    uint64_t *o = out + k * n * 2;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        auto [row, col] = camera.ned_to_pixel(vecs[i]);
+                        o[i * 2] = row.value();
+                        o[i * 2 + 1] = col.value();
+                    }
+                }
+            }
+            return batch_output(out, n_att, n, 2);
+        },
+        "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitudes"_a,
+        "NED directions under each of M attitudes -> pixels. Returns (M,N,2) uint64 array.");
+
+    // ---- Gyro-rate pixel-motion prediction (gyro_prediction.hpp) ----
+    // First-order displacement from body rates; points whose error estimate exceeds
+    // max_error_px use the exact rotation.
+
+    m.def(
+        "predict_pixel_motion",
+        [](double row, double col, uint64_t w, uint64_t h, double p2t, QuatIn cam, Vec3In rates, double dt,
+           double max_error)
+        {
+            p2b::GyroPredictor predictor{p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam), max_error};
+            predictor.set_rates(to_vec3(rates), dt);
+            const auto pm = predictor.predict(row, col);
+            return std::make_tuple(pm.d_row, pm.d_col, pm.error_px, pm.exact);
+        },
+        "row"_a, "col"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "body_rates"_a, "dt"_a,
+        "max_error_px"_a = 0.1,
+        "Pixel displacement (d_row, d_col, error_px, exact) over dt from body angular rates (rad/s).");
+
+    m.def(
+        "predict_pixel_motion_batch",
+        [](F64_2D points, uint64_t w, uint64_t h, double p2t, QuatIn cam, Vec3In rates, double dt, double max_error)
+        {
+            if (points.shape(1) != 2)
+                throw std::invalid_argument("points must have shape (N, 2) of (row, col)");
+            const size_t n = points.shape(0);
+            const double *p = points.data();
+            const int64_t rs = points.stride(0);
+            const int64_t cs = points.stride(1);
+
+            p2b::GyroPredictor predictor{p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}, to_quat(cam), max_error};
+            predictor.set_rates(to_vec3(rates), dt);
+
+            auto motion = std::make_unique_for_overwrite<double[]>(n * 2);
+            auto error = std::make_unique_for_overwrite<double[]>(n);
+            auto exact = std::make_unique_for_overwrite<bool[]>(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const double *pt = p + static_cast<int64_t>(i) * rs;
+                const auto pm = predictor.predict(pt[0], pt[cs]);
+                motion[i * 2] = pm.d_row;
+                motion[i * 2 + 1] = pm.d_col;
+                error[i] = pm.error_px;
+                exact[i] = pm.exact;
+            }
+            return std::make_tuple(batch_output(std::move(motion), n, 2), batch_output(std::move(error), n),
+                                   batch_output(std::move(exact), n));
+        },
+        "points"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "body_rates"_a, "dt"_a,
+        "max_error_px"_a = 0.1,
+        "Batch (N,2) sub-pixel (row, col) -> ((N,2) displacements, (N,) error estimates, (N,) exact mask).");
+
+    // ---- Analytic Jacobians (jacobians.hpp) ----
+    // Continuous pixel positions (N,2) with d(pixel)/dx as (N,2,3); attitude derivatives are
+    // with respect to a body-frame small-angle error, attitude * exp(phi).
+
+    m.def(
+        "ned_to_pixel_jacobian",
+        [](Vec3In ned, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att)
+        {
+            const auto j = p2b::ned_to_pixel_jacobian(to_vec3(ned), p2b::ImageSize{w, h}, p2b::PixelToTan{p2t},
+                                                      to_quat(cam), to_quat(att));
+            std::unique_ptr<double[]> pixel(new double[2]{j.row, j.col});
+            auto d_dir = std::make_unique_for_overwrite<double[]>(6);
+            auto d_att = std::make_unique_for_overwrite<double[]>(6);
+            write_jacobian(d_dir.get(), j.d_dir);
+            write_jacobian(d_att.get(), j.d_attitude);
+            return std::make_tuple(batch_output(std::move(pixel), 2), batch_output(std::move(d_dir), 2, 3),
+                                   batch_output(std::move(d_att), 2, 3));
+        },
+        "dir_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "NED direction -> (continuous (row, col), d(pixel)/d(dir_ned) (2,3), d(pixel)/d(attitude error) (2,3)).");
+
+    m.def(
+        "ned_to_pixel_jacobian_batch",
+        [](F64_2D dirs, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn att)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan f{p2t};
+            const auto qc = to_quat(cam);
+            const auto qa = to_quat(att);
+
+            auto pixel = std::make_unique_for_overwrite<double[]>(n * 2);
+            auto d_dir = std::make_unique_for_overwrite<double[]>(n * 6);
+            auto d_att = std::make_unique_for_overwrite<double[]>(n * 6);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto j = p2b::ned_to_pixel_jacobian(vecs[i], img, f, qc, qa);
+                pixel[i * 2] = j.row;
+                pixel[i * 2 + 1] = j.col;
+                write_jacobian(d_dir.get() + i * 6, j.d_dir);
+                write_jacobian(d_att.get() + i * 6, j.d_attitude);
+            }
+            return std::make_tuple(batch_output(std::move(pixel), n, 2), batch_output(std::move(d_dir), n, 2, 3),
+                                   batch_output(std::move(d_att), n, 2, 3));
+        },
+        "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "attitude"_a,
+        "Batch NED directions -> ((N,2) continuous pixels, (N,2,3) d/d(dir_ned), (N,2,3) d/d(attitude error)).");
+
+    m.def(
+        "pixel_after_rotation_jacobian",
+        [](uint64_t row, uint64_t col, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn qo, QuatIn qn)
+        {
+            const auto j = p2b::pixel_after_rotation_jacobian(p2b::PixelIndex{row}, p2b::PixelIndex{col},
+                                                              p2b::ImageSize{w, h}, p2b::PixelToTan{p2t},
+                                                              to_quat(cam), to_quat(qo), to_quat(qn));
+            std::unique_ptr<double[]> pixel(new double[2]{j.row, j.col});
+            auto d_old = std::make_unique_for_overwrite<double[]>(6);
+            auto d_new = std::make_unique_for_overwrite<double[]>(6);
+            write_jacobian(d_old.get(), j.d_q_old);
+            write_jacobian(d_new.get(), j.d_q_new);
+            return std::make_tuple(batch_output(std::move(pixel), 2), batch_output(std::move(d_old), 2, 3),
+                                   batch_output(std::move(d_new), 2, 3));
+        },
+        "row"_a, "col"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "q_old"_a, "q_new"_a,
+        "Pixel after rotation -> (continuous (row, col), d/d(q_old error) (2,3), d/d(q_new error) (2,3)).");
+
+    m.def(
+        "pixel_after_rotation_jacobian_batch",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, QuatIn cam, QuatIn qo,
+           QuatIn qn)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan f{p2t};
+            const auto qc = to_quat(cam);
+            const auto q_old = to_quat(qo);
+            const auto q_new = to_quat(qn);
+
+            auto pixel = std::make_unique_for_overwrite<double[]>(n * 2);
+            auto d_old = std::make_unique_for_overwrite<double[]>(n * 6);
+            auto d_new = std::make_unique_for_overwrite<double[]>(n * 6);
+            px.visit(
+                [&](auto r, auto cl)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const auto j = p2b::pixel_after_rotation_jacobian(p2b::PixelIndex{r[i]}, p2b::PixelIndex{cl[i]},
+                                                                          img, f, qc, q_old, q_new);
+                        pixel[i * 2] = j.row;
+                        pixel[i * 2 + 1] = j.col;
+                        write_jacobian(d_old.get() + i * 6, j.d_q_old);
+                        write_jacobian(d_new.get() + i * 6, j.d_q_new);
+                    }
+                });
+            return std::make_tuple(batch_output(std::move(pixel), n, 2), batch_output(std::move(d_old), n, 2, 3),
+                                   batch_output(std::move(d_new), n, 2, 3));
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "cam_to_body"_a, "q_old"_a, "q_new"_a,
+        "Batch pixels after rotation -> ((N,2) continuous pixels, (N,2,3) d/d(q_old error), "
+        "(N,2,3) d/d(q_new error)).");
+
+    // ---- Rotation from pixel correspondences (rotation_estimation.hpp) ----
+    // Least-squares (Wahba) camera-frame rotation from matched sub-pixel positions; the result is
+    // what Camera.rotation_to returns for the true attitudes.
+
+    m.def(
+        "estimate_rotation",
+        [](F64_2D points_a, F64_2D points_b, uint64_t w, uint64_t h, double p2t, std::optional<F64_1D> weights)
+        {
+            if (points_a.shape(1) != 2 || points_b.shape(1) != 2)
+                throw std::invalid_argument("points_a and points_b must have shape (N, 2) of (row, col)");
+            const size_t n = points_a.shape(0);
+            require_same_length(points_b.shape(0), n, "points_a and points_b");
+            if (weights)
+                require_same_length(weights->shape(0), n, "points and weights");
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan f{p2t};
+            static constexpr double UNIT_WEIGHT = 1.0;
+            const Column<double> wt = weights ? f64_column(*weights) : Column<double>{&UNIT_WEIGHT, 0}; // zero stride
+
+            p2b::WahbaSolver solver;
+            {
+                nb::gil_scoped_release release;
+                const double *a = points_a.data();
+                const double *b = points_b.data();
+                const int64_t ars = points_a.stride(0);
+                const int64_t acs = points_a.stride(1);
+                const int64_t brs = points_b.stride(0);
+                const int64_t bcs = points_b.stride(1);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const double *pa = a + static_cast<int64_t>(i) * ars;
+                    const double *pb = b + static_cast<int64_t>(i) * brs;
+                    solver.add(p2b::subpixel_direction(pa[0], pa[acs], img, f),
+                               p2b::subpixel_direction(pb[0], pb[bcs], img, f),
+                               wt[i]);
+                }
+            }
+            return make_quat(solver.solve());
+        },
+        "points_a"_a, "points_b"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "weights"_a.none(),
+        "Camera-frame rotation [w,x,y,z] taking (N,2) positions in frame A onto their matches in frame B.");
+
+    m.def(
+        "estimate_rotation_ransac",
+        [](F64_2D points_a, F64_2D points_b, uint64_t w, uint64_t h, double p2t, double threshold_px,
+           size_t max_iterations, double confidence, uint64_t seed)
+        {
+            if (points_a.shape(1) != 2 || points_b.shape(1) != 2)
+                throw std::invalid_argument("points_a and points_b must have shape (N, 2) of (row, col)");
+            const size_t n = points_a.shape(0);
+            require_same_length(points_b.shape(0), n, "points_a and points_b");
+
+            p2b::RotationRansac ransac{p2b::ImageSize{w, h}, p2b::PixelToTan{p2t}};
+            p2b::RotationRansacResult result;
+            auto mask = std::make_unique_for_overwrite<bool[]>(n);
+            {
+                nb::gil_scoped_release release;
+                std::vector<std::array<double, 2>> a(n);
+                std::vector<std::array<double, 2>> b(n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const double *pa = points_a.data() + static_cast<int64_t>(i) * points_a.stride(0);
+                    const double *pb = points_b.data() + static_cast<int64_t>(i) * points_b.stride(0);
+                    a[i] = {pa[0], pa[points_a.stride(1)]};
+                    b[i] = {pb[0], pb[points_b.stride(1)]};
+                }
+                result = ransac.estimate(a, b, p2b::RansacOptions{threshold_px, max_iterations, confidence, seed});
+                const auto inliers = ransac.inlier_mask();
+                for (size_t i = 0; i < n; ++i)
+                    mask[i] = inliers[i] != 0;
+            }
+            return std::make_tuple(make_quat(result.rotation), batch_output(std::move(mask), n), result.iterations);
+        },
+        "points_a"_a, "points_b"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "threshold_px"_a = 1.0,
+        "max_iterations"_a = 256, "confidence"_a = 0.999, "seed"_a = 0,
+        "Outlier-robust estimate_rotation: (rotation [w,x,y,z], (N,) inlier mask, hypotheses drawn).");
+
+    m.def(
+        "attitude_after_rotation",
+        [](QuatIn q_old, QuatIn cam, QuatIn rotation)
+        { return make_quat(p2b::attitude_after_rotation(to_quat(q_old), to_quat(cam), to_quat(rotation))); },
+        "q_old"_a, "cam_to_body"_a, "rotation"_a,
+        "Body attitude [w,x,y,z] after a measured camera-frame rotation (see estimate_rotation).");
+
+    // ---- Installation calibration (calibration.hpp) ----
+    // Levenberg-Marquardt over (attitude, pixel, known NED direction) observations; each
+    // iteration's normal-equation pass is split across threads (see CalibrationOptions::threads)
+    // without the GIL.
+
+    m.def(
+        "calibrate_cam_to_body",
+        [](F64_2D attitudes, F64_2D pixels, F64_2D dirs, uint64_t w, uint64_t h, double p2t,
+           std::optional<QuatIn> initial, bool estimate_p2t, size_t max_iterations, size_t threads)
+        {
+            const size_t n = pixels.shape(0);
+            if (pixels.shape(1) != 2)
+                throw std::invalid_argument("pixels must have shape (N, 2) of (row, col)");
+            require_same_length(dirs.shape(0), n, "pixels and dirs_ned");
+            const auto qa = quat_rows(attitudes, n, "attitudes");
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const p2b::ImageSize img{w, h};
+            const std::optional<p2b::Quaternion> start =
+                initial ? std::optional{to_quat(*initial)} : std::nullopt;
+            p2b::CalibrationOptions options;
+            options.estimate_pixel_to_tan = estimate_p2t;
+            options.max_iterations = max_iterations;
+            options.threads = threads;
+
+            p2b::CalibrationResult result;
+            {
+                nb::gil_scoped_release release;
+                std::vector<p2b::CalibrationObservation> obs(n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const double *px = pixels.data() + static_cast<int64_t>(i) * pixels.stride(0);
+                    obs[i] = {qa[i], px[0], px[pixels.stride(1)], vecs[i]};
+                }
+                result = p2b::calibrate_cam_to_body(obs, img, p2b::PixelToTan{p2t}, start, options);
+            }
+            return std::make_tuple(make_quat(result.cam_to_body), result.pixel_to_tan.get(), result.rms_px,
+                                   result.used, result.converged);
+        },
+        "attitudes"_a, "pixels"_a, "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "initial"_a.none(),
+        "estimate_pixel_to_tan"_a = false, "max_iterations"_a = 50, "threads"_a = 0,
+        "Calibrate cam_to_body -> (cam_to_body [w,x,y,z], pixel_to_tan, rms_px, used, converged).");
+
+    // ---- Gimbal joint chain (gimbal.hpp): one (pan, tilt, roll) row per frame ----
+    // Rows are streamed through a GimbalChain, so joints that hold still between consecutive
+    // rows cost no trig.
+
+    m.def(
+        "gimbal_cam_to_body",
+        [](double pan, double tilt, double roll, QuatIn base, QuatIn sensor)
+        {
+            return make_quat(p2b::gimbal_cam_to_body({to_quat(base), to_quat(sensor)},
+                                                     {p2b::Radians{pan}, p2b::Radians{tilt}, p2b::Radians{roll}}));
+        },
+        "pan_rad"_a, "tilt_rad"_a, "roll_rad"_a, "base"_a, "sensor"_a,
+        "Camera-to-body quaternion [w,x,y,z] of a pan/tilt/roll gimbal.");
+
+    m.def(
+        "gimbal_cam_to_body_batch",
+        [](F64_2D joints, QuatIn base, QuatIn sensor)
+        {
+            const size_t n = joints.shape(0);
+            const auto angles = vec3_rows(joints, "joint_angles");
+            p2b::GimbalChain chain({to_quat(base), to_quat(sensor)});
+            auto *out = new double[n * 4];
+            for (size_t i = 0; i < n; ++i)
+            {
+                chain.set_angles(to_gimbal_angles(angles[i]));
+                const auto &q = chain.cam_to_body();
+                out[i * 4] = q.w;
+                out[i * 4 + 1] = q.x;
+                out[i * 4 + 2] = q.y;
+                out[i * 4 + 3] = q.z;
+            }
+            return batch_output(out, n, 4);
+        },
+        "joint_angles"_a, "base"_a, "sensor"_a,
+        "Batch gimbal camera-to-body quaternions from (N,3) [pan, tilt, roll]. Returns (N,4) array.");
+
+    m.def(
+        "pixel_to_ned_batch_gimbal",
+        [](IndexIn rows, std::optional<IndexIn> cols, uint64_t w, uint64_t h, double p2t, F64_2D joints,
+           F64_2D atts, QuatIn base, QuatIn sensor)
+        {
+            const auto px = pixel_pairs(rows, cols);
+            const size_t n = px.n;
+            require_same_length(joints.shape(0), n, "pixels and joint_angles");
+            const auto angles = vec3_rows(joints, "joint_angles");
+            const auto qa = quat_rows(atts, n, "attitudes");
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            p2b::GimbalChain chain({to_quat(base), to_quat(sensor)});
+
+            auto *out = new double[n * 3];
+            px.visit(
+                [&](auto r, auto c)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        chain.set_angles(to_gimbal_angles(angles[i]));
+                        const auto ned = p2b::pixel_to_ned(p2b::PixelIndex{r[i]}, p2b::PixelIndex{c[i]}, img, pt,
+                                                           chain.cam_to_body(), qa[i]);
+                        out[i * 3] = ned.x;
+                        out[i * 3 + 1] = ned.y;
+                        out[i * 3 + 2] = ned.z;
+                    }
+                });
+            return batch_output(out, n, 3);
+        },
+        "rows"_a, "cols"_a.none(), "width"_a, "height"_a, "pixel_to_tan"_a, "joint_angles"_a, "attitudes"_a, "base"_a,
+        "sensor"_a, "Batch pixels -> NED directions, gimbal joints and attitude per point. Returns (N,3) array.");
+
+    m.def(
+        "ned_to_pixel_batch_gimbal",
+        [](F64_2D dirs, uint64_t w, uint64_t h, double p2t, F64_2D joints, F64_2D atts, QuatIn base, QuatIn sensor)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            require_same_length(joints.shape(0), n, "dirs_ned and joint_angles");
+            const auto angles = vec3_rows(joints, "joint_angles");
+            const auto qa = quat_rows(atts, n, "attitudes");
+            const p2b::ImageSize img{w, h};
+            const p2b::PixelToTan pt{p2t};
+            p2b::GimbalChain chain({to_quat(base), to_quat(sensor)});
+
+            auto *out = new uint64_t[n * 2];
+            for (size_t i = 0; i < n; ++i)
+            {
+                chain.set_angles(to_gimbal_angles(angles[i]));
+                auto [row, col] = p2b::ned_to_pixel(vecs[i], img, pt, chain.cam_to_body(), qa[i]);
+                out[i * 2] = row.value();
+                out[i * 2 + 1] = col.value();
+            }
+            return batch_output(out, n, 2);
+        },
+        "dirs_ned"_a, "width"_a, "height"_a, "pixel_to_tan"_a, "joint_angles"_a, "attitudes"_a, "base"_a, "sensor"_a,
+        "Batch NED directions -> pixels, gimbal joints and attitude per point. Returns (N,2) uint64 array.");
+
+    m.def(
+        "point_gimbal",
+        [](Vec3In dir, QuatIn att, QuatIn base, QuatIn sensor, Vec3In current, double pan_min, double pan_max,
+           double tilt_min, double tilt_max)
+        {
+            const p2b::GimbalPointing pointing({to_quat(base), to_quat(sensor)}, to_quat(att),
+                                               to_gimbal_angles(to_vec3(current)),
+                                               to_gimbal_limits(pan_min, pan_max, tilt_min, tilt_max));
+            const auto result = pointing.solve(to_vec3(dir));
+            const auto &a = result.angles;
+            return std::make_tuple(Vec3T{a.pan.value(), a.tilt.value(), a.roll.value()}, result.reachable);
+        },
+        "dir_ned"_a, "attitude"_a, "base"_a, "sensor"_a, "current"_a, "pan_min"_a, "pan_max"_a, "tilt_min"_a,
+        "tilt_max"_a, "Gimbal joints centering a NED direction -> ((pan, tilt, roll), reachable).");
+
+    m.def(
+        "point_gimbal_batch",
+        [](F64_2D dirs, QuatIn att, QuatIn base, QuatIn sensor, Vec3In current, double pan_min, double pan_max,
+           double tilt_min, double tilt_max)
+        {
+            const size_t n = dirs.shape(0);
+            const auto vecs = vec3_rows(dirs, "dirs_ned");
+            const p2b::GimbalPointing pointing({to_quat(base), to_quat(sensor)}, to_quat(att),
+                                               to_gimbal_angles(to_vec3(current)),
+                                               to_gimbal_limits(pan_min, pan_max, tilt_min, tilt_max));
+            auto angles = std::make_unique_for_overwrite<double[]>(n * 3);
+            auto reachable = std::make_unique_for_overwrite<bool[]>(n);
+            {
+                nb::gil_scoped_release release;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const auto result = pointing.solve(vecs[i]);
+                    angles[i * 3] = result.angles.pan.value();
+                    angles[i * 3 + 1] = result.angles.tilt.value();
+                    angles[i * 3 + 2] = result.angles.roll.value();
+                    reachable[i] = result.reachable;
+                }
+            }
+            return std::make_tuple(batch_output(std::move(angles), n, 3), batch_output(std::move(reachable), n));
+        },
+        "dirs_ned"_a, "attitude"_a, "base"_a, "sensor"_a, "current"_a, "pan_min"_a, "pan_max"_a, "tilt_min"_a,
+        "tilt_max"_a, "Batch gimbal pointing: (N,3) targets -> ((N,3) [pan, tilt, roll], (N,) reachable).");
 }
@@ -2,6 +2,7 @@
 
 All vectors are numpy arrays. Quaternions use [w, x, y, z] convention
 and accept scipy.spatial.transform.Rotation directly.
+For per-call overhead-sensitive code, ``image_to_body_math.fast`` takes and returns plain tuples.
 """
 
 from __future__ import annotations
@@ -10,7 +11,7 @@ from typing import TYPE_CHECKING
 
 import numpy as np
 
-from . import _core
+from . import _core, fast
 
 if TYPE_CHECKING:
     from numpy.typing import NDArray
@@ -22,22 +23,28 @@ except ImportError:
 
 # Re-export ImageSize
 ImageSize = _core.ImageSize
+MaskSide = _core.MaskSide
+Interpolation = _core.Interpolation
 
 
 # ---- Quaternion / Vector helpers ----
 
+def _is_scipy_rotation(q) -> bool:
+    """True for scipy.spatial.transform.Rotation, without importing scipy."""
+    return any(c.__name__ == "Rotation" and c.__module__.startswith("scipy.") for c in type(q).__mro__)
+
+
 def _to_wxyz(q) -> np.ndarray:
     """Convert quaternion-like to contiguous [w, x, y, z] float64 array.
 
     Accepts numpy array (4,), scipy Rotation, or sequence.
+    A contiguous float64 (4,) array is returned as-is.
     """
-    try:
-        from scipy.spatial.transform import Rotation
-        if isinstance(q, Rotation):
-            xyzw = q.as_quat()
-            return np.array([xyzw[3], xyzw[0], xyzw[1], xyzw[2]], dtype=np.float64)
-    except ImportError:
-        pass
+    if type(q) is np.ndarray and q.shape == (4,) and q.dtype == np.float64 and q.flags.c_contiguous:
+        return q
+    if _is_scipy_rotation(q):
+        xyzw = q.as_quat()
+        return np.array([xyzw[3], xyzw[0], xyzw[1], xyzw[2]], dtype=np.float64)
 
     arr = np.asarray(q, dtype=np.float64)
     if arr.shape != (4,):
@@ -47,12 +54,87 @@ def _to_wxyz(q) -> np.ndarray:
 
 def _to_vec3(v) -> np.ndarray:
     """Convert vector-like to contiguous (3,) float64 array."""
+    if type(v) is np.ndarray and v.shape == (3,) and v.dtype == np.float64 and v.flags.c_contiguous:
+        return v
     arr = np.asarray(v, dtype=np.float64)
     if arr.shape != (3,):
         raise ValueError(f"Vector must have shape (3,), got {arr.shape}")
     return np.ascontiguousarray(arr)
 
 
+# Batch inputs are read in place by the core: any strides, and for pixel indices any of
+# these dtypes. Arrays from other frameworks (PyTorch, JAX, ...) are handed over as-is and
+# imported via DLPack. Only inputs outside that set (lists, other dtypes) are converted here.
+_INDEX_DTYPES = frozenset(np.dtype(t) for t in (np.uint16, np.int32, np.uint32, np.int64, np.uint64))
+
+
+def _is_foreign_array(a) -> bool:
+    """CPU tensor of another framework, imported zero-copy by the core via ``__dlpack__``."""
+    return not isinstance(a, np.ndarray) and hasattr(a, "__dlpack__")
+
+
+def _index(a):
+    """Pixel indices: supported integer arrays and buffers pass through (views included), others become uint64."""
+    if _is_foreign_array(a):
+        return a
+    arr = np.asarray(a)
+    if arr.dtype in _INDEX_DTYPES:
+        return arr
+    return arr.astype(np.uint64)
+
+
+def _index_pair(rows, cols):
+    """(rows, cols) with a common dtype; cols=None passes rows through as an (N, 2) array."""
+    rows = _index(rows)
+    if cols is None:
+        return rows, None
+    cols = _index(cols)
+    if _is_foreign_array(rows) or _is_foreign_array(cols):
+        return rows, cols  # dtypes are checked by the core
+    if rows.dtype != cols.dtype:
+        common = np.promote_types(rows.dtype, cols.dtype)
+        common = common if common in _INDEX_DTYPES else np.dtype(np.uint64)
+        rows, cols = rows.astype(common, copy=False), cols.astype(common, copy=False)
+    return rows, cols
+
+
+def _f64(a):
+    """float64 array; float64 views of any stride and foreign CPU tensors are passed without a copy."""
+    if _is_foreign_array(a):
+        return a
+    return np.asarray(a, dtype=np.float64)
+
+
+def _to_wxyz_many(q):
+    """One rotation -> (4,) like _to_wxyz; many -> (N, 4) [w, x, y, z].
+
+    Many rotations are an (N, 4) array (read in place, strided views included) or a
+    scipy Rotation holding N rotations (converted in one vectorized step).
+    """
+    if _is_scipy_rotation(q):
+        if q.single:
+            return _to_wxyz(q)
+        return np.roll(q.as_quat(), 1, axis=1)  # [x, y, z, w] -> [w, x, y, z]
+    if _is_foreign_array(q) and getattr(q, "ndim", 1) == 2:
+        return q
+    arr = np.asarray(q, dtype=np.float64)
+    if arr.ndim == 2:
+        if arr.shape[1] != 4:
+            raise ValueError(f"Quaternions must have shape (N, 4), got {arr.shape}")
+        return arr
+    return _to_wxyz(arr)
+
+
+def to_dlpack(array):
+    """DLPack capsule sharing the memory of a batch result (or any CPU array), without copying.
+
+    Batch results are numpy arrays, which also implement ``__dlpack__``, so
+    ``torch.from_dlpack(result)`` and ``jax.dlpack.from_dlpack(result)`` work directly;
+    this is for consumers that take a raw capsule.
+    """
+    return np.asarray(array).__dlpack__()
+
+
 # ============================================================
 #  1D pixel-tangent conversions
 # ============================================================
@@ -169,6 +251,60 @@ def pixel_after_rotation(
         _to_wxyz(cam_to_body), _to_wxyz(q_old), _to_wxyz(q_new), round_back)
 
 
+def predict_pixel_motion(
+    row: float, col: float, width: int, height: int,
+    pixel_to_tan: float, cam_to_body, body_rates, dt: float,
+    max_error_px: float = 0.1,
+) -> tuple[float, float, float, bool]:
+    """Pixel displacement over dt from body angular rates (rad/s, body axes).
+
+    Returns (d_row, d_col, error_px, exact): a first-order (small-angle) prediction with its
+    estimated error; above max_error_px the exact rotation is used and ``exact`` is True.
+    """
+    return _core.predict_pixel_motion(
+        row, col, width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_vec3(body_rates), dt, max_error_px)
+
+
+def ned_to_pixel_jacobian(
+    ned, width: int, height: int, pixel_to_tan: float, cam_to_body, attitude,
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]:
+    """Projection with analytic Jacobians.
+
+    Returns (pixel (2,), d_dir (2, 3), d_attitude (2, 3)): the continuous (row, col) that
+    ``ned_to_pixel`` truncates, its derivative with respect to the NED direction, and with
+    respect to a body-frame small-angle attitude error phi (attitude * exp(phi)).
+    """
+    pixel, d_dir, d_att = _core.ned_to_pixel_jacobian(
+        _to_vec3(ned), width, height, pixel_to_tan, _to_wxyz(cam_to_body), _to_wxyz(attitude))
+    return np.asarray(pixel), np.asarray(d_dir), np.asarray(d_att)
+
+
+def pixel_after_rotation_jacobian(
+    row: int, col: int, width: int, height: int,
+    pixel_to_tan: float, cam_to_body, q_old, q_new,
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]:
+    """Rotation compensation with analytic Jacobians.
+
+    Returns (pixel (2,), d_q_old (2, 3), d_q_new (2, 3)): the continuous position
+    ``pixel_after_rotation`` truncates or rounds, and its derivatives with respect to body-frame
+    small-angle errors of q_old and q_new.
+    """
+    pixel, d_old, d_new = _core.pixel_after_rotation_jacobian(
+        row, col, width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(q_old), _to_wxyz(q_new))
+    return np.asarray(pixel), np.asarray(d_old), np.asarray(d_new)
+
+
+
+def attitude_after_rotation(q_old, cam_to_body, rotation) -> NDArray[np.float64]:
+    """Body attitude [w,x,y,z] after the camera-frame rotation measured by ``estimate_rotation``.
+
+    q_new = q_old * cam_to_body * rotation^-1 * cam_to_body^-1.
+    """
+    return np.asarray(_core.attitude_after_rotation(
+        _to_wxyz(q_old), _to_wxyz(cam_to_body), _to_wxyz(rotation)))
+
 def is_pixel_inside_frame(row: int, col: int, width: int, height: int, boundary: float) -> bool:
     """Check if pixel is inside frame with safety margin."""
     return _core.is_pixel_inside_frame(row, col, width, height, boundary)
@@ -184,6 +320,11 @@ def is_ned_inside_frame(
         _to_wxyz(cam_to_body), _to_wxyz(attitude), boundary)
 
 
+def ned_at_elevation(dir_ned, elevation: float) -> NDArray[np.float64]:
+    """Re-target NED direction to an elevation (radians), keeping azimuth."""
+    return np.asarray(_core.ned_at_elevation(_to_vec3(dir_ned), elevation))
+
+
 def pixel_at_elevation(
     row: int, col: int, width: int, height: int,
     pixel_to_tan: float, cam_to_body, attitude,
@@ -201,23 +342,213 @@ def ned_angle_in_pixels(ned1, ned2, pixel_to_tan: float) -> float:
 
 
 # ============================================================
-#  Batch (vectorized) — zero-copy numpy arrays
+#  Elevation contours
+# ============================================================
+
+def elevation_contour_at_row(
+    row: int, width: int, height: int,
+    pixel_to_tan: float, cam_to_body, attitude, elevation: float,
+) -> tuple[float, float]:
+    """Col crossings (ascending, NaN if absent) of a row with an elevation contour."""
+    return _core.elevation_contour_at_row(
+        row, width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(attitude), elevation)
+
+
+def elevation_contour_at_col(
+    col: int, width: int, height: int,
+    pixel_to_tan: float, cam_to_body, attitude, elevation: float,
+) -> tuple[float, float]:
+    """Row crossings (ascending, NaN if absent) of a col with an elevation contour."""
+    return _core.elevation_contour_at_col(
+        col, width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(attitude), elevation)
+
+
+def elevation_contour_cols(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude, elevation: float,
+) -> NDArray[np.float64]:
+    """Elevation contour col crossings for every row. Returns (width, 2) float64 array."""
+    return np.asarray(_core.elevation_contour_cols(
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(attitude), elevation))
+
+
+def elevation_contour_rows(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude, elevation: float,
+) -> NDArray[np.float64]:
+    """Elevation contour row crossings for every col. Returns (height, 2) float64 array."""
+    return np.asarray(_core.elevation_contour_rows(
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(attitude), elevation))
+
+
+def horizon_line(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude,
+) -> NDArray[np.float64]:
+    """Horizon col for every row (NaN where absent). Returns (width,) float64 array."""
+    return np.asarray(_core.horizon_line(
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(attitude)))
+
+
+# ============================================================
+#  Sky / ground masks
+# ============================================================
+
+def elevation_mask(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude, threshold: float,
+    margin_px: float = 0.0, side: MaskSide = MaskSide.ABOVE, value: int = 255,
+) -> NDArray[np.uint8]:
+    """Sky/ground mask filled per run. Returns (height, width) uint8 array.
+
+    Pixels on `side` of the elevation threshold (radians) get `value`, others 0.
+    A positive margin_px pulls the boundary about that many pixels into the selected side.
+    """
+    return np.asarray(_core.elevation_mask(
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(attitude), threshold, margin_px, side, value))
+
+
+def elevation_mask_spans(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude, threshold: float,
+    margin_px: float = 0.0, side: MaskSide = MaskSide.ABOVE,
+) -> NDArray[np.uint64]:
+    """Run-length sky/ground mask. Returns (K, 3) uint64 array of [col, row_begin, row_end)."""
+    return np.asarray(_core.elevation_mask_spans(
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(attitude), threshold, margin_px, side))
+
+
+# ============================================================
+#  Camera with prepared state
+# ============================================================
+
+def _quat_tuple(q) -> tuple:
+    """Quaternion-like -> (w, x, y, z) tuple; tuples pass through unchanged."""
+    if type(q) is tuple and len(q) == 4:
+        return q
+    return tuple(_to_wxyz(q).tolist())
+
+
+class Camera(_core.Camera):
+    """Camera intrinsics, installation and current attitude, converted once.
+
+    Scalar methods take and return tuples (like ``fast``); batch methods take
+    and return numpy arrays. Quaternions accept anything ``_to_wxyz`` does,
+    including scipy Rotation. Call ``set_attitude`` once per frame, and ``set_cam_to_body``
+    too when the camera is on a gimbal.
+    """
+
+    def __init__(self, width: int, height: int, pixel_to_tan: float,
+                 cam_to_body, attitude=(1.0, 0.0, 0.0, 0.0)) -> None:
+        super().__init__(width, height, pixel_to_tan, _quat_tuple(cam_to_body), _quat_tuple(attitude))
+
+    def set_attitude(self, attitude) -> None:
+        super().set_attitude(_quat_tuple(attitude))
+
+    def set_cam_to_body(self, cam_to_body) -> None:
+        super().set_cam_to_body(_quat_tuple(cam_to_body))
+
+    def pixel_after_rotation(self, row: int, col: int, q_new, round_back: bool = False) -> tuple[int, int]:
+        return super().pixel_after_rotation(row, col, _quat_tuple(q_new), round_back)
+
+    def pixel_to_ned_batch(self, rows, cols) -> NDArray[np.float64]:
+        return np.asarray(super().pixel_to_ned_batch(*_index_pair(rows, cols)))
+
+    def ned_to_pixel_batch(self, dirs_ned) -> NDArray[np.uint64]:
+        return np.asarray(super().ned_to_pixel_batch(_f64(dirs_ned)))
+
+    def pixel_after_rotation_batch(self, rows, cols, q_new, round_back: bool = False) -> NDArray[np.uint64]:
+        return np.asarray(super().pixel_after_rotation_batch(
+            *_index_pair(rows, cols), _quat_tuple(q_new), round_back))
+
+    def is_inside_batch(self, dirs_ned, boundary: float = 0.0) -> NDArray[np.bool_]:
+        return np.asarray(super().is_inside_batch(_f64(dirs_ned), boundary))
+
+
+class RollingShutterCamera(_core.RollingShutterCamera):
+    """Camera whose lines are read out over time, each at its own interpolated attitude.
+
+    Readout lines are fixed ``col`` values, read from col 0 to col height-1. Call
+    ``set_attitudes`` (first/last line) or ``set_attitude_series`` once per frame; per-line
+    rotations are cached, so projections cost about the same as ``Camera``.
+    """
+
+    def __init__(self, width: int, height: int, pixel_to_tan: float, cam_to_body) -> None:
+        super().__init__(width, height, pixel_to_tan, _quat_tuple(cam_to_body))
+
+    def set_attitudes(self, first_line, last_line) -> None:
+        super().set_attitudes(_quat_tuple(first_line), _quat_tuple(last_line))
+
+    def set_attitude_series(self, samples, sample_interval: float, readout_time: float) -> None:
+        """``samples``: (K, 4) attitudes or a scipy Rotation with K rotations, the first taken
+        when line 0 is read and then every ``sample_interval``; the last line is read
+        ``readout_time`` after the first (same time unit)."""
+        att = _to_wxyz_many(samples)
+        super().set_attitude_series(att.reshape(-1, 4), sample_interval, readout_time)
+
+    def pixel_to_ned_batch(self, rows, cols) -> NDArray[np.float64]:
+        return np.asarray(super().pixel_to_ned_batch(*_index_pair(rows, cols)))
+
+    def ned_to_pixel_batch(self, dirs_ned) -> NDArray[np.uint64]:
+        return np.asarray(super().ned_to_pixel_batch(_f64(dirs_ned)))
+
+    def pixel_after_rotation_batch(self, rows, cols, next_frame: RollingShutterCamera,
+                                   round_back: bool = False) -> NDArray[np.uint64]:
+        """Positions in ``next_frame`` of the directions seen at (rows, cols) in this frame."""
+        return np.asarray(super().pixel_after_rotation_batch(*_index_pair(rows, cols), next_frame, round_back))
+
+
+class AttitudeBuffer(_core.AttitudeBuffer):
+    """Ring buffer of timestamped attitudes with interpolated lookup.
+
+    Feed IMU samples with ``push`` / ``push_batch`` (strictly increasing timestamps, any
+    unit); ``at`` / ``at_batch`` return attitudes at image or event timestamps, ready to pass
+    as the attitude of any function (``at_batch`` gives one attitude per point). Lookups
+    moving forward in time are O(1). Not safe for concurrent use from several threads.
+    """
+
+    def push(self, timestamp: float, attitude) -> bool:
+        return super().push(timestamp, _quat_tuple(attitude))
+
+    def push_batch(self, timestamps, attitudes) -> int:
+        return super().push_batch(_f64(timestamps), _to_wxyz_many(attitudes).reshape(-1, 4))
+
+    def at_batch(self, timestamps, method: Interpolation = Interpolation.SLERP) -> NDArray[np.float64]:
+        """(N,) timestamps -> (N, 4) [w, x, y, z]; raises ValueError outside the buffered span."""
+        return np.asarray(super().at_batch(_f64(timestamps), method))
+
+
+# ============================================================
+#  Batch (vectorized) — zero-copy numpy arrays, strided views included
 # ============================================================
 
 def pixel_to_ned_batch(
-    rows: NDArray[np.uint64], cols: NDArray[np.uint64],
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
     width: int, height: int, pixel_to_tan: float,
     cam_to_body, attitude,
 ) -> NDArray[np.float64]:
     """Batch pixels -> NED directions. Returns (N, 3) float64 array.
 
-    Zero-copy: input arrays are accessed directly without copying.
+    Zero-copy: rows/cols may be strided views and uint16/int32/uint32/int64/uint64;
+    pass an (N, 2) array of (row, col) pairs as ``rows`` with ``cols=None``.
+    The same applies to every batch function taking rows and cols.
+
+    ``attitude`` may also hold one rotation per point: an (N, 4) array or a scipy
+    Rotation with N rotations (likewise for the other batch functions taking an attitude).
     """
-    return np.asarray(_core.pixel_to_ned_batch(
-        np.ascontiguousarray(rows, dtype=np.uint64),
-        np.ascontiguousarray(cols, dtype=np.uint64),
+    att = _to_wxyz_many(attitude)
+    core = _core.pixel_to_ned_batch_per_point if att.ndim == 2 else _core.pixel_to_ned_batch
+    return np.asarray(core(
+        *_index_pair(rows, cols),
         width, height, pixel_to_tan,
-        _to_wxyz(cam_to_body), _to_wxyz(attitude)))
+        _to_wxyz(cam_to_body), att))
 
 
 def ned_to_pixel_batch(
@@ -227,26 +558,278 @@ def ned_to_pixel_batch(
 ) -> NDArray[np.uint64]:
     """Batch NED directions -> pixels. Returns (N, 2) uint64 array.
 
-    Zero-copy: input (N, 3) array is reinterpreted as Vector3* directly.
+    Zero-copy: the (N, 3) float64 input is read in place, strided views included.
     """
-    return np.asarray(_core.ned_to_pixel_batch(
-        np.ascontiguousarray(dirs_ned, dtype=np.float64),
+    att = _to_wxyz_many(attitude)
+    core = _core.ned_to_pixel_batch_per_point if att.ndim == 2 else _core.ned_to_pixel_batch
+    return np.asarray(core(
+        _f64(dirs_ned),
         width, height, pixel_to_tan,
-        _to_wxyz(cam_to_body), _to_wxyz(attitude)))
+        _to_wxyz(cam_to_body), att))
 
 
 def pixel_after_rotation_batch(
-    rows: NDArray[np.uint64], cols: NDArray[np.uint64],
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
     width: int, height: int, pixel_to_tan: float,
     cam_to_body, q_old, q_new,
     round_back: bool = False,
 ) -> NDArray[np.uint64]:
-    """Batch pixel positions after rotation. Returns (N, 2) uint64 array."""
-    return np.asarray(_core.pixel_after_rotation_batch(
-        np.ascontiguousarray(rows, dtype=np.uint64),
-        np.ascontiguousarray(cols, dtype=np.uint64),
+    """Batch pixel positions after rotation. Returns (N, 2) uint64 array.
+
+    q_old and/or q_new may hold one rotation per point; a single one is then broadcast.
+    """
+    q_old, q_new = _to_wxyz_many(q_old), _to_wxyz_many(q_new)
+    if q_old.ndim == 1 and q_new.ndim == 1:
+        return np.asarray(_core.pixel_after_rotation_batch(
+            *_index_pair(rows, cols),
+            width, height, pixel_to_tan,
+            _to_wxyz(cam_to_body), q_old, q_new, round_back))
+    n = (q_old if q_old.ndim == 2 else q_new).shape[0]
+    return np.asarray(_core.pixel_after_rotation_batch_per_point(
+        *_index_pair(rows, cols),
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body),
+        q_old if q_old.ndim == 2 else np.broadcast_to(q_old, (n, 4)),  # stride-0 view, no copy
+        q_new if q_new.ndim == 2 else np.broadcast_to(q_new, (n, 4)),
+        round_back))
+
+
+def pixel_at_elevation_batch(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude, desired_elevation: float,
+) -> NDArray[np.uint64]:
+    """Batch project pixels to target elevation, preserving azimuth. Returns (N, 2) uint64 array."""
+    att = _to_wxyz_many(attitude)
+    core = _core.pixel_at_elevation_batch_per_point if att.ndim == 2 else _core.pixel_at_elevation_batch
+    return np.asarray(core(
+        *_index_pair(rows, cols),
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), att, desired_elevation))
+
+
+def _attitude_rows(attitudes):
+    """(M, 4) [w, x, y, z] from (M, 4) arrays, multi-rotation scipy Rotation or a single quaternion."""
+    att = _to_wxyz_many(attitudes)
+    return att if att.ndim == 2 else att.reshape(1, 4)
+
+
+def predict_pixel_motion_batch(
+    points: NDArray[np.floating],
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, body_rates, dt: float,
+    max_error_px: float = 0.1,
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.bool_]]:
+    """Gyro-seeded displacement of (N, 2) sub-pixel (row, col) points (e.g. KLT features).
+
+    Returns ((N, 2) displacements, (N,) first-order error estimates in pixels, (N,) mask of
+    points that used the exact rotation because their estimate exceeded max_error_px).
+    """
+    motion, error, exact = _core.predict_pixel_motion_batch(
+        _f64(points), width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_vec3(body_rates), dt, max_error_px)
+    return np.asarray(motion), np.asarray(error), np.asarray(exact)
+
+
+def ned_to_pixel_jacobian_batch(
+    dirs_ned: NDArray[np.float64],
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude,
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]:
+    """Batch ``ned_to_pixel_jacobian``: ((N, 2) pixels, (N, 2, 3) d_dir, (N, 2, 3) d_attitude)."""
+    pixel, d_dir, d_att = _core.ned_to_pixel_jacobian_batch(
+        _f64(dirs_ned), width, height, pixel_to_tan, _to_wxyz(cam_to_body), _to_wxyz(attitude))
+    return np.asarray(pixel), np.asarray(d_dir), np.asarray(d_att)
+
+
+def pixel_after_rotation_jacobian_batch(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, q_old, q_new,
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]:
+    """Batch ``pixel_after_rotation_jacobian``: ((N, 2) pixels, (N, 2, 3) d_q_old, (N, 2, 3) d_q_new)."""
+    pixel, d_old, d_new = _core.pixel_after_rotation_jacobian_batch(
+        *_index_pair(rows, cols), width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _to_wxyz(q_old), _to_wxyz(q_new))
+    return np.asarray(pixel), np.asarray(d_old), np.asarray(d_new)
+
+
+
+def estimate_rotation(
+    points_a: NDArray[np.floating], points_b: NDArray[np.floating],
+    width: int, height: int, pixel_to_tan: float,
+    weights: NDArray[np.floating] | None = None,
+) -> NDArray[np.float64]:
+    """Camera-frame rotation [w,x,y,z] from matched (N, 2) sub-pixel (row, col) positions.
+
+    points_a[i] in the first frame and points_b[i] in the second see the same direction. Solves
+    Wahba's problem (least squares over unit rays, optionally weighted) in one pass; at least two
+    non-parallel matches are needed. The result is ``Camera.rotation_to`` of the true attitudes:
+    feed it to ``Camera.pixel_after_rotation`` or ``attitude_after_rotation``.
+    """
+    return np.asarray(_core.estimate_rotation(
+        _f64(points_a), _f64(points_b), width, height, pixel_to_tan,
+        None if weights is None else _f64(weights)))
+
+
+def estimate_rotation_ransac(
+    points_a: NDArray[np.floating], points_b: NDArray[np.floating],
+    width: int, height: int, pixel_to_tan: float,
+    threshold_px: float = 1.0, max_iterations: int = 256, confidence: float = 0.999, seed: int = 0,
+) -> tuple[NDArray[np.float64], NDArray[np.bool_], int]:
+    """Outlier-robust ``estimate_rotation``: RANSAC over 2-match samples, refit on the inliers.
+
+    Matches are inliers when the rotation maps them within threshold_px of their partner.
+    The hypothesis count adapts to the inlier ratio (up to max_iterations); equal inputs and
+    seed give equal results. Returns (rotation [w,x,y,z], (N,) inlier mask, hypotheses drawn);
+    fewer than two inliers means no consistent rotation was found.
+    """
+    rotation, mask, iterations = _core.estimate_rotation_ransac(
+        _f64(points_a), _f64(points_b), width, height, pixel_to_tan,
+        threshold_px, max_iterations, confidence, seed)
+    return np.asarray(rotation), np.asarray(mask), iterations
+
+
+def calibrate_cam_to_body(
+    attitudes, pixels: NDArray[np.floating], dirs_ned: NDArray[np.floating],
+    width: int, height: int, pixel_to_tan: float,
+    initial=None, estimate_pixel_to_tan: bool = False, max_iterations: int = 50, threads: int = 0,
+) -> tuple[NDArray[np.float64], float, float, int, bool]:
+    """Solve the camera installation from observations of known directions.
+
+    Observation i: body attitude attitudes[i] ((N, 4) or a scipy Rotation holding N), the
+    sub-pixel (row, col) pixels[i] where the known NED direction dirs_ned[i] was seen.
+    Levenberg-Marquardt on the reprojection error with analytic derivatives, starting from
+    ``initial`` (a cam_to_body guess) or from a closed-form fit. pixel_to_tan is held fixed
+    unless estimate_pixel_to_tan. Each iteration's pass over the observations runs on
+    ``threads`` threads (0 = all cores) without the GIL.
+
+    Returns (cam_to_body [w,x,y,z], pixel_to_tan, rms_px, observations used, converged).
+    """
+    cam, ptt, rms, used, converged = _core.calibrate_cam_to_body(
+        _attitude_rows(attitudes), _f64(pixels), _f64(dirs_ned), width, height, pixel_to_tan,
+        None if initial is None else _to_wxyz(initial), estimate_pixel_to_tan, max_iterations, threads)
+    return np.asarray(cam), ptt, rms, used, converged
+
+
+_IDENTITY = (1.0, 0.0, 0.0, 0.0)
+
+
+def gimbal_cam_to_body(
+    pan_rad: float, tilt_rad: float, roll_rad: float = 0.0, base=_IDENTITY, sensor=_IDENTITY,
+) -> NDArray[np.float64]:
+    """Camera-to-body quaternion [w, x, y, z] of a pan/tilt/roll gimbal.
+
+    cam_to_body = base * Rz(pan) * Ry(-tilt) * Rx(roll) * sensor: ``base`` mounts the gimbal on
+    the body, ``sensor`` aligns the camera on the roll joint. Positive pan looks right, positive
+    tilt looks down (tilt alone equals cam_to_body_from_angle).
+    """
+    return np.asarray(_core.gimbal_cam_to_body(pan_rad, tilt_rad, roll_rad, _to_wxyz(base), _to_wxyz(sensor)))
+
+
+def gimbal_cam_to_body_batch(joint_angles, base=_IDENTITY, sensor=_IDENTITY) -> NDArray[np.float64]:
+    """(N, 3) [pan, tilt, roll] per frame -> (N, 4) cam_to_body [w, x, y, z] (see gimbal_cam_to_body).
+
+    Only joints that changed since the previous row are recomputed.
+    """
+    return np.asarray(_core.gimbal_cam_to_body_batch(_f64(joint_angles), _to_wxyz(base), _to_wxyz(sensor)))
+
+
+def _gimbal_attitudes(attitude, n: int):
+    """(N, 4) attitudes; a single one is broadcast as a stride-0 view."""
+    att = _to_wxyz_many(attitude)
+    return att if att.ndim == 2 else np.broadcast_to(att, (n, 4))
+
+
+def pixel_to_ned_batch_gimbal(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    joint_angles, attitude, base=_IDENTITY, sensor=_IDENTITY,
+) -> NDArray[np.float64]:
+    """Batch pixels -> NED directions through a gimbal. Returns (N, 3) float64 array.
+
+    Point i was seen at gimbal joints joint_angles[i] ((N, 3) [pan, tilt, roll]) and body attitude
+    attitude[i] (or one attitude for all), so logged frames project without building cam_to_body.
+    """
+    joints = _f64(joint_angles)
+    return np.asarray(_core.pixel_to_ned_batch_gimbal(
+        *_index_pair(rows, cols),
+        width, height, pixel_to_tan,
+        joints, _gimbal_attitudes(attitude, joints.shape[0]), _to_wxyz(base), _to_wxyz(sensor)))
+
+
+def ned_to_pixel_batch_gimbal(
+    dirs_ned: NDArray[np.float64],
+    width: int, height: int, pixel_to_tan: float,
+    joint_angles, attitude, base=_IDENTITY, sensor=_IDENTITY,
+) -> NDArray[np.uint64]:
+    """Batch NED directions -> pixels through a gimbal. Returns (N, 2) uint64 array.
+
+    Joint angles and attitudes as in pixel_to_ned_batch_gimbal.
+    """
+    joints = _f64(joint_angles)
+    return np.asarray(_core.ned_to_pixel_batch_gimbal(
+        _f64(dirs_ned),
+        width, height, pixel_to_tan,
+        joints, _gimbal_attitudes(attitude, joints.shape[0]), _to_wxyz(base), _to_wxyz(sensor)))
+
+
+def point_gimbal(
+    dir_ned, attitude, base=_IDENTITY, sensor=_IDENTITY, current=(0.0, 0.0, 0.0),
+    pan_limits=(-np.pi, np.pi), tilt_limits=(-np.pi / 2, np.pi / 2),
+) -> tuple[tuple[float, float, float], bool]:
+    """Gimbal joints that center a NED direction: ((pan, tilt, roll), reachable).
+
+    Closed-form inverse of gimbal_cam_to_body at the given body attitude. ``current``
+    (pan, tilt, roll) fixes the roll and picks, among the solutions within the joint limits,
+    the one nearest the current pan/tilt. An unreachable target gives the nearest command
+    clamped to the limits with reachable False.
+    """
+    return _core.point_gimbal(
+        _to_vec3(dir_ned), _to_wxyz(attitude), _to_wxyz(base), _to_wxyz(sensor), _to_vec3(current),
+        *pan_limits, *tilt_limits)
+
+
+def point_gimbal_batch(
+    dirs_ned, attitude, base=_IDENTITY, sensor=_IDENTITY, current=(0.0, 0.0, 0.0),
+    pan_limits=(-np.pi, np.pi), tilt_limits=(-np.pi / 2, np.pi / 2),
+) -> tuple[NDArray[np.float64], NDArray[np.bool_]]:
+    """Batch point_gimbal: (N, 3) targets -> ((N, 3) [pan, tilt, roll], (N,) reachable).
+
+    The attitude and mount are prepared once; the loop runs without the GIL.
+    """
+    angles, reachable = _core.point_gimbal_batch(
+        _f64(dirs_ned), _to_wxyz(attitude), _to_wxyz(base), _to_wxyz(sensor), _to_vec3(current),
+        *pan_limits, *tilt_limits)
+    return np.asarray(angles), np.asarray(reachable)
+
+
+def pixel_to_ned_broadcast(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitudes,
+) -> NDArray[np.float64]:
+    """The same N pixels under each of M attitudes -> NED directions. Returns (M, N, 3) array.
+
+    Camera-frame directions are computed once and each attitude is composed once. The core
+    runs without the GIL, so M can be split across threads.
+    """
+    return np.asarray(_core.pixel_to_ned_broadcast(
+        *_index_pair(rows, cols),
+        width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), _attitude_rows(attitudes)))
+
+
+def ned_to_pixel_broadcast(
+    dirs_ned: NDArray[np.float64],
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitudes,
+) -> NDArray[np.uint64]:
+    """The same N NED directions under each of M attitudes -> pixels. Returns (M, N, 2) uint64 array."""
+    return np.asarray(_core.ned_to_pixel_broadcast(
+        _f64(dirs_ned),
         width, height, pixel_to_tan,
-        _to_wxyz(cam_to_body), _to_wxyz(q_old), _to_wxyz(q_new), round_back))
+        _to_wxyz(cam_to_body), _attitude_rows(attitudes)))
 
 
 def warp_image_to_body_batch(
@@ -255,14 +838,124 @@ def warp_image_to_body_batch(
 ) -> NDArray[np.float64]:
     """Batch image tangent pairs -> body-frame directions. Returns (N, 3) array."""
     return np.asarray(_core.warp_image_to_body_batch(
-        np.ascontiguousarray(w_tans, dtype=np.float64),
-        np.ascontiguousarray(h_tans, dtype=np.float64),
+        _f64(w_tans),
+        _f64(h_tans),
         _to_wxyz(cam_to_body)))
 
 
+
+# ---- Batch forms of the 1D conversions (math.hpp) ----
+
+def pixel_tan_from_fov_batch(pixels, width: int, height: int, fov_rad: float) -> NDArray[np.float64]:
+    """Batch pixel index -> angular tangent via FOV. Returns (N,) float64 array."""
+    return np.asarray(_core.pixel_tan_from_fov_batch(_index(pixels), width, height, fov_rad))
+
+
+def tan_to_pixel_by_fov_batch(pixel_tans, width: int, height: int, fov_rad: float) -> NDArray[np.uint64]:
+    """Batch tangent -> pixel index via FOV. Returns (N,) uint64 array."""
+    return np.asarray(_core.tan_to_pixel_by_fov_batch(_f64(pixel_tans), width, height, fov_rad))
+
+
+def pixel_tan_by_pixel_to_tan_batch(pixels, width: int, height: int, pixel_to_tan: float) -> NDArray[np.float64]:
+    """Batch pixel index -> tangent via pixel-to-tan factor. Returns (N,) float64 array."""
+    return np.asarray(_core.pixel_tan_by_pixel_to_tan_batch(_index(pixels), width, height, pixel_to_tan))
+
+
+def angle_tan_to_pixel_batch(angle_tans, width: int, height: int, pixel_to_tan: float) -> NDArray[np.uint64]:
+    """Batch angular tangent -> pixel index. Returns (N,) uint64 array."""
+    return np.asarray(_core.angle_tan_to_pixel_batch(_f64(angle_tans), width, height, pixel_to_tan))
+
+
+def pixel_tan_by_pixel_to_tan_clipped_batch(
+    pixels, width: int, height: int, pixel_to_tan: float, threshold: float,
+) -> NDArray[np.float64]:
+    """Batch pixel -> tangent with dead-zone clipping. Returns (N,) float64 array."""
+    return np.asarray(_core.pixel_tan_by_pixel_to_tan_clipped_batch(
+        _index(pixels), width, height, pixel_to_tan, threshold))
+
+
+def tan_to_pixel_by_pixel_to_tan_batch(
+    pixel_tans, width: int, height: int, pixel_to_tan: float, round_back: bool = False,
+) -> NDArray[np.uint64]:
+    """Batch tangent -> pixel index via pixel-to-tan factor. Returns (N,) uint64 array."""
+    return np.asarray(_core.tan_to_pixel_by_pixel_to_tan_batch(
+        _f64(pixel_tans), width, height, pixel_to_tan, round_back))
+
+
+def pixel_to_tan_from_fov_batch(fovs_rad, width: int, height: int) -> NDArray[np.float64]:
+    """Batch pixel-to-tan factors for many FOVs. Returns (N,) float64 array."""
+    return np.asarray(_core.pixel_to_tan_from_fov_batch(_f64(fovs_rad), width, height))
+
+
+# ---- Batch forms of the body-space functions ----
+
+def cam_to_body_from_angle_batch(angles_rad) -> NDArray[np.float64]:
+    """Batch camera-to-body quaternions [w,x,y,z]. Returns (N, 4) array."""
+    return np.asarray(_core.cam_to_body_from_angle_batch(_f64(angles_rad)))
+
+
+def tangents_to_ned_batch(w_tans, h_tans) -> NDArray[np.float64]:
+    """Batch tangent pairs -> NED directions. Returns (N, 3) array."""
+    return np.asarray(_core.tangents_to_ned_batch(_f64(w_tans), _f64(h_tans)))
+
+
+def ned_to_tangents_batch(neds) -> NDArray[np.float64]:
+    """Batch NED directions -> (w_tan, h_tan) pairs. Returns (N, 2) array."""
+    return np.asarray(_core.ned_to_tangents_batch(_f64(neds)))
+
+
+def ned_to_azimuth_elevation_batch(neds) -> NDArray[np.float64]:
+    """Batch NED directions -> (azimuth, elevation) radians. Returns (N, 2) array."""
+    return np.asarray(_core.ned_to_azimuth_elevation_batch(_f64(neds)))
+
+
+def azimuth_elevation_to_ned_batch(azimuths, elevations) -> NDArray[np.float64]:
+    """Batch azimuth/elevation (radians) -> NED directions. Returns (N, 3) array."""
+    return np.asarray(_core.azimuth_elevation_to_ned_batch(_f64(azimuths), _f64(elevations)))
+
+
+def warp_body_to_image_batch(dirs_body, cam_to_body) -> NDArray[np.float64]:
+    """Batch body-frame directions -> image tangent pairs. Returns (N, 2) array."""
+    return np.asarray(_core.warp_body_to_image_batch(_f64(dirs_body), _to_wxyz(cam_to_body)))
+
+
+def is_pixel_inside_frame_batch(rows, cols, width: int, height: int, boundary: float) -> NDArray[np.bool_]:
+    """Batch pixel-inside-frame check with safety margin. Returns (N,) bool array."""
+    return np.asarray(_core.is_pixel_inside_frame_batch(*_index_pair(rows, cols), width, height, boundary))
+
+
+def is_ned_inside_frame_batch(
+    dirs_ned, width: int, height: int, pixel_to_tan: float,
+    cam_to_body, attitude, boundary: float,
+) -> NDArray[np.bool_]:
+    """Batch NED visibility check. Returns (N,) bool array."""
+    att = _to_wxyz_many(attitude)
+    core = _core.is_ned_inside_frame_batch_per_point if att.ndim == 2 else _core.is_ned_inside_frame_batch
+    return np.asarray(core(
+        _f64(dirs_ned), width, height, pixel_to_tan,
+        _to_wxyz(cam_to_body), att, boundary))
+
+
+def ned_at_elevation_batch(dirs_ned, elevation: float) -> NDArray[np.float64]:
+    """Batch re-target NED directions to an elevation (radians), keeping azimuth. Returns (N, 3) array."""
+    return np.asarray(_core.ned_at_elevation_batch(_f64(dirs_ned), elevation))
+
+
+def ned_angle_in_pixels_batch(neds1, neds2, pixel_to_tan: float) -> NDArray[np.float64]:
+    """Batch angular separation between paired NED vectors as pixel distance. Returns (N,) array."""
+    return np.asarray(_core.ned_angle_in_pixels_batch(_f64(neds1), _f64(neds2), pixel_to_tan))
+
+
 __all__ = [
     "__version__",
     "ImageSize",
+    "MaskSide",
+    "Interpolation",
+    "AttitudeBuffer",
+    "Camera",
+    "RollingShutterCamera",
+    "fast",
+    "to_dlpack",
     "pixel_tan_from_fov",
     "tan_to_pixel_by_fov",
     "pixel_tan_by_pixel_to_tan",
@@ -282,10 +975,54 @@ __all__ = [
     "pixel_after_rotation",
     "is_pixel_inside_frame",
     "is_ned_inside_frame",
+    "ned_at_elevation",
     "pixel_at_elevation",
     "ned_angle_in_pixels",
+    "elevation_contour_at_row",
+    "elevation_contour_at_col",
+    "elevation_contour_cols",
+    "elevation_contour_rows",
+    "horizon_line",
+    "elevation_mask",
+    "elevation_mask_spans",
     "pixel_to_ned_batch",
     "ned_to_pixel_batch",
     "pixel_after_rotation_batch",
+    "pixel_at_elevation_batch",
     "warp_image_to_body_batch",
+    "pixel_to_ned_broadcast",
+    "ned_to_pixel_broadcast",
+    "predict_pixel_motion",
+    "predict_pixel_motion_batch",
+    "ned_to_pixel_jacobian",
+    "pixel_after_rotation_jacobian",
+    "ned_to_pixel_jacobian_batch",
+    "pixel_after_rotation_jacobian_batch",
+    "estimate_rotation",
+    "estimate_rotation_ransac",
+    "attitude_after_rotation",
+    "calibrate_cam_to_body",
+    "gimbal_cam_to_body",
+    "gimbal_cam_to_body_batch",
+    "pixel_to_ned_batch_gimbal",
+    "ned_to_pixel_batch_gimbal",
+    "point_gimbal",
+    "point_gimbal_batch",
+    "pixel_tan_from_fov_batch",
+    "tan_to_pixel_by_fov_batch",
+    "pixel_tan_by_pixel_to_tan_batch",
+    "angle_tan_to_pixel_batch",
+    "pixel_tan_by_pixel_to_tan_clipped_batch",
+    "tan_to_pixel_by_pixel_to_tan_batch",
+    "pixel_to_tan_from_fov_batch",
+    "cam_to_body_from_angle_batch",
+    "tangents_to_ned_batch",
+    "ned_to_tangents_batch",
+    "ned_to_azimuth_elevation_batch",
+    "azimuth_elevation_to_ned_batch",
+    "warp_body_to_image_batch",
+    "is_pixel_inside_frame_batch",
+    "is_ned_inside_frame_batch",
+    "ned_at_elevation_batch",
+    "ned_angle_in_pixels_batch",
 ]
@@ -2,6 +2,8 @@
 
 from __future__ import annotations
 
+import enum
+
 import numpy as np
 from numpy.typing import NDArray
 
@@ -13,6 +15,95 @@ class ImageSize:
     def half_height(self) -> float: ...
     def __repr__(self) -> str: ...
 
+class MaskSide(enum.Enum):
+    ABOVE = ...
+    BELOW = ...
+
+class Camera:
+    def __init__(
+        self, width: int, height: int, pixel_to_tan: float,
+        cam_to_body: tuple[float, float, float, float],
+        attitude: tuple[float, float, float, float] = ...,
+    ) -> None: ...
+    @property
+    def width(self) -> int: ...
+    @property
+    def height(self) -> int: ...
+    @property
+    def pixel_to_tan(self) -> float: ...
+    @property
+    def cam_to_body(self) -> tuple[float, float, float, float]: ...
+    @property
+    def attitude(self) -> tuple[float, float, float, float]: ...
+    def set_attitude(self, attitude: tuple[float, float, float, float]) -> None: ...
+    def set_cam_to_body(self, cam_to_body: tuple[float, float, float, float]) -> None: ...
+    def pixel_to_ned(self, row: int, col: int) -> tuple[float, float, float]: ...
+    def ned_to_pixel(self, dir_ned: tuple[float, float, float]) -> tuple[int, int]: ...
+    def pixel_after_rotation(
+        self, row: int, col: int, q_new: tuple[float, float, float, float], round_back: bool = ...
+    ) -> tuple[int, int]: ...
+    def is_inside(self, dir_ned: tuple[float, float, float], boundary: float = ...) -> bool: ...
+    def pixel_to_ned_batch(self, rows: NDArray[np.integer], cols: NDArray[np.integer] | None) -> NDArray[np.float64]: ...
+    def ned_to_pixel_batch(self, dirs_ned: NDArray[np.float64]) -> NDArray[np.uint64]: ...
+    def pixel_after_rotation_batch(
+        self, rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+        q_new: tuple[float, float, float, float], round_back: bool = ...,
+    ) -> NDArray[np.uint64]: ...
+    def is_inside_batch(self, dirs_ned: NDArray[np.float64], boundary: float = ...) -> NDArray[np.bool_]: ...
+    def __repr__(self) -> str: ...
+
+class RollingShutterCamera:
+    def __init__(
+        self, width: int, height: int, pixel_to_tan: float, cam_to_body: tuple[float, float, float, float]
+    ) -> None: ...
+    @property
+    def width(self) -> int: ...
+    @property
+    def height(self) -> int: ...
+    @property
+    def pixel_to_tan(self) -> float: ...
+    @property
+    def cam_to_body(self) -> tuple[float, float, float, float]: ...
+    def set_attitudes(
+        self, first_line: tuple[float, float, float, float], last_line: tuple[float, float, float, float]
+    ) -> None: ...
+    def set_attitude_series(
+        self, samples: NDArray[np.float64], sample_interval: float, readout_time: float
+    ) -> None: ...
+    def line_attitude(self, col: int) -> tuple[float, float, float, float]: ...
+    def pixel_to_ned(self, row: int, col: int) -> tuple[float, float, float]: ...
+    def ned_to_pixel(self, dir_ned: tuple[float, float, float]) -> tuple[int, int]: ...
+    def pixel_after_rotation(
+        self, row: int, col: int, next_frame: RollingShutterCamera, round_back: bool = ...
+    ) -> tuple[int, int]: ...
+    def pixel_to_ned_batch(self, rows: NDArray[np.integer], cols: NDArray[np.integer] | None) -> NDArray[np.float64]: ...
+    def ned_to_pixel_batch(self, dirs_ned: NDArray[np.float64]) -> NDArray[np.uint64]: ...
+    def pixel_after_rotation_batch(
+        self, rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+        next_frame: RollingShutterCamera, round_back: bool = ...,
+    ) -> NDArray[np.uint64]: ...
+    def __repr__(self) -> str: ...
+
+class Interpolation(enum.Enum):
+    SLERP = ...
+    NLERP = ...
+
+class AttitudeBuffer:
+    def __init__(self, capacity: int) -> None: ...
+    def __len__(self) -> int: ...
+    @property
+    def capacity(self) -> int: ...
+    @property
+    def span(self) -> tuple[float, float] | None: ...
+    def clear(self) -> None: ...
+    def push(self, timestamp: float, attitude: tuple[float, float, float, float]) -> bool: ...
+    def push_batch(self, timestamps: NDArray[np.float64], attitudes: NDArray[np.float64]) -> int: ...
+    def at(
+        self, timestamp: float, method: Interpolation = ...
+    ) -> tuple[float, float, float, float] | None: ...
+    def at_batch(self, timestamps: NDArray[np.float64], method: Interpolation = ...) -> NDArray[np.float64]: ...
+    def __repr__(self) -> str: ...
+
 # 1D pixel-tangent conversions
 def pixel_tan_from_fov(pixel: int, width: int, height: int, fov_rad: float) -> float: ...
 def tan_to_pixel_by_fov(pixel_tan: float, width: int, height: int, fov_rad: float) -> int: ...
@@ -64,6 +155,7 @@ def is_ned_inside_frame(
     cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
     boundary: float,
 ) -> bool: ...
+def ned_at_elevation(dir_ned: NDArray[np.float64], elevation: float) -> NDArray[np.float64]: ...
 def pixel_at_elevation(
     row: int, col: int, width: int, height: int,
     pixel_to_tan: float,
@@ -74,9 +166,47 @@ def ned_angle_in_pixels(
     ned1: NDArray[np.float64], ned2: NDArray[np.float64], pixel_to_tan: float
 ) -> float: ...
 
+# Elevation contours
+def elevation_contour_at_row(
+    row: int, width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+    elevation: float,
+) -> tuple[float, float]: ...
+def elevation_contour_at_col(
+    col: int, width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+    elevation: float,
+) -> tuple[float, float]: ...
+def elevation_contour_cols(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+    elevation: float,
+) -> NDArray[np.float64]: ...
+def elevation_contour_rows(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+    elevation: float,
+) -> NDArray[np.float64]: ...
+def horizon_line(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+) -> NDArray[np.float64]: ...
+
+# Sky / ground masks
+def elevation_mask(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+    threshold: float, margin_px: float = ..., side: MaskSide = ..., value: int = ...,
+) -> NDArray[np.uint8]: ...
+def elevation_mask_spans(
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+    threshold: float, margin_px: float = ..., side: MaskSide = ...,
+) -> NDArray[np.uint64]: ...
+
 # Batch operations
 def pixel_to_ned_batch(
-    rows: NDArray[np.uint64], cols: NDArray[np.uint64],
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
     width: int, height: int, pixel_to_tan: float,
     cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
 ) -> NDArray[np.float64]: ...
@@ -86,13 +216,177 @@ def ned_to_pixel_batch(
     cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
 ) -> NDArray[np.uint64]: ...
 def pixel_after_rotation_batch(
-    rows: NDArray[np.uint64], cols: NDArray[np.uint64],
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
     width: int, height: int, pixel_to_tan: float,
     cam_to_body: NDArray[np.float64],
     q_old: NDArray[np.float64], q_new: NDArray[np.float64],
     round_back: bool = ...,
 ) -> NDArray[np.uint64]: ...
+def pixel_at_elevation_batch(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+    desired_elevation: float,
+) -> NDArray[np.uint64]: ...
 def warp_image_to_body_batch(
     w_tans: NDArray[np.float64], h_tans: NDArray[np.float64],
     cam_to_body: NDArray[np.float64],
 ) -> NDArray[np.float64]: ...
+
+# Batch forms of the 1D conversions
+def pixel_tan_from_fov_batch(
+    pixels: NDArray[np.integer], width: int, height: int, fov_rad: float
+) -> NDArray[np.float64]: ...
+def tan_to_pixel_by_fov_batch(
+    pixel_tans: NDArray[np.float64], width: int, height: int, fov_rad: float
+) -> NDArray[np.uint64]: ...
+def pixel_tan_by_pixel_to_tan_batch(
+    pixels: NDArray[np.integer], width: int, height: int, pixel_to_tan: float
+) -> NDArray[np.float64]: ...
+def angle_tan_to_pixel_batch(
+    angle_tans: NDArray[np.float64], width: int, height: int, pixel_to_tan: float
+) -> NDArray[np.uint64]: ...
+def pixel_tan_by_pixel_to_tan_clipped_batch(
+    pixels: NDArray[np.integer], width: int, height: int, pixel_to_tan: float, threshold: float
+) -> NDArray[np.float64]: ...
+def tan_to_pixel_by_pixel_to_tan_batch(
+    pixel_tans: NDArray[np.float64], width: int, height: int, pixel_to_tan: float, round_back: bool = ...
+) -> NDArray[np.uint64]: ...
+def pixel_to_tan_from_fov_batch(fovs_rad: NDArray[np.float64], width: int, height: int) -> NDArray[np.float64]: ...
+
+# Batch forms of the body-space functions
+def cam_to_body_from_angle_batch(angles_rad: NDArray[np.float64]) -> NDArray[np.float64]: ...
+def tangents_to_ned_batch(w_tans: NDArray[np.float64], h_tans: NDArray[np.float64]) -> NDArray[np.float64]: ...
+def ned_to_tangents_batch(neds: NDArray[np.float64]) -> NDArray[np.float64]: ...
+def ned_to_azimuth_elevation_batch(neds: NDArray[np.float64]) -> NDArray[np.float64]: ...
+def azimuth_elevation_to_ned_batch(
+    azimuths: NDArray[np.float64], elevations: NDArray[np.float64]
+) -> NDArray[np.float64]: ...
+def warp_body_to_image_batch(
+    dirs_body: NDArray[np.float64], cam_to_body: NDArray[np.float64]
+) -> NDArray[np.float64]: ...
+def is_pixel_inside_frame_batch(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None, width: int, height: int, boundary: float
+) -> NDArray[np.bool_]: ...
+def is_ned_inside_frame_batch(
+    dirs_ned: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64], boundary: float,
+) -> NDArray[np.bool_]: ...
+def ned_at_elevation_batch(dirs_ned: NDArray[np.float64], elevation: float) -> NDArray[np.float64]: ...
+def ned_angle_in_pixels_batch(
+    neds1: NDArray[np.float64], neds2: NDArray[np.float64], pixel_to_tan: float
+) -> NDArray[np.float64]: ...
+
+# Per-point attitudes: one (N, 4) quaternion per point
+def pixel_to_ned_batch_per_point(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitudes: NDArray[np.float64],
+) -> NDArray[np.float64]: ...
+def ned_to_pixel_batch_per_point(
+    dirs_ned: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitudes: NDArray[np.float64],
+) -> NDArray[np.uint64]: ...
+def pixel_after_rotation_batch_per_point(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], q_old: NDArray[np.float64], q_new: NDArray[np.float64],
+    round_back: bool = ...,
+) -> NDArray[np.uint64]: ...
+def pixel_at_elevation_batch_per_point(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitudes: NDArray[np.float64],
+    desired_elevation: float,
+) -> NDArray[np.uint64]: ...
+def is_ned_inside_frame_batch_per_point(
+    dirs_ned: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitudes: NDArray[np.float64], boundary: float,
+) -> NDArray[np.bool_]: ...
+
+# Broadcast: M attitudes x N points
+def pixel_to_ned_broadcast(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None,
+    width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitudes: NDArray[np.float64],
+) -> NDArray[np.float64]: ...
+def ned_to_pixel_broadcast(
+    dirs_ned: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitudes: NDArray[np.float64],
+) -> NDArray[np.uint64]: ...
+
+# Gyro-rate pixel-motion prediction
+def predict_pixel_motion(
+    row: float, col: float, width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], body_rates: NDArray[np.float64], dt: float, max_error_px: float = ...,
+) -> tuple[float, float, float, bool]: ...
+def predict_pixel_motion_batch(
+    points: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], body_rates: NDArray[np.float64], dt: float, max_error_px: float = ...,
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.bool_]]: ...
+
+# Analytic Jacobians
+def ned_to_pixel_jacobian(
+    dir_ned: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]: ...
+def ned_to_pixel_jacobian_batch(
+    dirs_ned: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], attitude: NDArray[np.float64],
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]: ...
+def pixel_after_rotation_jacobian(
+    row: int, col: int, width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], q_old: NDArray[np.float64], q_new: NDArray[np.float64],
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]: ...
+def pixel_after_rotation_jacobian_batch(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None, width: int, height: int, pixel_to_tan: float,
+    cam_to_body: NDArray[np.float64], q_old: NDArray[np.float64], q_new: NDArray[np.float64],
+) -> tuple[NDArray[np.float64], NDArray[np.float64], NDArray[np.float64]]: ...
+
+# Rotation from pixel correspondences
+def estimate_rotation(
+    points_a: NDArray[np.float64], points_b: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    weights: NDArray[np.float64] | None,
+) -> NDArray[np.float64]: ...
+def estimate_rotation_ransac(
+    points_a: NDArray[np.float64], points_b: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    threshold_px: float = ..., max_iterations: int = ..., confidence: float = ..., seed: int = ...,
+) -> tuple[NDArray[np.float64], NDArray[np.bool_], int]: ...
+def attitude_after_rotation(
+    q_old: NDArray[np.float64], cam_to_body: NDArray[np.float64], rotation: NDArray[np.float64],
+) -> NDArray[np.float64]: ...
+
+# Installation calibration
+def calibrate_cam_to_body(
+    attitudes: NDArray[np.float64], pixels: NDArray[np.float64], dirs_ned: NDArray[np.float64],
+    width: int, height: int, pixel_to_tan: float, initial: NDArray[np.float64] | None,
+    estimate_pixel_to_tan: bool = ..., max_iterations: int = ..., threads: int = ...,
+) -> tuple[NDArray[np.float64], float, float, int, bool]: ...
+
+# Gimbal joint chain
+def gimbal_cam_to_body(
+    pan_rad: float, tilt_rad: float, roll_rad: float, base: NDArray[np.float64], sensor: NDArray[np.float64],
+) -> NDArray[np.float64]: ...
+def gimbal_cam_to_body_batch(
+    joint_angles: NDArray[np.float64], base: NDArray[np.float64], sensor: NDArray[np.float64],
+) -> NDArray[np.float64]: ...
+def pixel_to_ned_batch_gimbal(
+    rows: NDArray[np.integer], cols: NDArray[np.integer] | None, width: int, height: int, pixel_to_tan: float,
+    joint_angles: NDArray[np.float64], attitudes: NDArray[np.float64],
+    base: NDArray[np.float64], sensor: NDArray[np.float64],
+) -> NDArray[np.float64]: ...
+def ned_to_pixel_batch_gimbal(
+    dirs_ned: NDArray[np.float64], width: int, height: int, pixel_to_tan: float,
+    joint_angles: NDArray[np.float64], attitudes: NDArray[np.float64],
+    base: NDArray[np.float64], sensor: NDArray[np.float64],
+) -> NDArray[np.uint64]: ...
+def point_gimbal(
+    dir_ned: NDArray[np.float64], attitude: NDArray[np.float64], base: NDArray[np.float64],
+    sensor: NDArray[np.float64], current: NDArray[np.float64],
+    pan_min: float, pan_max: float, tilt_min: float, tilt_max: float,
+) -> tuple[tuple[float, float, float], bool]: ...
+def point_gimbal_batch(
+    dirs_ned: NDArray[np.float64], attitude: NDArray[np.float64], base: NDArray[np.float64],
+    sensor: NDArray[np.float64], current: NDArray[np.float64],
+    pan_min: float, pan_max: float, tilt_min: float, tilt_max: float,
+) -> tuple[NDArray[np.float64], NDArray[np.bool_]]: ...
@@ -0,0 +1,68 @@
+"""Low-overhead scalar calling convention.
+
+Same functions as the top-level package, but quaternions are plain ``(w, x, y, z)`` tuples
+(or any length-4 sequence), vectors are ``(x, y, z)`` tuples, and results are tuples.
+Calls go straight to the C++ core: no numpy conversion, no ndarray allocation, no
+scipy check. Use this in per-detection loops; use the ``*_batch`` functions for arrays.
+
+    from image_to_body_math import fast
+    cam = fast.cam_to_body_from_angle(0.1)
+    x, y, z = fast.pixel_to_ned(320, 240, 640, 480, p2t, cam, (1.0, 0.0, 0.0, 0.0))
+"""
+
+from __future__ import annotations
+
+from . import _core
+
+_fast = _core.fast
+
+# Already scalar-only in the core module
+pixel_tan_from_fov = _core.pixel_tan_from_fov
+tan_to_pixel_by_fov = _core.tan_to_pixel_by_fov
+pixel_tan_by_pixel_to_tan = _core.pixel_tan_by_pixel_to_tan
+angle_tan_to_pixel = _core.angle_tan_to_pixel
+pixel_tan_by_pixel_to_tan_clipped = _core.pixel_tan_by_pixel_to_tan_clipped
+tan_to_pixel_by_pixel_to_tan = _core.tan_to_pixel_by_pixel_to_tan
+pixel_to_tan_from_fov = _core.pixel_to_tan_from_fov
+is_pixel_inside_frame = _core.is_pixel_inside_frame
+
+# Tuple convention
+cam_to_body_from_angle = _fast.cam_to_body_from_angle
+tangents_to_ned = _fast.tangents_to_ned
+ned_to_tangents = _fast.ned_to_tangents
+ned_to_azimuth_elevation = _fast.ned_to_azimuth_elevation
+azimuth_elevation_to_ned = _fast.azimuth_elevation_to_ned
+warp_image_to_body = _fast.warp_image_to_body
+warp_body_to_image = _fast.warp_body_to_image
+pixel_to_ned = _fast.pixel_to_ned
+ned_to_pixel = _fast.ned_to_pixel
+pixel_after_rotation = _fast.pixel_after_rotation
+is_ned_inside_frame = _fast.is_ned_inside_frame
+ned_at_elevation = _fast.ned_at_elevation
+pixel_at_elevation = _fast.pixel_at_elevation
+ned_angle_in_pixels = _fast.ned_angle_in_pixels
+
+__all__ = [
+    "pixel_tan_from_fov",
+    "tan_to_pixel_by_fov",
+    "pixel_tan_by_pixel_to_tan",
+    "angle_tan_to_pixel",
+    "pixel_tan_by_pixel_to_tan_clipped",
+    "tan_to_pixel_by_pixel_to_tan",
+    "pixel_to_tan_from_fov",
+    "is_pixel_inside_frame",
+    "cam_to_body_from_angle",
+    "tangents_to_ned",
+    "ned_to_tangents",
+    "ned_to_azimuth_elevation",
+    "azimuth_elevation_to_ned",
+    "warp_image_to_body",
+    "warp_body_to_image",
+    "pixel_to_ned",
+    "ned_to_pixel",
+    "pixel_after_rotation",
+    "is_ned_inside_frame",
+    "ned_at_elevation",
+    "pixel_at_elevation",
+    "ned_angle_in_pixels",
+]
@@ -0,0 +1,103 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/attitude_buffer.hpp"
+#include "test_helpers.hpp"
+#include <doctest/doctest.h>
+#include <array>
+#include <cmath>
+
+using namespace p2b;
+using namespace linalg3d;
+using namespace test_helpers;
+
+constexpr double EPSILON = 1e-9;
+
+namespace
+{
+
+void check_quat(const Quaternion &a, const Quaternion &b, double eps = EPSILON)
+{
+    const double s = (a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z) < 0.0 ? -1.0 : 1.0;
+    CHECK(a.w == doctest::Approx(s * b.w).epsilon(eps));
+    CHECK(a.x == doctest::Approx(s * b.x).epsilon(eps));
+    CHECK(a.y == doctest::Approx(s * b.y).epsilon(eps));
+    CHECK(a.z == doctest::Approx(s * b.z).epsilon(eps));
+}
+
+// 1 kHz IMU turning at 10 deg/s: sample k at t = k ms, yaw = k / 100 deg
+AttitudeBuffer imu_buffer(std::size_t capacity, std::size_t samples)
+{
+    AttitudeBuffer buffer(capacity);
+    for (std::size_t k = 0; k < samples; ++k)
+    {
+        buffer.push(static_cast<double>(k) * 1e-3, yaw(static_cast<double>(k) / 100.0));
+    }
+    return buffer;
+}
+
+} // namespace
+
+TEST_CASE("AttitudeBuffer: exact samples and interpolation between them")
+{
+    const auto buffer = imu_buffer(64, 50);
+    check_quat(*buffer.at(0.010), yaw(0.10));
+    check_quat(*buffer.at(0.0105), yaw(0.105));
+    check_quat(*buffer.at(0.049), yaw(0.49));
+    check_quat(*buffer.at(0.0105, Interpolation::NLERP), yaw(0.105), 1e-8);
+}
+
+TEST_CASE("AttitudeBuffer: no extrapolation outside the buffered span")
+{
+    const auto buffer = imu_buffer(64, 50);
+    CHECK_FALSE(buffer.at(-1e-4).has_value());
+    CHECK_FALSE(buffer.at(0.0491).has_value());
+    CHECK_FALSE(AttitudeBuffer(8).at(0.0).has_value());
+}
+
+TEST_CASE("AttitudeBuffer: full ring drops the oldest samples")
+{
+    const auto buffer = imu_buffer(16, 40);
+    CHECK(buffer.size() == 16);
+    CHECK(buffer.oldest().timestamp == doctest::Approx(0.024));
+    CHECK(buffer.newest().timestamp == doctest::Approx(0.039));
+    CHECK_FALSE(buffer.at(0.020).has_value());
+    check_quat(*buffer.at(0.0305), yaw(0.305));
+}
+
+TEST_CASE("AttitudeBuffer: out-of-order samples are rejected")
+{
+    AttitudeBuffer buffer(8);
+    CHECK(buffer.push(1.0, yaw(0.0)));
+    CHECK_FALSE(buffer.push(1.0, yaw(5.0)));
+    CHECK_FALSE(buffer.push(0.5, yaw(5.0)));
+    CHECK(buffer.size() == 1);
+    check_quat(*buffer.at(1.0), yaw(0.0));
+}
+
+TEST_CASE("AttitudeBuffer: lookups in any order agree with the cursor path")
+{
+    auto buffer = imu_buffer(128, 100);
+    // Forward sweep (cursor), then jumps back and forth (binary search)
+    for (const double t : {0.0001, 0.0012, 0.0013, 0.0020, 0.0801, 0.0005, 0.0990, 0.0334, 0.0335})
+    {
+        check_quat(*buffer.at(t), yaw(t * 10.0));
+    }
+    // Keeps working while the ring wraps under the cursor
+    for (std::size_t k = 100; k < 300; ++k)
+    {
+        buffer.push(static_cast<double>(k) * 1e-3, yaw(static_cast<double>(k) / 100.0));
+        const double t = static_cast<double>(k) * 1e-3 - 0.0125;
+        check_quat(*buffer.at(t), yaw(t * 10.0));
+    }
+}
+
+TEST_CASE("AttitudeBuffer: batch lookup")
+{
+    const auto buffer = imu_buffer(64, 50);
+    const std::array<double, 4> times{0.0015, 0.0200, 1.0, 0.0333};
+    std::array<Quaternion, 4> out{};
+    CHECK(buffer.at(times, out) == 3);
+    check_quat(out[0], yaw(0.015));
+    check_quat(out[1], yaw(0.2));
+    check_quat(out[2], Quaternion::identity());
+    check_quat(out[3], yaw(0.333));
+}
@@ -0,0 +1,96 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/attitude_snapshot.hpp"
+#include "image-to-body-math/camera.hpp"
+#include <doctest/doctest.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace p2b;
+using namespace linalg3d;
+
+namespace
+{
+
+// Every field derived from k, so a torn read shows up as fields that disagree
+AttitudeSnapshot snapshot(uint64_t k)
+{
+    const double v = static_cast<double>(k);
+    return AttitudeSnapshot{Quaternion{v, v + 1.0, v + 2.0, v + 3.0}, Quaternion{-v, v, -v, v}, v * 1e-3};
+}
+
+bool consistent(const AttitudeSnapshot &s)
+{
+    const double v = s.cam_to_body.w;
+    return s.cam_to_body.x == v + 1.0 && s.cam_to_body.y == v + 2.0 && s.cam_to_body.z == v + 3.0 &&
+           s.attitude.w == -v && s.attitude.x == v && s.attitude.y == -v && s.attitude.z == v &&
+           s.timestamp == v * 1e-3;
+}
+
+} // namespace
+
+TEST_CASE("SeqLock: load returns the last stored value")
+{
+    AttitudePublisher published{snapshot(0)};
+    CHECK(published.version() == 1);
+    published.store(snapshot(7));
+    const auto s = published.load();
+    CHECK(s.cam_to_body.w == 7.0);
+    CHECK(consistent(s));
+    CHECK(published.version() == 2);
+}
+
+TEST_CASE("SeqLock: holds a prepared Camera")
+{
+    const ImageSize size{1280, 720};
+    const PixelToTan ptt = pixel_to_tan_from_fov(size, Degrees{70}.to_radians());
+    const Quaternion cam_q = cam_to_body_from_angle(Degrees{12}.to_radians());
+    Camera camera(size, ptt, cam_q);
+    SeqLock<Camera> published{camera};
+
+    camera.set_attitude(Quaternion{std::cos(0.1), 0.0, 0.0, std::sin(0.1)});
+    published.store(camera);
+    const auto a = published.load().pixel_to_ned(PixelIndex{100}, PixelIndex{200});
+    const auto b = camera.pixel_to_ned(PixelIndex{100}, PixelIndex{200});
+    CHECK(a.x == b.x);
+    CHECK(a.y == b.y);
+    CHECK(a.z == b.z);
+}
+
+TEST_CASE("SeqLock: concurrent readers never see a torn snapshot")
+{
+    AttitudePublisher published{snapshot(0)};
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> went_back{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back(
+            [&]
+            {
+                double last = 0.0;
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    const auto s = published.load();
+                    torn += consistent(s) ? 0U : 1U;
+                    went_back += s.cam_to_body.w < last ? 1U : 0U;
+                    last = s.cam_to_body.w;
+                }
+            });
+    }
+    for (uint64_t k = 1; k <= 200000; ++k)
+    {
+        published.store(snapshot(k));
+    }
+    done = true;
+    for (auto &t : readers)
+    {
+        t.join();
+    }
+    CHECK(torn.load() == 0);
+    CHECK(went_back.load() == 0);
+    CHECK(published.load().cam_to_body.w == 200000.0);
+}
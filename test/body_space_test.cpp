@@ -289,6 +289,49 @@ TEST_CASE("pixel_at_elevation: preserves azimuth")
     CHECK(new_el.value() == doctest::Approx(Degrees{3}.to_radians().value()).epsilon(0.01));
 }
 
+TEST_CASE("ned_at_elevation: keeps azimuth, sets elevation, stays unit length")
+{
+    const auto ned = azimuth_elevation_to_ned(Radians{0.7}, Radians{-0.2});
+    const auto out = ned_at_elevation(ned, Radians{0.4});
+    auto [az, el] = ned_to_azimuth_elevation(out);
+    CHECK(az.value() == doctest::Approx(0.7).epsilon(EPSILON));
+    CHECK(el.value() == doctest::Approx(0.4).epsilon(EPSILON));
+    CHECK(std::sqrt(out.x * out.x + out.y * out.y + out.z * out.z) == doctest::Approx(1.0).epsilon(EPSILON));
+}
+
+TEST_CASE("ned_at_elevation: vertical input maps to north")
+{
+    const auto out = ned_at_elevation(Vector3{0.0, 0.0, -1.0}, Radians{0.0});
+    CHECK(out.x == doctest::Approx(1.0).epsilon(EPSILON));
+    CHECK(out.y == doctest::Approx(0.0).epsilon(EPSILON));
+    CHECK(out.z == doctest::Approx(0.0).epsilon(EPSILON));
+}
+
+TEST_CASE("pixel_at_elevation: closed form matches azimuth/elevation round trip")
+{
+    const ImageSize size{1920, 1080};
+    const auto ptt = pixel_to_tan_from_fov(size, Degrees{60}.to_radians());
+    const auto cam_q = cam_to_body_from_angle(Degrees{15}.to_radians());
+    const Quaternion att_q{0.9848, 0.0, 0.0, 0.1736}; // ~20 deg yaw
+    const auto target = Degrees{2}.to_radians();
+
+    for (uint64_t row = 100; row < size.width; row += 400)
+    {
+        for (uint64_t col = 100; col < size.height; col += 300)
+        {
+            const auto ned = pixel_to_ned(PixelIndex{row}, PixelIndex{col}, size, ptt, cam_q, att_q);
+            auto [az, el] = ned_to_azimuth_elevation(ned);
+            (void)el;
+            auto [ref_r, ref_c] =
+                ned_to_pixel(azimuth_elevation_to_ned(az, target), size, ptt, cam_q, att_q);
+
+            auto [r, c] = pixel_at_elevation(PixelIndex{row}, PixelIndex{col}, size, ptt, cam_q, att_q, target);
+            CHECK(r.value() == ref_r.value());
+            CHECK(c.value() == ref_c.value());
+        }
+    }
+}
+
 // =========================================================================
 // ned_angle_in_pixels
 // =========================================================================
@@ -0,0 +1,158 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/calibration.hpp"
+#include "test_helpers.hpp"
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace p2b;
+using namespace linalg3d;
+using namespace test_helpers;
+
+namespace
+{
+
+const ImageSize SIZE{1280, 720};
+const PixelToTan PTT = pixel_to_tan_from_fov(SIZE, Degrees{70}.to_radians());
+
+// Mount tilted 12 degrees, rolled and yawed slightly
+const Quaternion TRUE_CAM = cam_to_body_from_angle(Degrees{12}.to_radians()) * unit(0.9998, 0.015, 0.0, -0.01);
+
+// Landmarks seen at random pixels under random attitudes, with +-noise_px jitter
+std::vector<CalibrationObservation> make_observations(std::size_t n, PixelToTan ptt, double noise_px, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> row(0.0, 1280.0);
+    std::uniform_real_distribution<double> col(0.0, 720.0);
+    std::uniform_real_distribution<double> angle(-0.3, 0.3);
+    std::uniform_real_distribution<double> jitter(-noise_px, noise_px);
+    std::vector<CalibrationObservation> obs;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Quaternion att = unit(1.0, angle(rng), angle(rng), 4.0 * angle(rng));
+        const double r = row(rng);
+        const double c = col(rng);
+        const Vector3 dir_cam = detail::camera_direction((r - SIZE.half_width()) * ptt.get(),
+                                                         (c - SIZE.half_height()) * ptt.get());
+        obs.push_back({att, r + jitter(rng), c + jitter(rng), att * (TRUE_CAM * dir_cam)});
+    }
+    return obs;
+}
+
+} // namespace
+
+TEST_CASE("calibration_normal_equations: gradient matches finite differences")
+{
+    const auto obs = make_observations(20, PTT, 0.5, 1);
+    const Quaternion cam = TRUE_CAM * unit(1.0, 0.01, -0.02, 0.015);
+    const auto ne = calibration_normal_equations(obs, SIZE, PTT, cam);
+    CHECK(ne.count == 20);
+
+    // J^T r is half the gradient of the cost
+    const double eps = 1e-7;
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        std::array<double, 3> d{};
+        d[k] = eps;
+        const auto plus = calibration_normal_equations(
+            obs, SIZE, PTT, cam * detail::rotation_vector_to_quaternion(d[0], d[1], d[2]));
+        const auto minus = calibration_normal_equations(
+            obs, SIZE, PTT, cam * detail::rotation_vector_to_quaternion(-d[0], -d[1], -d[2]));
+        CHECK(ne.jtr[k] == doctest::Approx((plus.cost - minus.cost) / (4.0 * eps)).epsilon(1e-4));
+    }
+    const double h = PTT.get() * 1e-6;
+    const auto plus = calibration_normal_equations(obs, SIZE, PixelToTan{PTT.get() + h}, cam);
+    const auto minus = calibration_normal_equations(obs, SIZE, PixelToTan{PTT.get() - h}, cam);
+    CHECK(ne.jtr[3] == doctest::Approx((plus.cost - minus.cost) / (4.0 * h)).epsilon(1e-4));
+}
+
+TEST_CASE("calibrate_cam_to_body: exact observations recover the mount")
+{
+    const auto obs = make_observations(200, PTT, 0.0, 2);
+    const auto result = calibrate_cam_to_body(obs, SIZE, PTT);
+    CHECK(result.converged);
+    CHECK(result.used == 200);
+    CHECK(rotation_angle(result.cam_to_body, TRUE_CAM) < 1e-9);
+    CHECK(result.rms_px < 1e-6);
+}
+
+TEST_CASE("calibrate_cam_to_body: noisy observations from a poor initial guess")
+{
+    const auto obs = make_observations(2000, PTT, 1.0, 3);
+    const auto result = calibrate_cam_to_body(obs, SIZE, PTT, cam_to_body_from_angle(Degrees{0}.to_radians()));
+    CHECK(result.converged);
+    CHECK(rotation_angle(result.cam_to_body, TRUE_CAM) < 0.1 * PTT.get());
+    CHECK(result.rms_px == doctest::Approx(std::sqrt(1.0 / 3.0)).epsilon(0.05)); // uniform +-1 px per axis
+}
+
+TEST_CASE("calibrate_cam_to_body: pixel_to_tan refinement")
+{
+    const auto obs = make_observations(2000, PTT, 0.2, 4);
+    CalibrationOptions options;
+    options.estimate_pixel_to_tan = true;
+    const PixelToTan guess{PTT.get() * 1.05}; // FOV spec 5 % off
+    const auto fixed = calibrate_cam_to_body(obs, SIZE, guess);
+    const auto refined = calibrate_cam_to_body(obs, SIZE, guess, std::nullopt, options);
+    CHECK(fixed.pixel_to_tan.get() == guess.get());
+    CHECK(refined.converged);
+    CHECK(refined.pixel_to_tan.get() == doctest::Approx(PTT.get()).epsilon(1e-4));
+    CHECK(rotation_angle(refined.cam_to_body, TRUE_CAM) < 0.05 * PTT.get());
+    CHECK(refined.rms_px < fixed.rms_px / 5.0);
+}
+
+TEST_CASE("solve_calibration: chunked normal equations give the same solution")
+{
+    const auto obs = make_observations(1000, PTT, 0.5, 5);
+    const std::span<const CalibrationObservation> all(obs);
+    const auto chunked = [&](const Quaternion &cam, PixelToTan ptt)
+    {
+        CalibrationNormalEquations ne;
+        for (std::size_t begin = 0; begin < all.size(); begin += 300)
+        {
+            ne += calibration_normal_equations(all.subspan(begin, std::min<std::size_t>(300, all.size() - begin)),
+                                               SIZE, ptt, cam);
+        }
+        return ne;
+    };
+    const Quaternion start = initial_cam_to_body(obs, SIZE, PTT);
+    const auto a = solve_calibration(chunked, start, PTT);
+    const auto b = calibrate_cam_to_body(obs, SIZE, PTT, start);
+    CHECK(rotation_angle(a.cam_to_body, b.cam_to_body) < 1e-10);
+    CHECK(a.iterations == b.iterations);
+}
+
+TEST_CASE("calibrate_cam_to_body: thread count does not change the solution")
+{
+    const auto obs = make_observations(20000, PTT, 0.5, 6);
+    const Quaternion cam = TRUE_CAM * unit(1.0, 0.01, -0.02, 0.015);
+    const auto serial = calibration_normal_equations(obs, SIZE, PTT, cam);
+    const auto threaded = calibration_normal_equations(obs, SIZE, PTT, cam, 4);
+    CHECK(threaded.count == serial.count);
+    CHECK(threaded.cost == doctest::Approx(serial.cost).epsilon(1e-12));
+    CHECK(threaded.jtr[0] == doctest::Approx(serial.jtr[0]).epsilon(1e-9));
+
+    CalibrationOptions one;
+    one.estimate_pixel_to_tan = true;
+    CalibrationOptions many = one;
+    many.threads = 4;
+    CalibrationOptions all_cores = one;
+    all_cores.threads = 0;
+    const auto a = calibrate_cam_to_body(obs, SIZE, PTT, std::nullopt, one);
+    const auto b = calibrate_cam_to_body(obs, SIZE, PTT, std::nullopt, many);
+    const auto c = calibrate_cam_to_body(obs, SIZE, PTT, std::nullopt, all_cores);
+    CHECK(rotation_angle(a.cam_to_body, b.cam_to_body) < 1e-10);
+    CHECK(rotation_angle(a.cam_to_body, c.cam_to_body) < 1e-10);
+    CHECK(b.pixel_to_tan.get() == doctest::Approx(a.pixel_to_tan.get()).epsilon(1e-10));
+    CHECK(b.used == a.used);
+}
+
+TEST_CASE("calibrate_cam_to_body: no usable observations")
+{
+    const std::vector<CalibrationObservation> none;
+    const auto result = calibrate_cam_to_body(none, SIZE, PTT, Quaternion::identity());
+    CHECK_FALSE(result.converged);
+    CHECK(result.used == 0);
+    CHECK(result.iterations == 0);
+}
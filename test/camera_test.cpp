@@ -0,0 +1,143 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/camera.hpp"
+#include "test_helpers.hpp"
+#include <doctest/doctest.h>
+#include <cmath>
+#include <cstdlib>
+
+using namespace p2b;
+using namespace linalg3d;
+using namespace test_helpers;
+
+constexpr double EPSILON = 1e-9;
+
+namespace
+{
+
+const ImageSize SIZE{1280, 720};
+const PixelToTan PTT = pixel_to_tan_from_fov(SIZE, Degrees{70}.to_radians());
+const Quaternion CAM_Q = cam_to_body_from_angle(Degrees{12}.to_radians());
+const Quaternion ATT = unit(0.9848, 0.0436, 0.0, 0.1736);
+const Quaternion ATT_NEW = unit(0.9839, 0.0523, 0.0087, 0.1710);
+
+// Composed quaternions may move a result across a truncation boundary
+bool within_one_pixel(std::pair<PixelIndex, PixelIndex> a, std::pair<PixelIndex, PixelIndex> b)
+{
+    const auto d = [](PixelIndex x, PixelIndex y)
+    { return std::llabs(static_cast<long long>(x.value()) - static_cast<long long>(y.value())); };
+    return d(a.first, b.first) <= 1 && d(a.second, b.second) <= 1;
+}
+
+} // namespace
+
+// =========================================================================
+// Camera vs free functions
+// =========================================================================
+
+TEST_CASE("Camera::pixel_to_ned matches pixel_to_ned")
+{
+    const Camera cam(SIZE, PTT, CAM_Q, ATT);
+    for (uint64_t row = 0; row < SIZE.width; row += 97)
+    {
+        for (uint64_t col = 0; col < SIZE.height; col += 61)
+        {
+            const auto a = cam.pixel_to_ned(PixelIndex{row}, PixelIndex{col});
+            const auto b = pixel_to_ned(PixelIndex{row}, PixelIndex{col}, SIZE, PTT, CAM_Q, ATT);
+            CHECK(a.x == doctest::Approx(b.x).epsilon(EPSILON));
+            CHECK(a.y == doctest::Approx(b.y).epsilon(EPSILON));
+            CHECK(a.z == doctest::Approx(b.z).epsilon(EPSILON));
+        }
+    }
+}
+
+TEST_CASE("Camera::ned_to_pixel matches ned_to_pixel")
+{
+    const Camera cam(SIZE, PTT, CAM_Q, ATT);
+    for (uint64_t row = 5; row < SIZE.width; row += 97)
+    {
+        for (uint64_t col = 5; col < SIZE.height; col += 61)
+        {
+            // Aim at pixel centers so truncation is stable
+            const double w = (static_cast<double>(row) + 0.5 - SIZE.half_width()) * PTT.get();
+            const double h = (static_cast<double>(col) + 0.5 - SIZE.half_height()) * PTT.get();
+            const auto ned = ATT * warp_image_to_body(w, h, CAM_Q);
+            auto [r, c] = cam.ned_to_pixel(ned);
+            CHECK(r.value() == row);
+            CHECK(c.value() == col);
+            CHECK(within_one_pixel(cam.ned_to_pixel(ned), ned_to_pixel(ned, SIZE, PTT, CAM_Q, ATT)));
+        }
+    }
+}
+
+TEST_CASE("Camera::pixel_after_rotation matches pixel_after_rotation")
+{
+    const Camera cam(SIZE, PTT, CAM_Q, ATT);
+    const auto rotation = cam.rotation_to(ATT_NEW);
+    for (uint64_t row = 100; row < SIZE.width - 100; row += 101)
+    {
+        for (uint64_t col = 100; col < SIZE.height - 100; col += 67)
+        {
+            for (const bool round_back : {false, true})
+            {
+                CHECK(within_one_pixel(
+                    cam.pixel_after_rotation(PixelIndex{row}, PixelIndex{col}, rotation, round_back),
+                    pixel_after_rotation(PixelIndex{row}, PixelIndex{col}, SIZE, PTT, CAM_Q, ATT, ATT_NEW,
+                                         round_back)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Camera::pixel_after_rotation: no motion keeps rounded pixel")
+{
+    const Camera cam(SIZE, PTT, CAM_Q, ATT);
+    const auto rotation = cam.rotation_to(ATT);
+    auto [r, c] = cam.pixel_after_rotation(PixelIndex{400}, PixelIndex{300}, rotation, true);
+    CHECK(r.value() == 400);
+    CHECK(c.value() == 300);
+}
+
+TEST_CASE("Camera::is_inside matches is_ned_inside_frame")
+{
+    const Camera cam(SIZE, PTT, CAM_Q, ATT);
+    // In frame, in the margin, out of frame and behind the camera
+    const std::pair<double, double> tangents[] = {{0.0, 0.0}, {0.65, 0.0}, {2.0, 0.3}, {0.1, -0.05}};
+    for (const auto &[w, h] : tangents)
+    {
+        const auto ned = ATT * warp_image_to_body(w, h, CAM_Q);
+        CHECK(cam.is_inside(ned, 0.05) == is_ned_inside_frame(ned, SIZE, PTT, CAM_Q, ATT, 0.05));
+        const Vector3 behind{-ned.x, -ned.y, -ned.z};
+        CHECK_FALSE(cam.is_inside(behind, 0.0));
+    }
+}
+
+// =========================================================================
+// set_attitude
+// =========================================================================
+
+TEST_CASE("Camera::set_attitude recomposes the rotations")
+{
+    Camera cam(SIZE, PTT, CAM_Q);
+    cam.set_attitude(ATT_NEW);
+    CHECK(cam.attitude().w == ATT_NEW.w);
+    const auto a = cam.pixel_to_ned(PixelIndex{10}, PixelIndex{700});
+    const auto b = pixel_to_ned(PixelIndex{10}, PixelIndex{700}, SIZE, PTT, CAM_Q, ATT_NEW);
+    CHECK(a.x == doctest::Approx(b.x).epsilon(EPSILON));
+    CHECK(a.y == doctest::Approx(b.y).epsilon(EPSILON));
+    CHECK(a.z == doctest::Approx(b.z).epsilon(EPSILON));
+}
+
+TEST_CASE("Camera::pixel_direction reused across attitudes matches pixel_to_ned")
+{
+    Camera cam(SIZE, PTT, CAM_Q);
+    const auto dir = cam.pixel_direction(PixelIndex{900}, PixelIndex{123});
+    for (const auto &att : {ATT, ATT_NEW, Quaternion::identity()})
+    {
+        cam.set_attitude(att);
+        const auto a = cam.direction_to_ned(dir);
+        const auto b = cam.pixel_to_ned(PixelIndex{900}, PixelIndex{123});
+        CHECK(a.x == doctest::Approx(b.x).epsilon(EPSILON));
+        CHECK(a.y == doctest::Approx(b.y).epsilon(EPSILON));
+        CHECK(a.z == doctest::Approx(b.z).epsilon(EPSILON));
+    }
+}
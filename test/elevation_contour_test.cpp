@@ -0,0 +1,170 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/elevation_contour.hpp"
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace p2b;
+using namespace linalg3d;
+
+constexpr double EPSILON = 1e-6;
+
+// Elevation of a sub-pixel position, bypassing pixel truncation
+static double elevation_at(double row,
+                           double col,
+                           const ImageSize &size,
+                           PixelToTan ptt,
+                           const Quaternion &cam_q,
+                           const Quaternion &att_q)
+{
+    const double w_tan = (row - size.half_width()) * ptt.get();
+    const double h_tan = (col - size.half_height()) * ptt.get();
+    const auto ned = att_q * warp_image_to_body(w_tan, h_tan, cam_q);
+    return ned_to_azimuth_elevation(ned).second.value();
+}
+
+// =========================================================================
+// horizon_line
+// =========================================================================
+
+TEST_CASE("horizon_line: level camera puts horizon on the center col")
+{
+    const ImageSize size{640, 480};
+    const auto ptt = PixelToTan{0.0025};
+    std::vector<double> cols(size.width);
+    horizon_line(cols, size, ptt, Quaternion::identity(), Quaternion::identity());
+    for (const double c : cols)
+    {
+        CHECK(c == doctest::Approx(240.0).epsilon(EPSILON));
+    }
+}
+
+TEST_CASE("horizon_line: every crossing lies at zero elevation")
+{
+    const ImageSize size{1920, 1080};
+    const auto ptt = pixel_to_tan_from_fov(size, Degrees{60}.to_radians());
+    const auto cam_q = cam_to_body_from_angle(Degrees{5}.to_radians());
+    const Quaternion att_q{0.9962, 0.0872, 0.0, 0.0}; // ~10 deg roll
+    std::vector<double> cols(size.width);
+    horizon_line(cols, size, ptt, cam_q, att_q);
+    for (size_t row = 0; row < cols.size(); row += 97)
+    {
+        REQUIRE_FALSE(std::isnan(cols[row]));
+        CHECK(elevation_at(static_cast<double>(row), cols[row], size, ptt, cam_q, att_q) ==
+              doctest::Approx(0.0).epsilon(EPSILON));
+    }
+}
+
+TEST_CASE("horizon_line: roll tilts the line")
+{
+    const ImageSize size{640, 480};
+    const auto ptt = PixelToTan{0.0025};
+    const Quaternion att_q{0.9962, 0.0872, 0.0, 0.0}; // positive roll about north
+    std::vector<double> cols(size.width);
+    horizon_line(cols, size, ptt, Quaternion::identity(), att_q);
+    CHECK(cols.front() != doctest::Approx(cols.back()).epsilon(1e-3));
+    CHECK(cols[320] == doctest::Approx(240.0).epsilon(EPSILON));
+}
+
+// =========================================================================
+// elevation_contour_at_row / elevation_contour_cols
+// =========================================================================
+
+TEST_CASE("elevation_contour_at_row: crossing matches pixel_at_elevation")
+{
+    const ImageSize size{640, 480};
+    const auto ptt = PixelToTan{0.0025};
+    const auto el = Degrees{5}.to_radians();
+    const auto id = Quaternion::identity();
+
+    auto [c1, c2] = elevation_contour_at_row(PixelIndex{320}, size, ptt, id, id, el);
+    CHECK(std::isnan(c2));
+    auto [row, col] = pixel_at_elevation(PixelIndex{320}, PixelIndex{240}, size, ptt, id, id, el);
+    CHECK(row.value() == 320);
+    CHECK(static_cast<double>(col.value()) == doctest::Approx(std::floor(c1)).epsilon(EPSILON));
+}
+
+TEST_CASE("elevation_contour_cols: crossings lie on the requested elevation")
+{
+    const ImageSize size{1280, 720};
+    const auto ptt = pixel_to_tan_from_fov(size, Degrees{90}.to_radians());
+    const auto cam_q = cam_to_body_from_angle(Degrees{40}.to_radians());
+    const Quaternion att_q{0.9848, 0.0, 0.0, 0.1736};
+    const auto el = Degrees{-30}.to_radians();
+
+    std::vector<std::pair<double, double>> out(size.width);
+    elevation_contour_cols(out, size, ptt, cam_q, att_q, el);
+    size_t found = 0;
+    for (size_t row = 0; row < out.size(); row += 61)
+    {
+        for (const double c : {out[row].first, out[row].second})
+        {
+            if (!std::isnan(c))
+            {
+                ++found;
+                CHECK(elevation_at(static_cast<double>(row), c, size, ptt, cam_q, att_q) ==
+                      doctest::Approx(el.value()).epsilon(EPSILON));
+            }
+        }
+    }
+    CHECK(found > 0);
+}
+
+TEST_CASE("elevation_contour_cols: contour out of reach has no crossings")
+{
+    const ImageSize size{640, 480};
+    const auto ptt = PixelToTan{0.0025};
+    const auto id = Quaternion::identity();
+    std::vector<std::pair<double, double>> out(size.width);
+    // Level camera with 77 deg total FOV cannot see the zenith region anywhere near the frame
+    elevation_contour_cols(out, size, ptt, id, id, Degrees{89}.to_radians());
+    auto [c1, c2] = out[320];
+    CHECK((std::isnan(c1) || c1 < 0.0));
+    CHECK(std::isnan(c2));
+}
+
+// =========================================================================
+// elevation_contour_at_col / elevation_contour_rows
+// =========================================================================
+
+TEST_CASE("elevation_contour_rows: crossings lie on the requested elevation")
+{
+    const ImageSize size{1280, 720};
+    const auto ptt = pixel_to_tan_from_fov(size, Degrees{90}.to_radians());
+    const auto cam_q = cam_to_body_from_angle(Degrees{20}.to_radians());
+    const Quaternion att_q{0.9962, 0.0872, 0.0, 0.0};
+    const auto el = Degrees{-10}.to_radians();
+
+    std::vector<std::pair<double, double>> out(size.height);
+    elevation_contour_rows(out, size, ptt, cam_q, att_q, el);
+    size_t found = 0;
+    for (size_t col = 0; col < out.size(); col += 37)
+    {
+        for (const double r : {out[col].first, out[col].second})
+        {
+            if (!std::isnan(r))
+            {
+                ++found;
+                CHECK(elevation_at(r, static_cast<double>(col), size, ptt, cam_q, att_q) ==
+                      doctest::Approx(el.value()).epsilon(EPSILON));
+            }
+        }
+    }
+    CHECK(found > 0);
+}
+
+TEST_CASE("elevation_contour_at_col and elevation_contour_at_row agree")
+{
+    const ImageSize size{640, 480};
+    const auto ptt = PixelToTan{0.0025};
+    const auto cam_q = cam_to_body_from_angle(Degrees{10}.to_radians());
+    const Quaternion att_q{0.9962, 0.0872, 0.0, 0.0};
+    const auto el = Degrees{-3}.to_radians();
+
+    auto [c, unused] = elevation_contour_at_row(PixelIndex{400}, size, ptt, cam_q, att_q, el);
+    (void)unused;
+    REQUIRE_FALSE(std::isnan(c));
+    auto [r1, r2] = elevation_contour_at_col(pixel_from_rounded(c), size, ptt, cam_q, att_q, el);
+    const double r = std::isnan(r2) || std::fabs(r1 - 400.0) < std::fabs(r2 - 400.0) ? r1 : r2;
+    // Rounding the col moves along a ~10 deg tilted line: up to 0.5 / tan(10 deg) ≈ 2.8 rows
+    CHECK(std::fabs(r - 400.0) < 3.0);
+}
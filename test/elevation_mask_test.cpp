@@ -0,0 +1,149 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/elevation_mask.hpp"
+#include <doctest/doctest.h>
+#include <vector>
+
+using namespace p2b;
+using namespace linalg3d;
+
+// Per-pixel reference: count pixels where the mask disagrees with pixel_to_ned,
+// ignoring pixels that sit numerically on the threshold.
+static size_t mask_mismatches(const std::vector<uint8_t> &mask,
+                              const ImageSize &size,
+                              PixelToTan ptt,
+                              const Quaternion &cam_q,
+                              const Quaternion &att_q,
+                              double sin_threshold,
+                              MaskSide side)
+{
+    size_t bad = 0;
+    for (uint64_t col = 0; col < size.height; ++col)
+    {
+        for (uint64_t row = 0; row < size.width; ++row)
+        {
+            const auto ned = pixel_to_ned(PixelIndex{row}, PixelIndex{col}, size, ptt, cam_q, att_q);
+            const double sin_el = -ned.z / std::sqrt(ned.x * ned.x + ned.y * ned.y + ned.z * ned.z);
+            if (std::fabs(sin_el - sin_threshold) < 1e-9)
+            {
+                continue;
+            }
+            const bool expected = (sin_el > sin_threshold) == (side == MaskSide::ABOVE);
+            if (expected != (mask[col * size.width + row] != 0))
+            {
+                ++bad;
+            }
+        }
+    }
+    return bad;
+}
+
+// =========================================================================
+// fill_elevation_mask
+// =========================================================================
+
+TEST_CASE("fill_elevation_mask: level camera splits at the center col")
+{
+    const ImageSize size{64, 48};
+    const auto ptt = PixelToTan{0.02};
+    const auto id = Quaternion::identity();
+    std::vector<uint8_t> mask(size.width * size.height, 7);
+    fill_elevation_mask(mask, size, ptt, id, id, Radians{0.0}, 0.0, MaskSide::ABOVE);
+    // Elevation is positive above the center col (smaller col index)
+    CHECK(mask[0] == 255);
+    CHECK(mask[10 * size.width + 5] == 255);
+    CHECK(mask[30 * size.width + 5] == 0);
+    CHECK(mask[(size.height - 1) * size.width + size.width - 1] == 0);
+}
+
+TEST_CASE("fill_elevation_mask: matches per-pixel projection under roll and tilt")
+{
+    const ImageSize size{320, 256};
+    const auto ptt = pixel_to_tan_from_fov(size, Degrees{90}.to_radians());
+    const auto cam_q = cam_to_body_from_angle(Degrees{30}.to_radians());
+    const Quaternion att_q{0.9659, 0.2588, 0.0, 0.0}; // 30 deg roll
+    const auto thr = Degrees{-20}.to_radians();
+
+    for (const auto side : {MaskSide::ABOVE, MaskSide::BELOW})
+    {
+        std::vector<uint8_t> mask(size.width * size.height);
+        fill_elevation_mask(mask, size, ptt, cam_q, att_q, thr, 0.0, side, 1);
+        CHECK(mask_mismatches(mask, size, ptt, cam_q, att_q, std::sin(thr.value()), side) == 0);
+    }
+}
+
+TEST_CASE("fill_elevation_mask: steep down-look crosses lines twice")
+{
+    const ImageSize size{320, 256};
+    const auto ptt = pixel_to_tan_from_fov(size, Degrees{120}.to_radians());
+    const auto cam_q = cam_to_body_from_angle(Degrees{80}.to_radians());
+    const auto att_q = Quaternion::identity();
+    const auto thr = Degrees{-60}.to_radians();
+
+    std::vector<uint8_t> mask(size.width * size.height);
+    fill_elevation_mask(mask, size, ptt, cam_q, att_q, thr, 0.0, MaskSide::BELOW);
+    CHECK(mask_mismatches(mask, size, ptt, cam_q, att_q, std::sin(thr.value()), MaskSide::BELOW) == 0);
+}
+
+TEST_CASE("fill_elevation_mask: positive margin shrinks the selection")
+{
+    const ImageSize size{64, 48};
+    const auto ptt = PixelToTan{0.02};
+    const auto id = Quaternion::identity();
+    std::vector<uint8_t> tight(size.width * size.height);
+    std::vector<uint8_t> loose(size.width * size.height);
+    fill_elevation_mask(tight, size, ptt, id, id, Radians{0.0}, 3.0, MaskSide::ABOVE);
+    fill_elevation_mask(loose, size, ptt, id, id, Radians{0.0}, -3.0, MaskSide::ABOVE);
+    size_t n_tight = 0;
+    size_t n_loose = 0;
+    for (size_t i = 0; i < tight.size(); ++i)
+    {
+        n_tight += tight[i] != 0;
+        n_loose += loose[i] != 0;
+        CHECK((tight[i] == 0 || loose[i] != 0));
+    }
+    CHECK(n_tight < n_loose);
+    // At the center row the boundary (col 24) moves by 3 lines either way
+    const uint64_t row = 32;
+    CHECK(tight[20 * size.width + row] != 0);
+    CHECK(tight[22 * size.width + row] == 0);
+    CHECK(loose[26 * size.width + row] != 0);
+    CHECK(loose[28 * size.width + row] == 0);
+}
+
+TEST_CASE("fill_elevation_mask: undersized buffer writes only whole lines")
+{
+    const ImageSize size{16, 8};
+    std::vector<uint8_t> mask(size.width * 3 + 5, 9);
+    fill_elevation_mask(mask, size, PixelToTan{0.05}, Quaternion::identity(), Quaternion::identity(), Radians{0.0},
+                        0.0, MaskSide::ABOVE);
+    CHECK(mask[size.width * 3] == 9);
+    CHECK(mask.back() == 9);
+}
+
+// =========================================================================
+// elevation_mask_spans
+// =========================================================================
+
+TEST_CASE("elevation_mask_spans: spans reproduce the filled mask")
+{
+    const ImageSize size{320, 256};
+    const auto ptt = pixel_to_tan_from_fov(size, Degrees{90}.to_radians());
+    const auto cam_q = cam_to_body_from_angle(Degrees{30}.to_radians());
+    const Quaternion att_q{0.9659, 0.2588, 0.0, 0.0};
+    const auto thr = Degrees{-20}.to_radians();
+
+    std::vector<uint8_t> mask(size.width * size.height);
+    fill_elevation_mask(mask, size, ptt, cam_q, att_q, thr, 2.0, MaskSide::ABOVE);
+
+    std::vector<uint8_t> from_spans(size.width * size.height, 0);
+    for (const auto &s : elevation_mask_spans(size, ptt, cam_q, att_q, thr, 2.0, MaskSide::ABOVE))
+    {
+        CHECK(s.row_begin < s.row_end);
+        CHECK(s.row_end <= size.width);
+        for (uint64_t row = s.row_begin; row < s.row_end; ++row)
+        {
+            from_spans[s.col * size.width + row] = 255;
+        }
+    }
+    CHECK(from_spans == mask);
+}
@@ -0,0 +1,175 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/camera.hpp"
+#include "image-to-body-math/gimbal.hpp"
+#include "test_helpers.hpp"
+#include <doctest/doctest.h>
+#include <cmath>
+
+using namespace p2b;
+using namespace linalg3d;
+using namespace test_helpers;
+
+namespace
+{
+
+const ImageSize SIZE{1280, 720};
+const PixelToTan PTT = pixel_to_tan_from_fov(SIZE, Degrees{70}.to_radians());
+
+Quaternion axis_angle(double x, double y, double z, double angle)
+{
+    return Quaternion{std::cos(angle / 2.0), x * std::sin(angle / 2.0), y * std::sin(angle / 2.0),
+                      z * std::sin(angle / 2.0)};
+}
+
+const GimbalMount MOUNT{unit(0.999, 0.01, -0.03, 0.02), unit(0.9995, -0.02, 0.01, 0.015)};
+
+} // namespace
+
+TEST_CASE("gimbal_cam_to_body: tilt-only chain is cam_to_body_from_angle")
+{
+    const Radians tilt = Degrees{12}.to_radians();
+    const Quaternion q = gimbal_cam_to_body({}, {Radians{0.0}, tilt, Radians{0.0}});
+    CHECK(rotation_angle(q, cam_to_body_from_angle(tilt)) < 1e-14);
+}
+
+TEST_CASE("gimbal_cam_to_body: matches the composed joint rotations")
+{
+    const GimbalAngles angles{Radians{0.7}, Radians{-0.3}, Radians{0.2}};
+    const Quaternion expected = MOUNT.base * axis_angle(0.0, 0.0, 1.0, 0.7) * axis_angle(0.0, 1.0, 0.0, 0.3) *
+                                axis_angle(1.0, 0.0, 0.0, 0.2) * MOUNT.sensor;
+    CHECK(rotation_angle(gimbal_cam_to_body(MOUNT, angles), expected) < 1e-14);
+
+    // Positive pan looks right (body +y), positive tilt looks down (body +z)
+    const Vector3 right = gimbal_cam_to_body({}, {Radians{0.5}, Radians{0.0}, Radians{0.0}}) * Vector3{1.0, 0.0, 0.0};
+    CHECK(right.y > 0.4);
+    const Vector3 down = gimbal_cam_to_body({}, {Radians{0.0}, Radians{0.5}, Radians{0.0}}) * Vector3{1.0, 0.0, 0.0};
+    CHECK(down.z > 0.4);
+}
+
+TEST_CASE("GimbalChain: incremental updates match a full recompose")
+{
+    GimbalChain chain(MOUNT, {Radians{0.1}, Radians{0.2}, Radians{0.3}});
+    CHECK(rotation_angle(chain.cam_to_body(), gimbal_cam_to_body(MOUNT, chain.angles())) < 1e-15);
+
+    chain.set_roll(Radians{-0.4});
+    CHECK(rotation_angle(chain.cam_to_body(), gimbal_cam_to_body(MOUNT, {Radians{0.1}, Radians{0.2}, Radians{-0.4}})) <
+          1e-15);
+    chain.set_tilt(Radians{0.9});
+    CHECK(rotation_angle(chain.cam_to_body(), gimbal_cam_to_body(MOUNT, {Radians{0.1}, Radians{0.9}, Radians{-0.4}})) <
+          1e-15);
+    chain.set_pan(Radians{-2.5});
+    CHECK(rotation_angle(chain.cam_to_body(), gimbal_cam_to_body(MOUNT, {Radians{-2.5}, Radians{0.9}, Radians{-0.4}})) <
+          1e-15);
+
+    // A stream of frames where only some joints move
+    for (int i = 0; i < 50; ++i)
+    {
+        const GimbalAngles angles{Radians{i % 10 == 0 ? 0.01 * i : chain.angles().pan.value()}, Radians{0.02 * i},
+                                  Radians{i % 3 == 0 ? -0.01 * i : chain.angles().roll.value()}};
+        chain.set_angles(angles);
+        CHECK(rotation_angle(chain.cam_to_body(), gimbal_cam_to_body(MOUNT, angles)) < 1e-14);
+    }
+}
+
+TEST_CASE("Camera::set_cam_to_body: follows the gimbal")
+{
+    const Quaternion att = unit(0.9848, 0.0436, -0.02, 0.1736);
+    GimbalChain chain(MOUNT);
+    Camera camera(SIZE, PTT, chain.cam_to_body(), att);
+    chain.set_angles({Radians{0.4}, Radians{0.25}, Radians{0.05}});
+    camera.set_cam_to_body(chain.cam_to_body());
+
+    const Camera fresh(SIZE, PTT, chain.cam_to_body(), att);
+    const Vector3 a = camera.pixel_to_ned(PixelIndex{901}, PixelIndex{77});
+    const Vector3 b = fresh.pixel_to_ned(PixelIndex{901}, PixelIndex{77});
+    CHECK((a - b).norm() < 1e-15);
+    auto [row, col] = camera.ned_to_pixel(a);
+    auto [fresh_row, fresh_col] = fresh.ned_to_pixel(a);
+    CHECK(row.value() == fresh_row.value());
+    CHECK(col.value() == fresh_col.value());
+}
+
+namespace
+{
+
+// Optical axis (camera +x) in NED through the gimbal
+Vector3 boresight(const Quaternion &attitude, const GimbalMount &mount, const GimbalAngles &angles)
+{
+    return attitude * gimbal_cam_to_body(mount, angles) * Vector3{1.0, 0.0, 0.0};
+}
+
+Vector3 direction(double azimuth, double down)
+{
+    return Vector3{std::cos(down) * std::cos(azimuth), std::cos(down) * std::sin(azimuth), std::sin(down)};
+}
+
+} // namespace
+
+TEST_CASE("GimbalPointing: level body, bare gimbal: pan is azimuth, tilt is depression")
+{
+    const GimbalPointing pointing({}, Quaternion::identity());
+    const auto result = pointing.solve(direction(0.6, 0.2));
+    CHECK(result.reachable);
+    CHECK(result.angles.pan.value() == doctest::Approx(0.6).epsilon(1e-14));
+    CHECK(result.angles.tilt.value() == doctest::Approx(0.2).epsilon(1e-14));
+    CHECK(result.angles.roll.value() == 0.0);
+}
+
+TEST_CASE("GimbalPointing: centers targets through mount offsets and roll")
+{
+    const Quaternion att = unit(0.9848, 0.0436, -0.02, 0.1736);
+    const GimbalAngles current{Radians{0.2}, Radians{0.1}, Radians{0.3}};
+    const GimbalPointing pointing(MOUNT, att, current);
+    int reachable = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        const Vector3 target = direction(0.031 * i - 3.0, 0.007 * i - 0.6) * 3.0; // any length
+        const auto result = pointing.solve(target);
+        CHECK(result.angles.roll.value() == 0.3);
+        if (result.reachable)
+        {
+            ++reachable;
+            CHECK((boresight(att, MOUNT, result.angles) - target.normalized()).norm() < 1e-12);
+        }
+    }
+    CHECK(reachable == 200);
+}
+
+TEST_CASE("GimbalPointing: joint limits and branch selection")
+{
+    // Tilt stops at 10 degrees up: a target 30 degrees up is clamped and flagged
+    GimbalLimits limits;
+    limits.tilt_min = Degrees{-10}.to_radians();
+    const auto up = GimbalPointing({}, Quaternion::identity(), {}, limits).solve(direction(0.5, -0.5));
+    CHECK_FALSE(up.reachable);
+    CHECK(up.angles.tilt.value() == doctest::Approx(limits.tilt_min.value()));
+    CHECK(up.angles.pan.value() == doctest::Approx(0.5));
+
+    // Continuous pan: the equivalent nearest the current pan, past +pi
+    GimbalLimits continuous;
+    continuous.pan_min = Radians{-2.0 * linalg3d::PI};
+    continuous.pan_max = Radians{2.0 * linalg3d::PI};
+    const GimbalAngles at_three{Radians{3.0}, Radians{0.0}, Radians{0.0}};
+    const auto wrapped = GimbalPointing({}, Quaternion::identity(), at_three, continuous).solve(direction(-3.0, 0.0));
+    CHECK(wrapped.reachable);
+    CHECK(wrapped.angles.pan.value() == doctest::Approx(2.0 * linalg3d::PI - 3.0));
+    // The default +-pi stop forces the long way round
+    const auto stopped = GimbalPointing({}, Quaternion::identity(), at_three).solve(direction(-3.0, 0.0));
+    CHECK(stopped.angles.pan.value() == doctest::Approx(-3.0));
+
+    // Tilt past vertical: each branch is picked when it is the shorter slew
+    GimbalLimits over_the_top;
+    over_the_top.tilt_min = Radians{-linalg3d::PI};
+    over_the_top.tilt_max = Radians{linalg3d::PI};
+    const GimbalAngles flipped{Radians{0.0}, Degrees{170}.to_radians(), Radians{0.0}};
+    const Vector3 behind = gimbal_cam_to_body({}, {Radians{0.0}, Degrees{160}.to_radians(), Radians{0.0}}) *
+                           Vector3{1.0, 0.0, 0.0};
+    const auto over = GimbalPointing({}, Quaternion::identity(), flipped, over_the_top).solve(behind);
+    CHECK(over.reachable);
+    CHECK(over.angles.pan.value() == doctest::Approx(0.0));
+    CHECK(over.angles.tilt.value() == doctest::Approx(Degrees{160}.to_radians().value()));
+    const GimbalAngles facing_back{Radians{3.0}, Radians{0.0}, Radians{0.0}};
+    const auto level = GimbalPointing({}, Quaternion::identity(), facing_back, over_the_top).solve(behind);
+    CHECK(std::fabs(level.angles.pan.value()) == doctest::Approx(linalg3d::PI));
+    CHECK(level.angles.tilt.value() == doctest::Approx(Degrees{20}.to_radians().value()));
+}
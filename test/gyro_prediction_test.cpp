@@ -0,0 +1,103 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/gyro_prediction.hpp"
+#include <doctest/doctest.h>
+#include <cmath>
+#include <utility>
+
+using namespace p2b;
+using namespace linalg3d;
+
+namespace
+{
+
+const ImageSize SIZE{1280, 720};
+const PixelToTan PTT = pixel_to_tan_from_fov(SIZE, Degrees{70}.to_radians());
+const Quaternion CAM_Q = cam_to_body_from_angle(Degrees{12}.to_radians());
+const Quaternion ATT{0.9848, 0.0, 0.0, 0.1736};
+
+// Exact displacement through the free-function pipeline: q_new = q_old * exp(rates * dt)
+std::pair<double, double> exact_motion(double row, double col, const Vector3 &rates, double dt)
+{
+    const Vector3 delta{rates.x * dt, rates.y * dt, rates.z * dt};
+    const double theta = delta.norm();
+    const double k = theta > 0.0 ? std::sin(theta / 2.0) / theta : 0.5;
+    const Quaternion q_new = ATT * Quaternion{std::cos(theta / 2.0), delta.x * k, delta.y * k, delta.z * k};
+
+    const double w = (row - SIZE.half_width()) * PTT.get();
+    const double h = (col - SIZE.half_height()) * PTT.get();
+    const Vector3 ned = ATT * warp_image_to_body(w, h, CAM_Q);
+    auto [w_new, h_new] = warp_body_to_image(q_new.inverse() * ned, CAM_Q);
+    return {(w_new - w) / PTT.get(), (h_new - h) / PTT.get()};
+}
+
+} // namespace
+
+TEST_CASE("GyroPredictor: no rotation, no motion")
+{
+    GyroPredictor predictor(SIZE, PTT, CAM_Q);
+    predictor.set_rates(Vector3{0.0, 0.0, 0.0}, 0.01);
+    const auto m = predictor.predict(100.0, 600.0);
+    CHECK(m.d_row == 0.0);
+    CHECK(m.d_col == 0.0);
+    CHECK(m.error_px == 0.0);
+    CHECK_FALSE(m.exact);
+}
+
+TEST_CASE("GyroPredictor: first-order prediction stays within its error estimate")
+{
+    GyroPredictor predictor(SIZE, PTT, CAM_Q, 1e9); // never fall back
+    for (const Vector3 rates : {Vector3{0.3, -0.2, 1.5}, Vector3{-2.0, 0.5, 0.1}, Vector3{0.0, 3.0, -3.0}})
+    {
+        predictor.set_rates(rates, 1.0 / 60.0);
+        for (double row = 0.0; row < 1280.0; row += 157.3)
+        {
+            for (double col = 0.0; col < 720.0; col += 89.7)
+            {
+                const auto m = predictor.predict(row, col);
+                const auto [d_row, d_col] = exact_motion(row, col, rates, 1.0 / 60.0);
+                CHECK(std::hypot(m.d_row - d_row, m.d_col - d_col) <= m.error_px);
+                CHECK_FALSE(m.exact);
+            }
+        }
+    }
+}
+
+TEST_CASE("GyroPredictor: small intervals are sub-pixel accurate on the fast path")
+{
+    GyroPredictor predictor(SIZE, PTT, CAM_Q, 0.1);
+    predictor.set_rates(Vector3{0.1, -0.05, 0.2}, 1e-3);
+    const auto m = predictor.predict(640.0, 360.0);
+    const auto [d_row, d_col] = exact_motion(640.0, 360.0, Vector3{0.1, -0.05, 0.2}, 1e-3);
+    CHECK_FALSE(m.exact);
+    CHECK(m.d_row == doctest::Approx(d_row).epsilon(1e-3));
+    CHECK(m.d_col == doctest::Approx(d_col).epsilon(1e-3));
+}
+
+TEST_CASE("GyroPredictor: falls back to the exact rotation above the tolerance")
+{
+    GyroPredictor predictor(SIZE, PTT, CAM_Q, 0.1);
+    const Vector3 rates{1.0, 2.0, -4.0}; // fast turn over a long interval
+    predictor.set_rates(rates, 0.05);
+    const auto m = predictor.predict(1200.0, 50.0);
+    CHECK(m.exact);
+    CHECK(m.error_px > 0.1);
+    const auto [d_row, d_col] = exact_motion(1200.0, 50.0, rates, 0.05);
+    CHECK(m.d_row == doctest::Approx(d_row).epsilon(1e-9));
+    CHECK(m.d_col == doctest::Approx(d_col).epsilon(1e-9));
+}
+
+TEST_CASE("GyroPredictor: rotation() matches Camera::rotation_to")
+{
+    GyroPredictor predictor(SIZE, PTT, CAM_Q);
+    predictor.set_rates(Vector3{0.0, 0.0, 1.0}, 0.1);
+    const double half = 0.05;
+    const Quaternion att{std::cos(0.3), 0.0, 0.0, std::sin(0.3)};
+    const Camera camera(SIZE, PTT, CAM_Q, att);
+    const auto expected = camera.rotation_to(att * Quaternion{std::cos(half), 0.0, 0.0, std::sin(half)});
+    const auto &r = predictor.rotation();
+    const double s = r.w * expected.w < 0.0 ? -1.0 : 1.0;
+    CHECK(r.w == doctest::Approx(s * expected.w));
+    CHECK(r.x == doctest::Approx(s * expected.x));
+    CHECK(r.y == doctest::Approx(s * expected.y));
+    CHECK(r.z == doctest::Approx(s * expected.z));
+}
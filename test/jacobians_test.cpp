@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/jacobians.hpp"
+#include "test_helpers.hpp"
+#include <doctest/doctest.h>
+#include <cmath>
+#include <utility>
+
+using namespace p2b;
+using namespace linalg3d;
+using namespace test_helpers;
+
+namespace
+{
+
+const ImageSize SIZE{1280, 720};
+const PixelToTan PTT = pixel_to_tan_from_fov(SIZE, Degrees{70}.to_radians());
+const Quaternion CAM_Q = cam_to_body_from_angle(Degrees{12}.to_radians());
+
+const Quaternion ATT = unit(0.9848, 0.0436, -0.02, 0.1736);
+const Quaternion ATT_NEW = unit(0.9839, 0.0523, 0.0087, 0.1710);
+
+// attitude * exp(phi)
+Quaternion perturbed(const Quaternion &q, const Vector3 &phi)
+{
+    const double theta = phi.norm();
+    const double k = theta > 0.0 ? std::sin(theta / 2.0) / theta : 0.5;
+    return q * Quaternion{std::cos(theta / 2.0), phi.x * k, phi.y * k, phi.z * k};
+}
+
+// Continuous pixel position through the free-function pipeline
+std::pair<double, double> project(const Vector3 &ned, const Quaternion &att)
+{
+    auto [w, h] = warp_body_to_image(att.inverse() * ned, CAM_Q);
+    return {w / PTT.get() + SIZE.half_width(), h / PTT.get() + SIZE.half_height()};
+}
+
+Vector3 axis(std::size_t j, double step)
+{
+    return Vector3{j == 0 ? step : 0.0, j == 1 ? step : 0.0, j == 2 ? step : 0.0};
+}
+
+double component(const Vector3 &v, std::size_t j)
+{
+    return j == 0 ? v.x : (j == 1 ? v.y : v.z);
+}
+
+constexpr double STEP = 1e-6;
+constexpr double TOLERANCE = 1e-3; // pixels per unit, against central differences
+
+} // namespace
+
+TEST_CASE("ned_to_pixel_jacobian: projection matches ned_to_pixel")
+{
+    const Vector3 ned = pixel_to_ned(PixelIndex{901}, PixelIndex{77}, SIZE, PTT, CAM_Q, ATT);
+    const auto j = ned_to_pixel_jacobian(ned, SIZE, PTT, CAM_Q, ATT);
+    auto [row, col] = ned_to_pixel(ned, SIZE, PTT, CAM_Q, ATT);
+    CHECK(std::fabs(j.row - static_cast<double>(row.value())) <= 1.0);
+    CHECK(std::fabs(j.col - static_cast<double>(col.value())) <= 1.0);
+}
+
+TEST_CASE("ned_to_pixel_jacobian matches finite differences")
+{
+    for (const auto &[r, c] : {std::pair<uint64_t, uint64_t>{640, 360}, {20, 700}, {1250, 30}, {300, 500}})
+    {
+        const Vector3 ned = pixel_to_ned(PixelIndex{r}, PixelIndex{c}, SIZE, PTT, CAM_Q, ATT);
+        const auto jac = ned_to_pixel_jacobian(ned, SIZE, PTT, CAM_Q, ATT);
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            const auto [rp, cp] = project(ned + axis(k, STEP), ATT);
+            const auto [rm, cm] = project(ned - axis(k, STEP), ATT);
+            CHECK(component(jac.d_dir[0], k) == doctest::Approx((rp - rm) / (2 * STEP)).epsilon(TOLERANCE));
+            CHECK(component(jac.d_dir[1], k) == doctest::Approx((cp - cm) / (2 * STEP)).epsilon(TOLERANCE));
+
+            const auto [ra, ca] = project(ned, perturbed(ATT, axis(k, STEP)));
+            const auto [rb, cb] = project(ned, perturbed(ATT, axis(k, -STEP)));
+            CHECK(component(jac.d_attitude[0], k) == doctest::Approx((ra - rb) / (2 * STEP)).epsilon(TOLERANCE));
+            CHECK(component(jac.d_attitude[1], k) == doctest::Approx((ca - cb) / (2 * STEP)).epsilon(TOLERANCE));
+        }
+    }
+}
+
+TEST_CASE("pixel_after_rotation_jacobian matches finite differences")
+{
+    for (const auto &[r, c] : {std::pair<uint64_t, uint64_t>{640, 360}, {20, 700}, {1250, 30}, {300, 500}})
+    {
+        const PixelIndex row{r};
+        const PixelIndex col{c};
+        const auto jac = pixel_after_rotation_jacobian(row, col, SIZE, PTT, CAM_Q, ATT, ATT_NEW);
+        const Vector3 ned = pixel_to_ned(row, col, SIZE, PTT, CAM_Q, ATT);
+        const auto [r0, c0] = project(ned, ATT_NEW);
+        CHECK(jac.row == doctest::Approx(r0));
+        CHECK(jac.col == doctest::Approx(c0));
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            const auto moved_old = [&](double s)
+            { return project(pixel_to_ned(row, col, SIZE, PTT, CAM_Q, perturbed(ATT, axis(k, s))), ATT_NEW); };
+            const auto [ra, ca] = moved_old(STEP);
+            const auto [rb, cb] = moved_old(-STEP);
+            CHECK(component(jac.d_q_old[0], k) == doctest::Approx((ra - rb) / (2 * STEP)).epsilon(TOLERANCE));
+            CHECK(component(jac.d_q_old[1], k) == doctest::Approx((ca - cb) / (2 * STEP)).epsilon(TOLERANCE));
+
+            const auto [rp, cp] = project(ned, perturbed(ATT_NEW, axis(k, STEP)));
+            const auto [rm, cm] = project(ned, perturbed(ATT_NEW, axis(k, -STEP)));
+            CHECK(component(jac.d_q_new[0], k) == doctest::Approx((rp - rm) / (2 * STEP)).epsilon(TOLERANCE));
+            CHECK(component(jac.d_q_new[1], k) == doctest::Approx((cp - cm) / (2 * STEP)).epsilon(TOLERANCE));
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/rotation_estimation.hpp"
+#include "test_helpers.hpp"
+#include <doctest/doctest.h>
+#include <array>
+#include <vector>
+
+using namespace p2b;
+using namespace linalg3d;
+using namespace test_helpers;
+
+namespace
+{
+
+const ImageSize SIZE{1280, 720};
+const PixelToTan PTT = pixel_to_tan_from_fov(SIZE, Degrees{70}.to_radians());
+const Quaternion CAM_Q = cam_to_body_from_angle(Degrees{12}.to_radians());
+
+// Continuous pixel position of a camera-frame direction
+std::array<double, 2> project(const Vector3 &dir_cam)
+{
+    auto [w, h] = detail::camera_tangents(dir_cam);
+    return {w / PTT.get() + SIZE.half_width(), h / PTT.get() + SIZE.half_height()};
+}
+
+// Deterministic pseudo-random values in [-1, 1)
+double noise(unsigned &state)
+{
+    state = state * 1664525U + 1013904223U;
+    return static_cast<double>(state >> 8U) / static_cast<double>(1U << 23U) - 1.0;
+}
+
+} // namespace
+
+TEST_CASE("WahbaSolver: recovers an exact rotation")
+{
+    const Quaternion truth = unit(0.97, 0.12, -0.08, 0.2);
+    WahbaSolver solver;
+    for (const Vector3 d : {Vector3{1.0, 0.0, 0.0}, Vector3{0.3, 0.9, 0.1}, Vector3{-0.2, 0.4, 0.8}})
+    {
+        solver.add(d, truth * d);
+    }
+    CHECK(solver.size() == 3);
+    const Quaternion q = solver.solve();
+    CHECK(rotation_angle(q, truth) < 1e-12);
+    CHECK(q.w >= 0.0);
+}
+
+TEST_CASE("WahbaSolver: identity and half-turn")
+{
+    const std::vector<Vector3> dirs{{1.0, 0.2, 0.1}, {0.5, -0.7, 0.3}, {0.2, 0.1, -0.9}};
+    const Quaternion identity = estimate_rotation(dirs, dirs);
+    CHECK(rotation_angle(identity, Quaternion::identity()) < 1e-12);
+
+    const Quaternion half_turn{0.0, 0.0, 0.0, 1.0}; // 180 degrees about z: beyond any small-angle method
+    std::vector<Vector3> turned;
+    for (const Vector3 &d : dirs)
+    {
+        turned.push_back(half_turn * d);
+    }
+    CHECK(rotation_angle(estimate_rotation(dirs, turned), half_turn) < 1e-12);
+}
+
+TEST_CASE("estimate_rotation_from_pixels: matches pixel_after_rotation geometry")
+{
+    const Quaternion q_old = unit(0.9848, 0.0436, -0.02, 0.1736);
+    const Quaternion q_new = unit(0.9839, 0.0523, 0.0087, 0.1710);
+    const Camera camera(SIZE, PTT, CAM_Q, q_old);
+    const Quaternion truth = camera.rotation_to(q_new);
+
+    std::vector<std::array<double, 2>> a;
+    std::vector<std::array<double, 2>> b;
+    for (double row = 20.0; row < 1280.0; row += 141.7)
+    {
+        for (double col = 15.0; col < 720.0; col += 97.3)
+        {
+            a.push_back({row, col});
+            b.push_back(project(truth * subpixel_direction(row, col, SIZE, PTT)));
+        }
+    }
+    const Quaternion q = estimate_rotation_from_pixels(a, b, SIZE, PTT);
+    CHECK(rotation_angle(q, truth) < 1e-10);
+
+    // Recovered body attitude
+    CHECK(rotation_angle(attitude_after_rotation(q_old, CAM_Q, q), q_new) < 1e-10);
+}
+
+TEST_CASE("estimate_rotation_from_pixels: pixel noise averages out, weights select pairs")
+{
+    const Quaternion truth = unit(0.999, 0.01, -0.02, 0.03);
+    std::vector<std::array<double, 2>> a;
+    std::vector<std::array<double, 2>> b;
+    unsigned state = 7;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const double row = 640.0 + 600.0 * noise(state);
+        const double col = 360.0 + 340.0 * noise(state);
+        const auto p = project(truth * subpixel_direction(row, col, SIZE, PTT));
+        a.push_back({row, col});
+        b.push_back({p[0] + 0.5 * noise(state), p[1] + 0.5 * noise(state)});
+    }
+    const double one_px = PTT.get();
+    CHECK(rotation_angle(estimate_rotation_from_pixels(a, b, SIZE, PTT), truth) < 0.05 * one_px);
+
+    // A gross mismatch with zero weight has no effect
+    std::vector<double> weights(a.size(), 1.0);
+    a.push_back({640.0, 360.0});
+    b.push_back({0.0, 0.0});
+    weights.push_back(0.0);
+    CHECK(rotation_angle(estimate_rotation_from_pixels(a, b, SIZE, PTT, weights), truth) < 0.05 * one_px);
+}
+
+TEST_CASE("WahbaSolver: clear resets the accumulator")
+{
+    WahbaSolver solver;
+    solver.add(Vector3{1.0, 0.0, 0.0}, Vector3{0.0, 1.0, 0.0});
+    solver.clear();
+    CHECK(solver.size() == 0);
+    solver.add(Vector3{1.0, 0.0, 0.0}, Vector3{1.0, 0.0, 0.0});
+    solver.add(Vector3{0.0, 1.0, 0.0}, Vector3{0.0, 1.0, 0.0});
+    CHECK(rotation_angle(solver.solve(), Quaternion::identity()) < 1e-12);
+}
@@ -0,0 +1,133 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "image-to-body-math/rotation_ransac.hpp"
+#include "test_helpers.hpp"
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace p2b;
+using namespace linalg3d;
+using namespace test_helpers;
+
+namespace
+{
+
+const ImageSize SIZE{1280, 720};
+const PixelToTan PTT = pixel_to_tan_from_fov(SIZE, Degrees{70}.to_radians());
+
+std::array<double, 2> project(const Vector3 &dir_cam)
+{
+    auto [w, h] = detail::camera_tangents(dir_cam);
+    return {w / PTT.get() + SIZE.half_width(), h / PTT.get() + SIZE.half_height()};
+}
+
+const Quaternion TRUTH = unit(0.998, 0.02, -0.03, 0.05);
+
+struct Matches
+{
+    std::vector<std::array<double, 2>> a;
+    std::vector<std::array<double, 2>> b;
+    std::vector<bool> outlier;
+};
+
+// n matches under TRUTH with +-noise_px jitter; a fraction of them replaced by random positions
+Matches make_matches(std::size_t n, double outlier_fraction, double noise_px, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> row(0.0, 1280.0);
+    std::uniform_real_distribution<double> col(0.0, 720.0);
+    std::uniform_real_distribution<double> jitter(-noise_px, noise_px);
+    std::uniform_real_distribution<double> unit_interval(0.0, 1.0);
+    Matches m;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::array<double, 2> a{row(rng), col(rng)};
+        const bool outlier = unit_interval(rng) < outlier_fraction;
+        auto b = project(TRUTH * subpixel_direction(a[0], a[1], SIZE, PTT));
+        if (outlier)
+        {
+            b = {row(rng), col(rng)};
+        }
+        m.a.push_back(a);
+        m.b.push_back({b[0] + jitter(rng), b[1] + jitter(rng)});
+        m.outlier.push_back(outlier);
+    }
+    return m;
+}
+
+} // namespace
+
+TEST_CASE("rotation_matrix: agrees with quaternion rotation")
+{
+    const auto m = detail::rotation_matrix(TRUTH);
+    const Vector3 v{0.3, -0.5, 0.8};
+    const Vector3 r = TRUTH * v;
+    CHECK(m[0] * v.x + m[1] * v.y + m[2] * v.z == doctest::Approx(r.x));
+    CHECK(m[3] * v.x + m[4] * v.y + m[5] * v.z == doctest::Approx(r.y));
+    CHECK(m[6] * v.x + m[7] * v.y + m[8] * v.z == doctest::Approx(r.z));
+}
+
+TEST_CASE("RotationRansac: clean matches")
+{
+    const auto m = make_matches(300, 0.0, 0.0, 1);
+    RotationRansac ransac(SIZE, PTT);
+    const auto result = ransac.estimate(m.a, m.b);
+    CHECK(result.success);
+    CHECK(result.inliers == 300);
+    CHECK(result.iterations <= 2); // all-inlier data stops after the first good sample
+    CHECK(rotation_angle(result.rotation, TRUTH) < 1e-10);
+}
+
+TEST_CASE("RotationRansac: rejects half outliers and refits the inliers")
+{
+    const auto m = make_matches(1000, 0.5, 0.3, 2);
+    RotationRansac ransac(SIZE, PTT);
+    const auto result = ransac.estimate(m.a, m.b, RansacOptions{.threshold_px = 1.0});
+    REQUIRE(result.success);
+    CHECK(result.iterations < 256);
+    CHECK(rotation_angle(result.rotation, TRUTH) < 0.05 * PTT.get());
+
+    // The plain least-squares fit is pulled far off by the same outliers
+    CHECK(rotation_angle(estimate_rotation_from_pixels(m.a, m.b, SIZE, PTT), TRUTH) > 10.0 * PTT.get());
+
+    const auto mask = ransac.inlier_mask();
+    REQUIRE(mask.size() == 1000);
+    std::size_t misclassified = 0;
+    for (std::size_t i = 0; i < mask.size(); ++i)
+    {
+        misclassified += (mask[i] == 1) == m.outlier[i] ? 1U : 0U;
+    }
+    CHECK(misclassified < 5); // a random outlier can land within a pixel of its true match
+    CHECK(static_cast<std::size_t>(std::count(mask.begin(), mask.end(), uint8_t{1})) == result.inliers);
+}
+
+TEST_CASE("RotationRansac: deterministic for a seed, buffers reused across frames")
+{
+    const auto m = make_matches(400, 0.3, 0.2, 3);
+    RotationRansac ransac(SIZE, PTT);
+    const RansacOptions options{.seed = 42};
+    const auto first = ransac.estimate(m.a, m.b, options);
+    const auto small = make_matches(50, 0.0, 0.0, 4);
+    CHECK(ransac.estimate(small.a, small.b, options).inliers == 50);
+    CHECK(ransac.inlier_mask().size() == 50);
+    const auto again = ransac.estimate(m.a, m.b, options);
+    CHECK(again.iterations == first.iterations);
+    CHECK(again.inliers == first.inliers);
+    CHECK(rotation_angle(again.rotation, first.rotation) == 0.0);
+}
+
+TEST_CASE("RotationRansac: too few or degenerate matches")
+{
+    RotationRansac ransac(SIZE, PTT);
+    const std::vector<std::array<double, 2>> one{{100.0, 100.0}};
+    CHECK_FALSE(ransac.estimate(one, one).success);
+
+    const std::vector<std::array<double, 2>> clustered{{100.0, 100.0}, {100.5, 100.0}, {100.0, 100.5}};
+    const auto result = ransac.estimate(clustered, clustered, RansacOptions{.max_iterations = 20});
+    CHECK_FALSE(result.success);
+    CHECK(result.iterations == 20);
+    CHECK(result.inliers == 0);
+}
@@ -0,0 +1,42 @@
+#pragma once
+// Quaternion helpers shared by the doctest suites.
+#include "image-to-body-math/body_space.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace test_helpers
+{
+
+/// Quaternion normalized from arbitrary components.
+inline p2b::Quaternion unit(double w, double x, double y, double z)
+{
+    const double n = std::sqrt(w * w + x * x + y * y + z * z);
+    return p2b::Quaternion{w / n, x / n, y / n, z / n};
+}
+
+/// Rotation about the z axis (yaw, NED: positive turns right).
+inline p2b::Quaternion yaw(double deg)
+{
+    const double half = p2b::Degrees{deg}.to_radians().value() / 2.0;
+    return p2b::Quaternion{std::cos(half), 0.0, 0.0, std::sin(half)};
+}
+
+/// Rotation about the y axis (pitch, NED: positive noses up).
+inline p2b::Quaternion pitch(double deg)
+{
+    const double half = p2b::Degrees{deg}.to_radians().value() / 2.0;
+    return p2b::Quaternion{std::cos(half), 0.0, std::sin(half), 0.0};
+}
+
+/// Angle between two rotations (radians), sign-invariant. The chord form stays accurate near
+/// zero, where 2 acos(|a . b|) loses everything below about 1e-8 rad.
+inline double rotation_angle(const p2b::Quaternion &a, const p2b::Quaternion &b)
+{
+    const double minus = std::sqrt((a.w - b.w) * (a.w - b.w) + (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) +
+                                   (a.z - b.z) * (a.z - b.z));
+    const double plus = std::sqrt((a.w + b.w) * (a.w + b.w) + (a.x + b.x) * (a.x + b.x) + (a.y + b.y) * (a.y + b.y) +
+                                  (a.z + b.z) * (a.z + b.z));
+    return 4.0 * std::asin(std::min(minus, plus) / 2.0);
+}
+
+} // namespace test_helpers
@@ -0,0 +1,20 @@
+"""pytest-benchmark configuration for the binding regression suite.
+
+Baselines live next to this file (tests/benchmarks/.baselines) unless --benchmark-storage is given,
+so saved runs and comparisons work from any working directory. They are per-machine and ignored by
+git; on pull requests CI records the merge base and compares the change against it on one runner.
+"""
+
+from pathlib import Path
+
+import pytest
+
+pytest.importorskip("pytest_benchmark")
+
+_DEFAULT_STORAGE = "file://./.benchmarks"
+
+
+def pytest_configure(config):
+    # Runs before pytest-benchmark (trylast) builds its session from these options
+    if getattr(config.option, "benchmark_storage", None) == _DEFAULT_STORAGE:
+        config.option.benchmark_storage = "file://" + str(Path(__file__).parent / ".baselines")
@@ -0,0 +1,276 @@
+"""Regression benchmarks for the Python bindings (pytest-benchmark).
+
+Scalar cases measure per-call overhead (argument conversion, result construction), for both
+the numpy API and the tuple-based ``fast`` module; batch cases measure throughput at several
+sizes. Every exported function must appear here, which test_every_export_is_benchmarked enforces.
+
+    pytest tests/benchmarks --benchmark-save=baseline
+    pytest tests/benchmarks --benchmark-compare=0001 --benchmark-compare-fail=median:10%
+"""
+
+from __future__ import annotations
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 1920, 1080
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(60))
+CAM = p2b.cam_to_body_from_angle(math.radians(10))
+ATT = np.array([0.9848, 0.0, 0.0, 0.1736])
+ATT2 = np.array([0.9845, 0.0087, 0.0, 0.1752])
+NED = p2b.pixel_to_ned(960, 540, W, H, P2T, CAM, ATT)
+NED2 = p2b.pixel_to_ned(1000, 500, W, H, P2T, CAM, ATT)
+EL = math.radians(-5)
+
+# name -> (args, kwargs)
+SCALAR_CASES = {
+    "pixel_tan_from_fov": ((700, W, H, math.radians(60)), {}),
+    "tan_to_pixel_by_fov": ((0.1, W, H, math.radians(60)), {}),
+    "pixel_tan_by_pixel_to_tan": ((700, W, H, P2T), {}),
+    "angle_tan_to_pixel": ((0.1, W, H, P2T), {}),
+    "pixel_tan_by_pixel_to_tan_clipped": ((700, W, H, P2T, 0.05), {}),
+    "tan_to_pixel_by_pixel_to_tan": ((0.1, W, H, P2T), {}),
+    "pixel_to_tan_from_fov": ((W, H, math.radians(60)), {}),
+    "cam_to_body_from_angle": ((math.radians(10),), {}),
+    "tangents_to_ned": ((0.1, -0.05), {}),
+    "ned_to_tangents": ((NED,), {}),
+    "ned_to_azimuth_elevation": ((NED,), {}),
+    "azimuth_elevation_to_ned": ((0.3, -0.1), {}),
+    "warp_image_to_body": ((0.1, -0.05, CAM), {}),
+    "warp_body_to_image": ((NED, CAM), {}),
+    "pixel_to_ned": ((960, 540, W, H, P2T, CAM, ATT), {}),
+    "ned_to_pixel": ((NED, W, H, P2T, CAM, ATT), {}),
+    "pixel_after_rotation": ((960, 540, W, H, P2T, CAM, ATT, ATT2), {}),
+    "is_pixel_inside_frame": ((960, 540, W, H, 0.05), {}),
+    "is_ned_inside_frame": ((NED, W, H, P2T, CAM, ATT, 0.05), {}),
+    "ned_at_elevation": ((NED, EL), {}),
+    "pixel_at_elevation": ((960, 540, W, H, P2T, CAM, ATT, EL), {}),
+    "ned_angle_in_pixels": ((NED, NED2, P2T), {}),
+    "elevation_contour_at_row": ((960, W, H, P2T, CAM, ATT, EL), {}),
+    "elevation_contour_at_col": ((540, W, H, P2T, CAM, ATT, EL), {}),
+    "to_dlpack": ((NED,), {}),
+    "ned_to_pixel_jacobian": ((NED, W, H, P2T, CAM, ATT), {}),
+    "pixel_after_rotation_jacobian": ((960, 540, W, H, P2T, CAM, ATT, ATT2), {}),
+    "attitude_after_rotation": ((ATT, CAM, ATT2), {}),
+    "gimbal_cam_to_body": ((0.4, 0.25, 0.05), {}),
+    "point_gimbal": ((NED, ATT), {}),
+    "predict_pixel_motion": ((960.5, 540.5, W, H, P2T, CAM, np.array([0.3, -0.2, 1.5]), 1 / 60), {}),
+}
+
+# Whole-frame functions: one call covers a full raster, so they are measured once per call
+FRAME_CASES = {
+    "elevation_contour_cols": ((W, H, P2T, CAM, ATT, EL), {}),
+    "elevation_contour_rows": ((W, H, P2T, CAM, ATT, EL), {}),
+    "horizon_line": ((W, H, P2T, CAM, ATT), {}),
+    "elevation_mask": ((W, H, P2T, CAM, ATT, EL), {}),
+    "elevation_mask_spans": ((W, H, P2T, CAM, ATT, EL), {}),
+}
+
+
+# Tuple convention (image_to_body_math.fast): the same cases with arrays passed as plain tuples
+def _as_tuple(a):
+    return tuple(a.tolist()) if isinstance(a, np.ndarray) else a
+
+
+FAST_CASES = {
+    name: (tuple(_as_tuple(a) for a in args), kwargs)
+    for name, (args, kwargs) in SCALAR_CASES.items()
+    if name in p2b.fast.__all__
+}
+
+
+def _batch_inputs(n: int):
+    rng = np.random.default_rng(0xBE7C4)
+    rows = rng.integers(0, W, size=n, dtype=np.uint64)
+    cols = rng.integers(0, H, size=n, dtype=np.uint64)
+    tans = rng.uniform(-0.5, 0.5, size=(2, n))
+    neds = p2b.pixel_to_ned_batch(rows, cols, W, H, P2T, CAM, ATT)
+    return rows, cols, tans, neds
+
+
+# name -> builds (args, kwargs) from the batch inputs
+BATCH_CASES = {
+    "pixel_to_ned_batch": lambda r, c, t, d: ((r, c, W, H, P2T, CAM, ATT), {}),
+    "ned_to_pixel_batch": lambda r, c, t, d: ((d, W, H, P2T, CAM, ATT), {}),
+    "pixel_after_rotation_batch": lambda r, c, t, d: ((r, c, W, H, P2T, CAM, ATT, ATT2), {}),
+    "pixel_at_elevation_batch": lambda r, c, t, d: ((r, c, W, H, P2T, CAM, ATT, EL), {}),
+    "warp_image_to_body_batch": lambda r, c, t, d: ((t[0], t[1], CAM), {}),
+    "pixel_tan_from_fov_batch": lambda r, c, t, d: ((r, W, H, math.radians(60)), {}),
+    "tan_to_pixel_by_fov_batch": lambda r, c, t, d: ((t[0], W, H, math.radians(60)), {}),
+    "pixel_tan_by_pixel_to_tan_batch": lambda r, c, t, d: ((r, W, H, P2T), {}),
+    "angle_tan_to_pixel_batch": lambda r, c, t, d: ((t[0], W, H, P2T), {}),
+    "pixel_tan_by_pixel_to_tan_clipped_batch": lambda r, c, t, d: ((r, W, H, P2T, 0.05), {}),
+    "tan_to_pixel_by_pixel_to_tan_batch": lambda r, c, t, d: ((t[0], W, H, P2T), {}),
+    "pixel_to_tan_from_fov_batch": lambda r, c, t, d: ((np.abs(t[0]) + 0.5, W, H), {}),
+    "cam_to_body_from_angle_batch": lambda r, c, t, d: ((t[0],), {}),
+    "tangents_to_ned_batch": lambda r, c, t, d: ((t[0], t[1]), {}),
+    "ned_to_tangents_batch": lambda r, c, t, d: ((d,), {}),
+    "ned_to_azimuth_elevation_batch": lambda r, c, t, d: ((d,), {}),
+    "azimuth_elevation_to_ned_batch": lambda r, c, t, d: ((t[0], t[1]), {}),
+    "warp_body_to_image_batch": lambda r, c, t, d: ((d, CAM), {}),
+    "is_pixel_inside_frame_batch": lambda r, c, t, d: ((r, c, W, H, 0.05), {}),
+    "is_ned_inside_frame_batch": lambda r, c, t, d: ((d, W, H, P2T, CAM, ATT, 0.05), {}),
+    "ned_at_elevation_batch": lambda r, c, t, d: ((d, EL), {}),
+    "ned_angle_in_pixels_batch": lambda r, c, t, d: ((d, d[::-1].copy(), P2T), {}),
+    "pixel_to_ned_broadcast": lambda r, c, t, d: ((r, c, W, H, P2T, CAM, np.tile(ATT, (8, 1))), {}),
+    "ned_to_pixel_broadcast": lambda r, c, t, d: ((d, W, H, P2T, CAM, np.tile(ATT, (8, 1))), {}),
+    "ned_to_pixel_jacobian_batch": lambda r, c, t, d: ((d, W, H, P2T, CAM, ATT), {}),
+    "pixel_after_rotation_jacobian_batch": lambda r, c, t, d: ((r, c, W, H, P2T, CAM, ATT, ATT2), {}),
+    "predict_pixel_motion_batch": lambda r, c, t, d: (
+        (np.column_stack([r, c]).astype(np.float64), W, H, P2T, CAM, np.array([0.3, -0.2, 1.5]), 1 / 60), {}),
+    "estimate_rotation": lambda r, c, t, d: (
+        (np.column_stack([r, c]).astype(np.float64), np.column_stack([c, r]).astype(np.float64), W, H, P2T), {}),
+    "calibrate_cam_to_body": lambda r, c, t, d: (
+        (np.tile(ATT, (len(r), 1)), np.column_stack([r, c]).astype(np.float64), d, W, H, P2T), {}),
+    "estimate_rotation_ransac": lambda r, c, t, d: (
+        (np.column_stack([r, c]).astype(np.float64), np.column_stack([c, r]).astype(np.float64), W, H, P2T), {}),
+    "gimbal_cam_to_body_batch": lambda r, c, t, d: ((np.column_stack([t[0], t[1], 0.1 * t[0]]),), {}),
+    "pixel_to_ned_batch_gimbal": lambda r, c, t, d: (
+        (r, c, W, H, P2T, np.column_stack([t[0], t[1], 0.1 * t[0]]), ATT), {}),
+    "ned_to_pixel_batch_gimbal": lambda r, c, t, d: (
+        (d, W, H, P2T, np.column_stack([t[0], t[1], 0.1 * t[0]]), ATT), {}),
+    "point_gimbal_batch": lambda r, c, t, d: ((d, ATT), {}),
+}
+
+BATCH_SIZES = [1_000, 100_000]
+
+# Camera methods (prepared state): scalar calls with tuples, attitude set once
+CAMERA_SCALAR_CASES = {
+    "pixel_to_ned": (320, 240),
+    "ned_to_pixel": (_as_tuple(NED),),
+    "pixel_after_rotation": (320, 240, _as_tuple(ATT2)),
+    "is_inside": (_as_tuple(NED), 0.1),
+    "set_attitude": (_as_tuple(ATT),),
+    "set_cam_to_body": (_as_tuple(CAM),),
+}
+
+
+@pytest.mark.parametrize("name", sorted(SCALAR_CASES))
+def test_scalar(benchmark, name):
+    args, kwargs = SCALAR_CASES[name]
+    benchmark.group = "scalar"
+    benchmark(getattr(p2b, name), *args, **kwargs)
+
+
+@pytest.mark.parametrize("name", sorted(FAST_CASES))
+def test_fast(benchmark, name):
+    args, kwargs = FAST_CASES[name]
+    benchmark.group = "fast"
+    benchmark(getattr(p2b.fast, name), *args, **kwargs)
+
+
+@pytest.mark.parametrize("name", sorted(FRAME_CASES))
+def test_frame(benchmark, name):
+    args, kwargs = FRAME_CASES[name]
+    benchmark.group = f"frame {W}x{H}"
+    benchmark(getattr(p2b, name), *args, **kwargs)
+
+
+@pytest.mark.parametrize("n", BATCH_SIZES)
+@pytest.mark.parametrize("name", sorted(BATCH_CASES))
+def test_batch(benchmark, name, n):
+    args, kwargs = BATCH_CASES[name](*_batch_inputs(n))
+    benchmark.group = f"batch {name}"
+    benchmark.extra_info["points"] = n
+    benchmark(getattr(p2b, name), *args, **kwargs)
+
+
+@pytest.mark.parametrize("name", sorted(CAMERA_SCALAR_CASES))
+def test_camera(benchmark, name):
+    camera = p2b.Camera(W, H, P2T, CAM, ATT)
+    benchmark.group = "camera"
+    benchmark(getattr(camera, name), *CAMERA_SCALAR_CASES[name])
+
+
+@pytest.mark.parametrize("n", BATCH_SIZES)
+@pytest.mark.parametrize("name", ["pixel_to_ned_batch", "pixel_after_rotation_batch"])
+def test_camera_batch(benchmark, name, n):
+    rows, cols, _, _ = _batch_inputs(n)
+    camera = p2b.Camera(W, H, P2T, CAM, ATT)
+    args = (rows, cols) if name == "pixel_to_ned_batch" else (rows, cols, _as_tuple(ATT2))
+    benchmark.group = f"camera {name}"
+    benchmark.extra_info["points"] = n
+    benchmark(getattr(camera, name), *args)
+
+
+@pytest.mark.parametrize("n", BATCH_SIZES)
+@pytest.mark.parametrize("name", ["pixel_to_ned_batch", "ned_to_pixel_batch", "pixel_after_rotation_batch"])
+def test_rolling_shutter_batch(benchmark, name, n):
+    rows, cols, _, neds = _batch_inputs(n)
+    camera = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    camera.set_attitudes(ATT, ATT2)
+    args = {"pixel_to_ned_batch": (rows, cols), "ned_to_pixel_batch": (neds,),
+            "pixel_after_rotation_batch": (rows, cols, camera)}[name]
+    benchmark.group = f"rolling shutter {name}"
+    benchmark.extra_info["points"] = n
+    benchmark(getattr(camera, name), *args)
+
+
+def test_rolling_shutter_set_attitudes(benchmark):
+    camera = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    benchmark.group = "rolling shutter"
+    benchmark.extra_info["lines"] = H
+    benchmark(camera.set_attitudes, _as_tuple(ATT), _as_tuple(ATT2))
+
+
+def _imu_buffer():
+    buffer = p2b.AttitudeBuffer(1024)
+    times = np.arange(1000) * 1e-3
+    buffer.push_batch(times, np.tile(ATT, (len(times), 1)))
+    return buffer
+
+
+def test_attitude_buffer_at(benchmark):
+    buffer = _imu_buffer()
+    benchmark.group = "attitude buffer"
+    benchmark(buffer.at, 0.5005)
+
+
+@pytest.mark.parametrize("n", BATCH_SIZES)
+def test_attitude_buffer_at_batch(benchmark, n):
+    buffer = _imu_buffer()
+    times = np.linspace(0.0, 0.999, n)  # sorted, like event timestamps
+    benchmark.group = "attitude buffer at_batch"
+    benchmark.extra_info["points"] = n
+    benchmark(buffer.at_batch, times)
+
+
+# Input layouts the batch functions read in place (no conversion copy)
+LAYOUTS = {
+    "uint64 rows/cols": lambda r, c: (r, c),
+    "int32 rows/cols": lambda r, c: (r.astype(np.int32), c.astype(np.int32)),
+    "int32 (N,2) pairs": lambda r, c: (np.stack([r, c], axis=1).astype(np.int32), None),
+    "int64 column slices": lambda r, c: (lambda t: (t[:, 0], t[:, 2]))(np.stack([r, r, c], axis=1).astype(np.int64)),
+}
+
+
+@pytest.mark.parametrize("layout", sorted(LAYOUTS))
+def test_batch_layout(benchmark, layout):
+    rows, cols, _, _ = _batch_inputs(BATCH_SIZES[-1])
+    r, c = LAYOUTS[layout](rows, cols)
+    benchmark.group = "batch layouts pixel_to_ned_batch"
+    benchmark.extra_info["points"] = len(rows)
+    benchmark(p2b.pixel_to_ned_batch, r, c, W, H, P2T, CAM, ATT)
+
+
+@pytest.mark.parametrize("n", BATCH_SIZES)
+@pytest.mark.parametrize("name", ["pixel_to_ned_batch", "pixel_after_rotation_batch"])
+def test_batch_per_point_attitude(benchmark, name, n):
+    rows, cols, _, _ = _batch_inputs(n)
+    atts = np.tile(ATT, (n, 1))
+    args = (rows, cols, W, H, P2T, CAM, atts) if name == "pixel_to_ned_batch" else \
+        (rows, cols, W, H, P2T, CAM, ATT, atts)
+    benchmark.group = f"batch per-point attitude {name}"
+    benchmark.extra_info["points"] = n
+    benchmark(getattr(p2b, name), *args)
+
+
+def test_every_export_is_benchmarked():
+    covered = set(SCALAR_CASES) | set(FRAME_CASES) | set(BATCH_CASES)
+    exported = {name for name in p2b.__all__ if callable(getattr(p2b, name)) and not isinstance(getattr(p2b, name), type)}
+    assert exported - covered == set()
+    assert set(p2b.fast.__all__) - set(FAST_CASES) == set()
@@ -25,3 +25,40 @@ def standard_fov():
 def standard_p2t():
     import image_to_body_math as p2b
     return p2b.pixel_to_tan_from_fov(640, 480, math.radians(90))
+
+
+@pytest.fixture(scope="session")
+def quat_mul():
+    """Hamilton product of two [w, x, y, z] quaternions."""
+    def mul(a, b):
+        w1, x1, y1, z1 = a
+        w2, x2, y2, z2 = b
+        return np.array([w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2, w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2,
+                         w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2, w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2])
+    return mul
+
+
+@pytest.fixture(scope="session")
+def axis_angle():
+    """Quaternion [w, x, y, z] rotating by angle (radians) about a unit axis."""
+    def quat(axis, angle):
+        return np.concatenate([[math.cos(angle / 2)], math.sin(angle / 2) * np.asarray(axis, dtype=float)])
+    return quat
+
+
+@pytest.fixture(scope="session")
+def rotvec_quat(axis_angle):
+    """Quaternion [w, x, y, z] of a non-zero rotation vector (radians)."""
+    def quat(v):
+        theta = float(np.linalg.norm(v))
+        return axis_angle(np.asarray(v, dtype=float) / theta, theta)
+    return quat
+
+
+@pytest.fixture(scope="session")
+def rotation_angle():
+    """Angle between two rotations (radians), sign-invariant and well conditioned near zero."""
+    def angle(a, b):
+        a, b = np.asarray(a, dtype=float), np.asarray(b, dtype=float)
+        return 4.0 * math.asin(min(np.linalg.norm(a - b), np.linalg.norm(a + b)) / 2.0)
+    return angle
@@ -0,0 +1,85 @@
+"""Tests for the timestamped attitude ring buffer."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 640, 480
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(60))
+CAM = p2b.cam_to_body_from_angle(math.radians(10))
+
+
+def yaw(deg):
+    half = np.radians(np.asarray(deg, dtype=np.float64)) / 2
+    z = np.zeros_like(half)
+    return np.stack([np.cos(half), z, z, np.sin(half)], axis=-1)
+
+
+# 1 kHz IMU turning at 10 deg/s
+TIMES = np.arange(100) * 1e-3
+ATTS = yaw(TIMES * 10.0)
+
+
+@pytest.fixture
+def buffer():
+    b = p2b.AttitudeBuffer(256)
+    assert b.push_batch(TIMES, ATTS) == len(TIMES)
+    return b
+
+
+def test_interpolated_lookup(buffer):
+    np.testing.assert_allclose(buffer.at(0.0105), yaw(0.105), atol=1e-12)
+    np.testing.assert_allclose(buffer.at(0.0105, p2b.Interpolation.NLERP), yaw(0.105), atol=1e-9)
+    assert buffer.span == pytest.approx((0.0, 0.099))
+    assert len(buffer) == 100
+
+
+def test_outside_span(buffer):
+    assert buffer.at(-0.001) is None
+    assert buffer.at(0.1) is None
+    assert p2b.AttitudeBuffer(4).span is None
+    with pytest.raises(ValueError):
+        buffer.at_batch(np.array([0.01, 0.5]))
+
+
+def test_ring_drops_oldest():
+    b = p2b.AttitudeBuffer(16)
+    b.push_batch(TIMES, ATTS)
+    assert len(b) == 16 and b.capacity == 16
+    assert b.span == pytest.approx((0.084, 0.099))
+
+
+def test_out_of_order_rejected(buffer):
+    assert buffer.push(0.05, ATTS[0]) is False
+    assert buffer.push(0.2, ATTS[0]) is True
+
+
+def test_batch_matches_scalar(buffer):
+    t = np.random.default_rng(4).uniform(0.0, 0.099, 50)
+    out = buffer.at_batch(t)
+    assert out.shape == (50, 4)
+    for i, ti in enumerate(t):
+        np.testing.assert_allclose(out[i], buffer.at(ti), atol=1e-15)
+    np.testing.assert_allclose(out, yaw(t * 10.0), atol=1e-12)
+
+
+def test_scipy_samples():
+    Rotation = pytest.importorskip("scipy.spatial.transform").Rotation
+    b = p2b.AttitudeBuffer(8)
+    b.push_batch([0.0, 1.0], Rotation.from_euler("z", [[0.0], [20.0]], degrees=True))
+    np.testing.assert_allclose(b.at(0.5), yaw(10.0), atol=1e-12)
+
+
+def test_attitude_source_for_projection(buffer):
+    # Events with individual timestamps projected in one call (per-point attitudes)
+    rng = np.random.default_rng(5)
+    rows = rng.integers(0, W, 20).astype(np.uint64)
+    cols = rng.integers(0, H, 20).astype(np.uint64)
+    t = np.sort(rng.uniform(0.0, 0.099, 20))
+    neds = p2b.pixel_to_ned_batch(rows, cols, W, H, P2T, CAM, buffer.at_batch(t))
+    for i in range(20):
+        np.testing.assert_allclose(
+            neds[i], p2b.pixel_to_ned(int(rows[i]), int(cols[i]), W, H, P2T, CAM, buffer.at(t[i])), atol=1e-12)
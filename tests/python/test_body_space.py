@@ -134,6 +134,24 @@ class TestPixelAtElevation:
         assert abs(row - 320) <= 1
         assert abs(col - 240) <= 1
 
+    def test_batch_matches_scalar(self):
+        p2t = p2b.pixel_to_tan_from_fov(640, 480, math.radians(90))
+        cam = p2b.cam_to_body_from_angle(math.radians(10))
+        rows = np.array([100, 320, 500, 600], dtype=np.uint64)
+        cols = np.array([50, 240, 400, 100], dtype=np.uint64)
+        el = math.radians(3)
+        batch = p2b.pixel_at_elevation_batch(rows, cols, 640, 480, p2t, cam, IDENTITY, el)
+        assert batch.shape == (4, 2)
+        for i in range(4):
+            r, c = p2b.pixel_at_elevation(int(rows[i]), int(cols[i]), 640, 480, p2t, cam, IDENTITY, el)
+            assert (int(batch[i, 0]), int(batch[i, 1])) == (r, c)
+
+    def test_ned_at_elevation_keeps_azimuth(self):
+        ned = p2b.azimuth_elevation_to_ned(0.6, -0.1)
+        az, el = p2b.ned_to_azimuth_elevation(p2b.ned_at_elevation(ned, 0.25))
+        assert abs(az - 0.6) < EPSILON
+        assert abs(el - 0.25) < EPSILON
+
 
 class TestNedAngleInPixels:
     def test_same_direction_zero(self):
@@ -253,3 +271,244 @@ class TestBatchOperations:
             640, 480, p2t, IDENTITY, IDENTITY)
 
         np.testing.assert_allclose(batch_neds, scalar_neds, atol=1e-10)
+
+
+class TestBatchCoverage:
+    """Batch forms of the remaining scalar functions match their scalar counterparts."""
+
+    P2T = p2b.pixel_to_tan_from_fov(640, 480, math.radians(60))
+    CAM = p2b.cam_to_body_from_angle(math.radians(10))
+    ATT = np.array([0.9848, 0.0, 0.0, 0.1736]) / np.linalg.norm([0.9848, 0.0, 0.0, 0.1736])
+
+    def _neds(self, n=50):
+        rng = np.random.default_rng(3)
+        rows = rng.integers(0, 640, n).astype(np.uint64)
+        cols = rng.integers(0, 480, n).astype(np.uint64)
+        return p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, self.ATT)
+
+    def test_cam_to_body_from_angle_batch(self):
+        angles = np.radians([0.0, 10.0, -25.0])
+        batch = p2b.cam_to_body_from_angle_batch(angles)
+        assert batch.shape == (3, 4)
+        for a, q in zip(angles, batch):
+            np.testing.assert_allclose(q, p2b.cam_to_body_from_angle(a), atol=1e-15)
+
+    def test_tangents_round_trip(self):
+        w = np.array([0.0, 0.1, -0.3])
+        h = np.array([0.0, -0.2, 0.05])
+        neds = p2b.tangents_to_ned_batch(w, h)
+        assert neds.shape == (3, 3)
+        for i in range(3):
+            np.testing.assert_allclose(neds[i], p2b.tangents_to_ned(w[i], h[i]), atol=1e-15)
+        tans = p2b.ned_to_tangents_batch(neds)
+        assert tans.shape == (3, 2)
+        for i in range(3):
+            np.testing.assert_allclose(tans[i], p2b.ned_to_tangents(neds[i]), atol=1e-15)
+
+    def test_azimuth_elevation_round_trip(self):
+        neds = self._neds()
+        az_el = p2b.ned_to_azimuth_elevation_batch(neds)
+        assert az_el.shape == (len(neds), 2)
+        for ned, (az, el) in zip(neds, az_el):
+            np.testing.assert_allclose((az, el), p2b.ned_to_azimuth_elevation(ned), atol=1e-15)
+        back = p2b.azimuth_elevation_to_ned_batch(az_el[:, 0], az_el[:, 1])
+        np.testing.assert_allclose(back, neds, atol=1e-12)
+
+    def test_warp_body_to_image_batch(self):
+        dirs = p2b.warp_image_to_body_batch(np.array([0.0, 0.2]), np.array([0.1, -0.1]), self.CAM)
+        tans = p2b.warp_body_to_image_batch(dirs, self.CAM)
+        for d, t in zip(dirs, tans):
+            np.testing.assert_allclose(t, p2b.warp_body_to_image(d, self.CAM), atol=1e-15)
+
+    def test_inside_frame_batches(self):
+        rows = np.array([0, 10, 320, 630, 639], dtype=np.uint64)
+        cols = np.array([0, 240, 240, 10, 479], dtype=np.uint64)
+        inside = p2b.is_pixel_inside_frame_batch(rows, cols, 640, 480, 0.05)
+        assert inside.dtype == np.bool_
+        assert list(inside) == [p2b.is_pixel_inside_frame(int(r), int(c), 640, 480, 0.05) for r, c in zip(rows, cols)]
+
+        neds = np.vstack([self._neds(), -self._neds(5)])
+        visible = p2b.is_ned_inside_frame_batch(neds, 640, 480, self.P2T, self.CAM, self.ATT, 0.1)
+        assert list(visible) == [
+            p2b.is_ned_inside_frame(n, 640, 480, self.P2T, self.CAM, self.ATT, 0.1) for n in neds]
+
+    def test_ned_at_elevation_batch(self):
+        neds = self._neds()
+        el = math.radians(-3.0)
+        out = p2b.ned_at_elevation_batch(neds, el)
+        for n, o in zip(neds, out):
+            np.testing.assert_allclose(o, p2b.ned_at_elevation(n, el), atol=1e-15)
+
+    def test_ned_angle_in_pixels_batch(self):
+        a = self._neds()
+        b = np.roll(a, 1, axis=0)
+        dist = p2b.ned_angle_in_pixels_batch(a, b, self.P2T)
+        assert dist.shape == (len(a),)
+        for x, y, d in zip(a, b, dist):
+            assert d == pytest.approx(p2b.ned_angle_in_pixels(x, y, self.P2T))
+
+    def test_shape_errors(self):
+        with pytest.raises(ValueError):
+            p2b.ned_to_tangents_batch(np.zeros((4, 2)))
+        with pytest.raises(ValueError):
+            p2b.tangents_to_ned_batch(np.zeros(3), np.zeros(2))
+
+
+class TestBatchInputLayouts:
+    """Strided views, (N, 2) pixel pairs and integer dtypes are read without conversion."""
+
+    P2T = p2b.pixel_to_tan_from_fov(640, 480, math.radians(60))
+    CAM = p2b.cam_to_body_from_angle(math.radians(10))
+
+    def _pixels(self, n=64):
+        rng = np.random.default_rng(11)
+        return np.stack([rng.integers(0, 640, n), rng.integers(0, 480, n)], axis=1)
+
+    def _reference(self, px):
+        rows = np.ascontiguousarray(px[:, 0], dtype=np.uint64)
+        cols = np.ascontiguousarray(px[:, 1], dtype=np.uint64)
+        return p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, IDENTITY)
+
+    @pytest.mark.parametrize("dtype", [np.uint16, np.int32, np.uint32, np.int64, np.uint64])
+    def test_integer_dtypes(self, dtype):
+        px = self._pixels().astype(dtype)
+        out = p2b.pixel_to_ned_batch(px[:, 0].copy(), px[:, 1].copy(), 640, 480, self.P2T, self.CAM, IDENTITY)
+        np.testing.assert_array_equal(out, self._reference(px))
+
+    @pytest.mark.parametrize("dtype", [np.int32, np.uint64])
+    def test_interleaved_pairs(self, dtype):
+        px = self._pixels().astype(dtype)
+        out = p2b.pixel_to_ned_batch(px, None, 640, 480, self.P2T, self.CAM, IDENTITY)
+        np.testing.assert_array_equal(out, self._reference(px))
+        moved = p2b.pixel_after_rotation_batch(px, None, 640, 480, self.P2T, self.CAM, IDENTITY, IDENTITY)
+        assert moved.shape == (len(px), 2)
+
+    def test_column_slices_of_wider_array(self):
+        table = np.zeros((64, 5), dtype=np.int64)
+        table[:, 1:3] = self._pixels()
+        out = p2b.pixel_to_ned_batch(table[:, 1], table[:, 2], 640, 480, self.P2T, self.CAM, IDENTITY)
+        np.testing.assert_array_equal(out, self._reference(table[:, 1:3]))
+        inside = p2b.is_pixel_inside_frame_batch(table[::2, 1:3], None, 640, 480, 0.1)
+        assert inside.shape == (32,)
+
+    def test_strided_directions(self):
+        neds = self._reference(self._pixels())
+        wide = np.zeros((len(neds), 6))
+        wide[:, 3:] = neds
+        np.testing.assert_array_equal(
+            p2b.ned_to_pixel_batch(wide[:, 3:], 640, 480, self.P2T, self.CAM, IDENTITY),
+            p2b.ned_to_pixel_batch(neds, 640, 480, self.P2T, self.CAM, IDENTITY))
+        np.testing.assert_array_equal(p2b.ned_to_tangents_batch(neds[::-1]), p2b.ned_to_tangents_batch(neds)[::-1])
+
+    def test_mixed_dtypes_are_promoted(self):
+        px = self._pixels()
+        out = p2b.pixel_to_ned_batch(px[:, 0].astype(np.int32), px[:, 1].astype(np.uint16),
+                                     640, 480, self.P2T, self.CAM, IDENTITY)
+        np.testing.assert_array_equal(out, self._reference(px))
+
+    def test_pairs_shape_error(self):
+        with pytest.raises(ValueError):
+            p2b.pixel_to_ned_batch(np.zeros((4, 3), dtype=np.int32), None, 640, 480, self.P2T, self.CAM, IDENTITY)
+
+
+class TestPerPointAttitudes:
+    """Batch functions take one attitude per point as (N, 4) or a multi-rotation scipy Rotation."""
+
+    P2T = p2b.pixel_to_tan_from_fov(640, 480, math.radians(60))
+    CAM = p2b.cam_to_body_from_angle(math.radians(10))
+    N = 40
+
+    def _inputs(self):
+        rng = np.random.default_rng(5)
+        rows = rng.integers(0, 640, self.N).astype(np.uint64)
+        cols = rng.integers(0, 480, self.N).astype(np.uint64)
+        yaw = rng.uniform(-0.3, 0.3, self.N)
+        atts = np.stack([np.cos(yaw / 2), np.zeros(self.N), np.zeros(self.N), np.sin(yaw / 2)], axis=1)
+        return rows, cols, atts
+
+    def test_pixel_to_ned_and_back(self):
+        rows, cols, atts = self._inputs()
+        neds = p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, atts)
+        for i in range(self.N):
+            np.testing.assert_allclose(
+                neds[i], p2b.pixel_to_ned(int(rows[i]), int(cols[i]), 640, 480, self.P2T, self.CAM, atts[i]),
+                atol=1e-15)
+        pixels = p2b.ned_to_pixel_batch(neds, 640, 480, self.P2T, self.CAM, atts)
+        for i in range(self.N):
+            assert tuple(pixels[i]) == p2b.ned_to_pixel(neds[i], 640, 480, self.P2T, self.CAM, atts[i])
+        visible = p2b.is_ned_inside_frame_batch(neds, 640, 480, self.P2T, self.CAM, atts, 0.1)
+        assert list(visible) == [
+            p2b.is_ned_inside_frame(neds[i], 640, 480, self.P2T, self.CAM, atts[i], 0.1) for i in range(self.N)]
+
+    def test_pixel_after_rotation_broadcasts_single(self):
+        rows, cols, atts = self._inputs()
+        moved = p2b.pixel_after_rotation_batch(rows, cols, 640, 480, self.P2T, self.CAM, IDENTITY, atts)
+        for i in range(self.N):
+            assert tuple(moved[i]) == p2b.pixel_after_rotation(
+                int(rows[i]), int(cols[i]), 640, 480, self.P2T, self.CAM, IDENTITY, atts[i])
+
+    def test_pixel_at_elevation(self):
+        rows, cols, atts = self._inputs()
+        el = math.radians(-2.0)
+        out = p2b.pixel_at_elevation_batch(rows, cols, 640, 480, self.P2T, self.CAM, atts, el)
+        for i in range(self.N):
+            assert tuple(out[i]) == p2b.pixel_at_elevation(
+                int(rows[i]), int(cols[i]), 640, 480, self.P2T, self.CAM, atts[i], el)
+
+    def test_scipy_multi_rotation(self):
+        Rotation = pytest.importorskip("scipy.spatial.transform").Rotation
+        rows, cols, atts = self._inputs()
+        rot = Rotation.from_quat(atts[:, [1, 2, 3, 0]])
+        np.testing.assert_allclose(
+            p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, rot),
+            p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, atts), atol=1e-12)
+
+    def test_length_mismatch(self):
+        rows, cols, atts = self._inputs()
+        with pytest.raises(ValueError):
+            p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, atts[:-1])
+
+
+class TestBroadcast:
+    """M attitudes x N points -> (M, N, ...)."""
+
+    P2T = p2b.pixel_to_tan_from_fov(640, 480, math.radians(60))
+    CAM = p2b.cam_to_body_from_angle(math.radians(10))
+
+    def _inputs(self, n=30, m=4):
+        rng = np.random.default_rng(9)
+        rows = rng.integers(0, 640, n).astype(np.uint64)
+        cols = rng.integers(0, 480, n).astype(np.uint64)
+        yaw = np.linspace(-0.2, 0.2, m)
+        atts = np.stack([np.cos(yaw / 2), np.zeros(m), np.zeros(m), np.sin(yaw / 2)], axis=1)
+        return rows, cols, atts
+
+    def test_pixel_to_ned_broadcast(self):
+        rows, cols, atts = self._inputs()
+        out = p2b.pixel_to_ned_broadcast(rows, cols, 640, 480, self.P2T, self.CAM, atts)
+        assert out.shape == (len(atts), len(rows), 3)
+        for k, att in enumerate(atts):
+            np.testing.assert_allclose(
+                out[k], p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, att), atol=1e-12)
+
+    def test_ned_to_pixel_broadcast(self):
+        rows, cols, atts = self._inputs()
+        neds = p2b.pixel_to_ned_batch(rows, cols, 640, 480, self.P2T, self.CAM, atts[0])
+        out = p2b.ned_to_pixel_broadcast(neds, 640, 480, self.P2T, self.CAM, atts)
+        assert out.shape == (len(atts), len(neds), 2)
+        for k, att in enumerate(atts):
+            ref = p2b.ned_to_pixel_batch(neds, 640, 480, self.P2T, self.CAM, att)
+            assert np.abs(out[k].astype(np.int64) - ref.astype(np.int64)).max() <= 1
+
+    def test_single_attitude_gives_leading_axis(self):
+        rows, cols, _ = self._inputs()
+        out = p2b.pixel_to_ned_broadcast(rows, cols, 640, 480, self.P2T, self.CAM, IDENTITY)
+        assert out.shape == (1, len(rows), 3)
+
+    def test_scipy_rotations(self):
+        Rotation = pytest.importorskip("scipy.spatial.transform").Rotation
+        rows, cols, atts = self._inputs()
+        rot = Rotation.from_quat(atts[:, [1, 2, 3, 0]])
+        np.testing.assert_allclose(
+            p2b.pixel_to_ned_broadcast(rows, cols, 640, 480, self.P2T, self.CAM, rot),
+            p2b.pixel_to_ned_broadcast(rows, cols, 640, 480, self.P2T, self.CAM, atts), atol=1e-12)
@@ -0,0 +1,68 @@
+"""Tests for camera installation calibration."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 1280, 720
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(70))
+ROLL = np.array([0.9998, 0.015, 0.0, -0.01])
+ROLL /= np.linalg.norm(ROLL)
+
+
+@pytest.fixture(scope="module")
+def cam(quat_mul):
+    """Mount tilted 12 degrees, rolled and yawed slightly."""
+    return quat_mul(p2b.cam_to_body_from_angle(math.radians(12)), ROLL)
+
+
+def observations(cam, n, seed=1, ptt=P2T):
+    """Known directions seen at integer pixels under random attitudes of a camera mounted at cam."""
+    rng = np.random.default_rng(seed)
+    rows = rng.integers(0, W, n).astype(np.uint64)
+    cols = rng.integers(0, H, n).astype(np.uint64)
+    atts = np.column_stack([np.ones(n), rng.uniform(-0.3, 0.3, (n, 2)), rng.uniform(-1.2, 1.2, n)])
+    atts /= np.linalg.norm(atts, axis=1, keepdims=True)
+    dirs = p2b.pixel_to_ned_batch(rows, cols, W, H, ptt, cam, atts)
+    return atts, np.column_stack([rows, cols]).astype(np.float64), dirs
+
+
+def test_recovers_mount_from_poor_guess(cam, rotation_angle):
+    atts, pixels, dirs = observations(cam, 500)
+    solved, ptt, rms, used, converged = p2b.calibrate_cam_to_body(
+        atts, pixels, dirs, W, H, P2T, initial=p2b.cam_to_body_from_angle(0.0))
+    assert converged and used == 500
+    assert ptt == P2T
+    assert rms < 1e-6
+    assert rotation_angle(solved, cam) < 1e-9
+
+
+def test_noise_and_pixel_to_tan(cam, rotation_angle):
+    atts, pixels, dirs = observations(cam, 5000, seed=2)
+    pixels += np.random.default_rng(3).uniform(-0.5, 0.5, pixels.shape)
+    solved, ptt, rms, _, converged = p2b.calibrate_cam_to_body(
+        atts, pixels, dirs, W, H, P2T * 1.05, estimate_pixel_to_tan=True)
+    assert converged
+    assert ptt == pytest.approx(P2T, rel=1e-4)
+    assert rotation_angle(solved, cam) < 0.05 * P2T
+    assert rms == pytest.approx(math.sqrt(1.0 / 12.0), rel=0.05)  # uniform +-0.5 px per axis
+
+
+def test_thread_count_does_not_change_result(cam, rotation_angle):
+    atts, pixels, dirs = observations(cam, 20000, seed=4)
+    pixels += 0.3
+    one = p2b.calibrate_cam_to_body(atts, pixels, dirs, W, H, P2T, threads=1)
+    many = p2b.calibrate_cam_to_body(atts, pixels, dirs, W, H, P2T, threads=4)
+    assert rotation_angle(one[0], many[0]) < 1e-10
+    assert one[2] == pytest.approx(many[2], rel=1e-9)
+
+
+def test_rejects_bad_shapes(cam):
+    atts, pixels, dirs = observations(cam, 10)
+    with pytest.raises(ValueError):
+        p2b.calibrate_cam_to_body(atts[:5], pixels, dirs, W, H, P2T)
+    with pytest.raises(ValueError):
+        p2b.calibrate_cam_to_body(atts, pixels, dirs[:, :2], W, H, P2T)
@@ -0,0 +1,95 @@
+"""Tests for the Camera class with prepared state."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 640, 480
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(60))
+CAM = p2b.cam_to_body_from_angle(math.radians(10))
+ATT = np.array([0.9848, 0.0, 0.0, 0.1736])
+ATT /= np.linalg.norm(ATT)
+ATT_NEW = np.array([0.9845, 0.0087, 0.0, 0.1752])
+ATT_NEW /= np.linalg.norm(ATT_NEW)
+
+PIXELS = [(0, 0), (320, 240), (639, 479), (100, 400), (500, 50)]
+
+
+@pytest.fixture
+def camera():
+    return p2b.Camera(W, H, P2T, CAM, ATT)
+
+
+def test_properties(camera):
+    assert camera.width == W and camera.height == H
+    assert camera.pixel_to_tan == pytest.approx(P2T)
+    np.testing.assert_allclose(camera.cam_to_body, CAM)
+    np.testing.assert_allclose(camera.attitude, ATT)
+
+
+def test_pixel_to_ned_matches_free_function(camera):
+    for row, col in PIXELS:
+        np.testing.assert_allclose(
+            camera.pixel_to_ned(row, col), p2b.pixel_to_ned(row, col, W, H, P2T, CAM, ATT), atol=1e-12)
+
+
+def test_ned_to_pixel_roundtrip(camera):
+    for row, col in PIXELS:
+        assert camera.ned_to_pixel(camera.pixel_to_ned(row, col)) == pytest.approx((row, col), abs=1)
+
+
+def test_pixel_after_rotation_matches_free_function(camera):
+    for row, col in PIXELS:
+        expected = p2b.pixel_after_rotation(row, col, W, H, P2T, CAM, ATT, ATT_NEW)
+        assert camera.pixel_after_rotation(row, col, ATT_NEW) == pytest.approx(expected, abs=1)
+
+
+def test_is_inside(camera):
+    assert camera.is_inside(camera.pixel_to_ned(320, 240), 0.1)
+    behind = tuple(-v for v in camera.pixel_to_ned(320, 240))
+    assert not camera.is_inside(behind, 0.0)
+
+
+def test_set_attitude(camera):
+    camera.set_attitude(ATT_NEW)
+    np.testing.assert_allclose(
+        camera.pixel_to_ned(100, 200), p2b.pixel_to_ned(100, 200, W, H, P2T, CAM, ATT_NEW), atol=1e-12)
+
+
+def test_accepts_scipy_rotation():
+    Rotation = pytest.importorskip("scipy.spatial.transform").Rotation
+    rot = Rotation.from_quat([ATT[1], ATT[2], ATT[3], ATT[0]])
+    camera = p2b.Camera(W, H, P2T, CAM, rot)
+    np.testing.assert_allclose(camera.attitude, ATT, atol=1e-12)
+
+
+def test_batch_matches_scalar(camera):
+    rng = np.random.default_rng(7)
+    rows = rng.integers(0, W, 200).astype(np.uint64)
+    cols = rng.integers(0, H, 200).astype(np.uint64)
+
+    neds = camera.pixel_to_ned_batch(rows, cols)
+    assert neds.shape == (200, 3)
+    pixels = camera.ned_to_pixel_batch(neds)
+    moved = camera.pixel_after_rotation_batch(rows, cols, ATT_NEW)
+    inside = camera.is_inside_batch(neds, 0.05)
+    for i in range(0, 200, 17):
+        r, c = int(rows[i]), int(cols[i])
+        np.testing.assert_allclose(neds[i], camera.pixel_to_ned(r, c), atol=1e-15)
+        assert tuple(pixels[i]) == camera.ned_to_pixel(tuple(neds[i]))
+        assert tuple(moved[i]) == camera.pixel_after_rotation(r, c, ATT_NEW)
+        assert bool(inside[i]) == camera.is_inside(tuple(neds[i]), 0.05)
+
+
+def test_batch_accepts_int64_rows(camera):
+    rows = np.arange(10, dtype=np.int64)
+    np.testing.assert_allclose(camera.pixel_to_ned_batch(rows, rows), camera.pixel_to_ned_batch(
+        rows.astype(np.uint64), rows.astype(np.uint64)))
+
+
+def test_batch_length_mismatch(camera):
+    with pytest.raises(ValueError):
+        camera.pixel_to_ned_batch(np.zeros(3, dtype=np.uint64), np.zeros(2, dtype=np.uint64))
@@ -0,0 +1,67 @@
+"""End-to-end tests for analytic elevation contours."""
+
+import math
+
+import numpy as np
+
+import image_to_body_math as p2b
+
+EPSILON = 1e-6
+IDENTITY = np.array([1.0, 0.0, 0.0, 0.0])
+ROLL_10 = np.array([math.cos(0.0873), math.sin(0.0873), 0.0, 0.0])
+
+
+def _elevation_at(row, col, width, height, p2t, cam, att):
+    w_tan = (row - width / 2.0) * p2t
+    h_tan = (col - height / 2.0) * p2t
+    body = p2b.warp_image_to_body(w_tan, h_tan, cam)
+    w, x, y, z = att
+    u = np.array([x, y, z])
+    t = 2.0 * np.cross(u, body)
+    ned = body + w * t + np.cross(u, t)
+    return p2b.ned_to_azimuth_elevation(ned / np.linalg.norm(ned))[1]
+
+
+class TestHorizonLine:
+    def test_level_camera_center_col(self):
+        p2t = p2b.pixel_to_tan_from_fov(640, 480, math.radians(90))
+        cols = p2b.horizon_line(640, 480, p2t, IDENTITY, IDENTITY)
+        assert cols.shape == (640,)
+        np.testing.assert_allclose(cols, 240.0, atol=EPSILON)
+
+    def test_crossings_at_zero_elevation(self):
+        p2t = p2b.pixel_to_tan_from_fov(1920, 1080, math.radians(60))
+        cam = p2b.cam_to_body_from_angle(math.radians(5))
+        cols = p2b.horizon_line(1920, 1080, p2t, cam, ROLL_10)
+        for row in range(0, 1920, 191):
+            assert abs(_elevation_at(row, cols[row], 1920, 1080, p2t, cam, ROLL_10)) < EPSILON
+
+
+class TestElevationContour:
+    def test_cols_shape_and_elevation(self):
+        p2t = p2b.pixel_to_tan_from_fov(1280, 720, math.radians(90))
+        cam = p2b.cam_to_body_from_angle(math.radians(40))
+        el = math.radians(-30)
+        out = p2b.elevation_contour_cols(1280, 720, p2t, cam, IDENTITY, el)
+        assert out.shape == (1280, 2)
+        valid = [(r, c) for r in range(0, 1280, 64) for c in out[r] if not np.isnan(c)]
+        assert valid
+        for r, c in valid:
+            assert abs(_elevation_at(r, c, 1280, 720, p2t, cam, IDENTITY) - el) < EPSILON
+
+    def test_rows_shape_and_elevation(self):
+        p2t = p2b.pixel_to_tan_from_fov(1280, 720, math.radians(90))
+        cam = p2b.cam_to_body_from_angle(math.radians(20))
+        el = math.radians(-10)
+        out = p2b.elevation_contour_rows(1280, 720, p2t, cam, ROLL_10, el)
+        assert out.shape == (720, 2)
+        valid = [(r, c) for c in range(0, 720, 36) for r in out[c] if not np.isnan(r)]
+        assert valid
+        for r, c in valid:
+            assert abs(_elevation_at(r, c, 1280, 720, p2t, cam, ROLL_10) - el) < EPSILON
+
+    def test_scalar_matches_raster(self):
+        p2t = p2b.pixel_to_tan_from_fov(640, 480, math.radians(90))
+        out = p2b.elevation_contour_cols(640, 480, p2t, IDENTITY, ROLL_10, 0.05)
+        c1, c2 = p2b.elevation_contour_at_row(100, 640, 480, p2t, IDENTITY, ROLL_10, 0.05)
+        np.testing.assert_allclose(out[100], [c1, c2], equal_nan=True)
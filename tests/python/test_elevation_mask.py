@@ -0,0 +1,61 @@
+"""End-to-end tests for sky/ground mask generation."""
+
+import math
+
+import numpy as np
+
+import image_to_body_math as p2b
+
+IDENTITY = np.array([1.0, 0.0, 0.0, 0.0])
+ROLL_30 = np.array([math.cos(math.radians(15)), math.sin(math.radians(15)), 0.0, 0.0])
+
+
+def _reference_mask(width, height, p2t, cam, att, threshold):
+    rows = np.tile(np.arange(width, dtype=np.uint64), height)
+    cols = np.repeat(np.arange(height, dtype=np.uint64), width)
+    neds = p2b.pixel_to_ned_batch(rows, cols, width, height, p2t, cam, att)
+    sin_el = -neds[:, 2] / np.linalg.norm(neds, axis=1)
+    return (sin_el > math.sin(threshold)).reshape(height, width), np.abs(sin_el - math.sin(threshold)).reshape(
+        height, width)
+
+
+class TestElevationMask:
+    def test_shape_and_values(self):
+        p2t = p2b.pixel_to_tan_from_fov(64, 48, math.radians(90))
+        mask = p2b.elevation_mask(64, 48, p2t, IDENTITY, IDENTITY, 0.0)
+        assert mask.shape == (48, 64)
+        assert mask.dtype == np.uint8
+        assert set(np.unique(mask)) <= {0, 255}
+        assert mask[0, 0] == 255
+        assert mask[-1, -1] == 0
+
+    def test_matches_per_pixel_projection(self):
+        w, h = 320, 256
+        p2t = p2b.pixel_to_tan_from_fov(w, h, math.radians(90))
+        cam = p2b.cam_to_body_from_angle(math.radians(30))
+        thr = math.radians(-20)
+        expected, gap = _reference_mask(w, h, p2t, cam, ROLL_30, thr)
+        decided = gap > 1e-9
+        sky = p2b.elevation_mask(w, h, p2t, cam, ROLL_30, thr, side=p2b.MaskSide.ABOVE, value=1)
+        ground = p2b.elevation_mask(w, h, p2t, cam, ROLL_30, thr, side=p2b.MaskSide.BELOW, value=1)
+        np.testing.assert_array_equal(sky.astype(bool)[decided], expected[decided])
+        np.testing.assert_array_equal(ground.astype(bool)[decided], ~expected[decided])
+
+    def test_spans_match_mask(self):
+        w, h = 320, 256
+        p2t = p2b.pixel_to_tan_from_fov(w, h, math.radians(90))
+        cam = p2b.cam_to_body_from_angle(math.radians(30))
+        mask = p2b.elevation_mask(w, h, p2t, cam, ROLL_30, -0.3, margin_px=2.0)
+        spans = p2b.elevation_mask_spans(w, h, p2t, cam, ROLL_30, -0.3, margin_px=2.0)
+        assert spans.ndim == 2 and spans.shape[1] == 3
+        rebuilt = np.zeros((h, w), dtype=np.uint8)
+        for col, begin, end in spans:
+            rebuilt[col, begin:end] = 255
+        np.testing.assert_array_equal(rebuilt, mask)
+
+    def test_margin_shrinks_selection(self):
+        p2t = p2b.pixel_to_tan_from_fov(64, 48, math.radians(90))
+        tight = p2b.elevation_mask(64, 48, p2t, IDENTITY, IDENTITY, 0.0, margin_px=3.0)
+        loose = p2b.elevation_mask(64, 48, p2t, IDENTITY, IDENTITY, 0.0, margin_px=-3.0)
+        assert np.count_nonzero(tight) < np.count_nonzero(loose)
+        assert not np.any(tight & ~loose)
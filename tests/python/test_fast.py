@@ -0,0 +1,77 @@
+"""Tests for the tuple-based fast scalar convention."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+from image_to_body_math import fast
+
+W, H = 640, 480
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(60))
+CAM = fast.cam_to_body_from_angle(math.radians(10))
+ATT = (0.9848, 0.0, 0.0, 0.1736)
+ATT2 = (0.9845, 0.0087, 0.0, 0.1752)
+
+
+def test_returns_tuples():
+    ned = fast.pixel_to_ned(100, 200, W, H, P2T, CAM, ATT)
+    assert isinstance(ned, tuple) and len(ned) == 3
+    assert isinstance(CAM, tuple) and len(CAM) == 4
+    assert isinstance(fast.ned_to_pixel(ned, W, H, P2T, CAM, ATT), tuple)
+
+
+def test_matches_numpy_convention():
+    cam_np = np.array(CAM)
+    att_np = np.array(ATT)
+    for row, col in [(0, 0), (320, 240), (639, 479), (100, 400)]:
+        ned = fast.pixel_to_ned(row, col, W, H, P2T, CAM, ATT)
+        np.testing.assert_allclose(ned, p2b.pixel_to_ned(row, col, W, H, P2T, cam_np, att_np), atol=1e-15)
+        assert fast.ned_to_pixel(ned, W, H, P2T, CAM, ATT) == p2b.ned_to_pixel(ned, W, H, P2T, cam_np, att_np)
+        assert fast.pixel_after_rotation(row, col, W, H, P2T, CAM, ATT, ATT2) == p2b.pixel_after_rotation(
+            row, col, W, H, P2T, cam_np, att_np, np.array(ATT2))
+        assert fast.pixel_at_elevation(row, col, W, H, P2T, CAM, ATT, -0.1) == p2b.pixel_at_elevation(
+            row, col, W, H, P2T, cam_np, att_np, -0.1)
+
+
+def test_vector_functions_match():
+    ned = fast.tangents_to_ned(0.2, -0.1)
+    np.testing.assert_allclose(ned, p2b.tangents_to_ned(0.2, -0.1), atol=1e-15)
+    assert fast.ned_to_tangents(ned) == pytest.approx(p2b.ned_to_tangents(np.array(ned)))
+    assert fast.ned_to_azimuth_elevation(ned) == pytest.approx(p2b.ned_to_azimuth_elevation(np.array(ned)))
+    np.testing.assert_allclose(fast.azimuth_elevation_to_ned(0.3, -0.2), p2b.azimuth_elevation_to_ned(0.3, -0.2))
+    np.testing.assert_allclose(fast.warp_image_to_body(0.1, 0.2, CAM), p2b.warp_image_to_body(0.1, 0.2, np.array(CAM)))
+    assert fast.warp_body_to_image(ned, CAM) == pytest.approx(p2b.warp_body_to_image(np.array(ned), np.array(CAM)))
+    np.testing.assert_allclose(fast.ned_at_elevation(ned, 0.3), p2b.ned_at_elevation(np.array(ned), 0.3))
+    other = fast.tangents_to_ned(0.25, -0.1)
+    assert fast.ned_angle_in_pixels(ned, other, P2T) == pytest.approx(
+        p2b.ned_angle_in_pixels(np.array(ned), np.array(other), P2T))
+    assert fast.is_ned_inside_frame(ned, W, H, P2T, CAM, ATT, 0.0) == p2b.is_ned_inside_frame(
+        np.array(ned), W, H, P2T, np.array(CAM), np.array(ATT), 0.0)
+
+
+def test_accepts_lists_and_arrays():
+    ned_t = fast.pixel_to_ned(10, 20, W, H, P2T, list(CAM), np.array(ATT))
+    assert ned_t == fast.pixel_to_ned(10, 20, W, H, P2T, CAM, ATT)
+
+
+def test_wrong_length_rejected():
+    with pytest.raises(TypeError):
+        fast.pixel_to_ned(10, 20, W, H, P2T, (1.0, 0.0, 0.0), ATT)
+    with pytest.raises(TypeError):
+        fast.ned_to_tangents((1.0, 0.0))
+
+
+def test_scalar_only_functions_reexported():
+    assert fast.pixel_to_tan_from_fov(W, H, math.radians(60)) == P2T
+    assert fast.is_pixel_inside_frame(10, 10, W, H, 0.0) is True
+
+
+def test_numpy_api_still_accepts_rotation():
+    Rotation = pytest.importorskip("scipy.spatial.transform").Rotation
+    rot = Rotation.from_euler("z", 20, degrees=True)
+    wxyz = np.roll(rot.as_quat(), 1)
+    np.testing.assert_allclose(
+        p2b.pixel_to_ned(100, 200, W, H, P2T, np.array(CAM), rot),
+        p2b.pixel_to_ned(100, 200, W, H, P2T, np.array(CAM), wxyz))
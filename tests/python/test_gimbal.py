@@ -0,0 +1,137 @@
+"""Tests for the pan/tilt/roll gimbal chain."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 1280, 720
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(70))
+BASE = np.array([0.999, 0.01, -0.03, 0.02])
+BASE /= np.linalg.norm(BASE)
+SENSOR = np.array([0.9995, -0.02, 0.01, 0.015])
+SENSOR /= np.linalg.norm(SENSOR)
+ATT = np.array([0.9848, 0.0436, -0.02, 0.1736])
+ATT /= np.linalg.norm(ATT)
+
+
+@pytest.fixture
+def chain(quat_mul, axis_angle):
+    """Mount composed joint by joint: base * Rz(pan) * Ry(-tilt) * Rx(roll) * sensor."""
+    def compose(pan, tilt, roll):
+        q = quat_mul(BASE, axis_angle([0, 0, 1], pan))
+        q = quat_mul(q, axis_angle([0, 1, 0], -tilt))
+        q = quat_mul(q, axis_angle([1, 0, 0], roll))
+        return quat_mul(q, SENSOR)
+    return compose
+
+
+def logged_joints(n):
+    """Per-frame joints where pan slews, tilt steps every 10 frames and roll holds still."""
+    i = np.arange(n)
+    return np.column_stack([0.01 * i - 0.5, 0.1 * (i // 10), np.full(n, 0.03)])
+
+
+def test_tilt_only_matches_cam_to_body_from_angle(rotation_angle):
+    tilt = math.radians(12)
+    assert rotation_angle(p2b.gimbal_cam_to_body(0.0, tilt), p2b.cam_to_body_from_angle(tilt)) < 1e-14
+
+
+def test_matches_composed_joint_rotations(chain, rotation_angle):
+    q = p2b.gimbal_cam_to_body(0.7, -0.3, 0.2, BASE, SENSOR)
+    assert rotation_angle(q, chain(0.7, -0.3, 0.2)) < 1e-14
+
+
+def test_batch_matches_scalar(rotation_angle):
+    joints = logged_joints(60)
+    out = p2b.gimbal_cam_to_body_batch(joints, BASE, SENSOR)
+    assert out.shape == (60, 4)
+    for q, (pan, tilt, roll) in zip(out, joints):
+        assert rotation_angle(q, p2b.gimbal_cam_to_body(pan, tilt, roll, BASE, SENSOR)) < 1e-14
+
+
+def test_projection_matches_per_frame_cam_to_body():
+    n = 60
+    joints = logged_joints(n)
+    rows = np.linspace(10, W - 10, n).astype(np.uint64)
+    cols = np.linspace(H - 10, 10, n).astype(np.uint64)
+    dirs = p2b.pixel_to_ned_batch_gimbal(rows, cols, W, H, P2T, joints, ATT, BASE, SENSOR)
+    assert dirs.shape == (n, 3)
+    for i in range(n):
+        cam = p2b.gimbal_cam_to_body(*joints[i], BASE, SENSOR)
+        np.testing.assert_allclose(dirs[i], p2b.pixel_to_ned(int(rows[i]), int(cols[i]), W, H, P2T, cam, ATT),
+                                   atol=1e-14)
+
+    pixels = p2b.ned_to_pixel_batch_gimbal(dirs, W, H, P2T, joints, ATT, BASE, SENSOR)
+    assert pixels.dtype == np.uint64
+    assert np.all(np.abs(pixels.astype(np.int64) - np.column_stack([rows, cols]).astype(np.int64)) <= 1)
+
+    # One attitude per frame gives the same answer when they are all equal
+    per_frame = p2b.pixel_to_ned_batch_gimbal(rows, cols, W, H, P2T, joints, np.tile(ATT, (n, 1)), BASE, SENSOR)
+    np.testing.assert_array_equal(per_frame, dirs)
+
+
+def test_camera_set_cam_to_body():
+    cam = p2b.gimbal_cam_to_body(0.4, 0.25, 0.05, BASE, SENSOR)
+    camera = p2b.Camera(W, H, P2T, p2b.cam_to_body_from_angle(0.1), ATT)
+    camera.set_cam_to_body(cam)
+    np.testing.assert_allclose(camera.cam_to_body, cam, atol=0)
+    np.testing.assert_allclose(camera.pixel_to_ned(901, 77), p2b.pixel_to_ned(901, 77, W, H, P2T, cam, ATT),
+                               atol=1e-14)
+
+
+@pytest.fixture
+def boresight(quat_mul):
+    """Optical axis (camera +x) in NED."""
+    def axis(attitude, cam):
+        w, x, y, z = quat_mul(attitude, cam)
+        return np.array([1 - 2 * (y * y + z * z), 2 * (x * y + w * z), 2 * (x * z - w * y)])
+    return axis
+
+
+def direction(azimuth, down):
+    return np.array([math.cos(down) * math.cos(azimuth), math.cos(down) * math.sin(azimuth), math.sin(down)])
+
+
+def test_point_gimbal_bare_gimbal_level_body():
+    (pan, tilt, roll), reachable = p2b.point_gimbal(direction(0.6, 0.2), (1.0, 0.0, 0.0, 0.0))
+    assert reachable
+    assert pan == pytest.approx(0.6, abs=1e-14)
+    assert tilt == pytest.approx(0.2, abs=1e-14)
+    assert roll == 0.0
+
+
+def test_point_gimbal_batch_centers_targets(boresight):
+    az, down = np.meshgrid(np.linspace(-3.0, 3.0, 40), np.linspace(-0.6, 0.8, 10))
+    dirs = np.column_stack([np.cos(down.ravel()) * np.cos(az.ravel()), np.cos(down.ravel()) * np.sin(az.ravel()),
+                            np.sin(down.ravel())])
+    angles, reachable = p2b.point_gimbal_batch(dirs, ATT, BASE, SENSOR, current=(0.2, 0.1, 0.3))
+    assert angles.shape == (len(dirs), 3)
+    assert reachable.dtype == np.bool_ and reachable.all()
+    np.testing.assert_array_equal(angles[:, 2], 0.3)
+    for d, (pan, tilt, roll) in zip(dirs, angles):
+        np.testing.assert_allclose(boresight(ATT, p2b.gimbal_cam_to_body(pan, tilt, roll, BASE, SENSOR)), d,
+                                   atol=1e-12)
+
+    # Same answers one at a time
+    (pan, tilt, roll), ok = p2b.point_gimbal(dirs[7], ATT, BASE, SENSOR, current=(0.2, 0.1, 0.3))
+    assert ok
+    np.testing.assert_array_equal(angles[7], [pan, tilt, roll])
+
+
+def test_point_gimbal_limits():
+    dirs = np.array([direction(0.5, -0.5), direction(0.5, 0.5)])
+    angles, reachable = p2b.point_gimbal_batch(dirs, (1.0, 0.0, 0.0, 0.0), tilt_limits=(math.radians(-10), 1.5))
+    np.testing.assert_array_equal(reachable, [False, True])
+    assert angles[0, 1] == pytest.approx(math.radians(-10))
+
+    # Continuous pan takes the short way past +pi from a current pan of 3 rad
+    (pan, _, _), ok = p2b.point_gimbal(direction(-3.0, 0.0), (1.0, 0.0, 0.0, 0.0), current=(3.0, 0.0, 0.0),
+                                       pan_limits=(-2 * math.pi, 2 * math.pi))
+    assert ok
+    assert pan == pytest.approx(2 * math.pi - 3.0)
+
+    with pytest.raises(ValueError):
+        p2b.point_gimbal_batch(dirs, (1.0, 0.0, 0.0, 0.0), pan_limits=(1.0, -1.0))
@@ -0,0 +1,51 @@
+"""Tests for gyro-rate pixel-motion prediction."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 1280, 720
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(70))
+CAM = p2b.cam_to_body_from_angle(math.radians(12))
+RATES = np.array([0.3, -0.2, 1.5])  # rad/s
+DT = 1.0 / 60.0
+
+
+def test_exact_path_matches_pixel_after_rotation(quat_mul, rotvec_quat):
+    att = np.array([0.9848, 0.0, 0.0, 0.1736])
+    att /= np.linalg.norm(att)
+    q_new = quat_mul(att, rotvec_quat(RATES * DT))
+    for row, col in [(640, 360), (100, 650), (1200, 40)]:
+        d_row, d_col, _, exact = p2b.predict_pixel_motion(row, col, W, H, P2T, CAM, RATES, DT, max_error_px=0.0)
+        assert exact
+        r, c = p2b.pixel_after_rotation(row, col, W, H, P2T, CAM, att, q_new, round_back=True)
+        assert round(row + d_row) == r and round(col + d_col) == c
+
+
+def test_fast_path_within_error_estimate():
+    for row, col in [(640.5, 360.5), (10.0, 700.0), (1270.0, 15.0), (333.3, 222.2)]:
+        d_row, d_col, err, exact = p2b.predict_pixel_motion(row, col, W, H, P2T, CAM, RATES, DT, max_error_px=1e9)
+        assert not exact
+        e_row, e_col, _, _ = p2b.predict_pixel_motion(row, col, W, H, P2T, CAM, RATES, DT, max_error_px=0.0)
+        assert math.hypot(d_row - e_row, d_col - e_col) <= err
+
+
+def test_batch_matches_scalar():
+    rng = np.random.default_rng(11)
+    points = np.column_stack([rng.uniform(0, W, 200), rng.uniform(0, H, 200)])
+    motion, error, exact = p2b.predict_pixel_motion_batch(points, W, H, P2T, CAM, RATES, DT, 1.0)
+    assert motion.shape == (200, 2) and error.shape == (200,) and exact.dtype == np.bool_
+    assert exact.any() and not exact.all()  # corners fall back, the center does not
+    np.testing.assert_array_equal(exact, error > 1.0)
+    for i in range(0, 200, 17):
+        d_row, d_col, err, ex = p2b.predict_pixel_motion(*points[i], W, H, P2T, CAM, RATES, DT, 1.0)
+        np.testing.assert_allclose(motion[i], (d_row, d_col), atol=1e-12)
+        assert error[i] == pytest.approx(err) and exact[i] == ex
+
+
+def test_batch_rejects_bad_shape():
+    with pytest.raises(ValueError):
+        p2b.predict_pixel_motion_batch(np.zeros((4, 3)), W, H, P2T, CAM, RATES, DT)
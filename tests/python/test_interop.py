@@ -0,0 +1,69 @@
+"""Zero-copy interop: buffer protocol inputs, DLPack tensors and DLPack outputs."""
+
+import array
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+try:
+    import torch
+except ImportError:
+    torch = None
+
+W, H = 640, 480
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(60))
+CAM = p2b.cam_to_body_from_angle(math.radians(10))
+IDENTITY = np.array([1.0, 0.0, 0.0, 0.0])
+
+ROWS = [0, 100, 320, 639, 17]
+COLS = [0, 400, 240, 479, 300]
+
+
+def _reference():
+    return p2b.pixel_to_ned_batch(np.array(ROWS, dtype=np.uint64), np.array(COLS, dtype=np.uint64),
+                                  W, H, P2T, CAM, IDENTITY)
+
+
+def test_buffer_protocol_inputs():
+    rows = array.array("i", ROWS)  # int32 buffer
+    cols = memoryview(array.array("i", COLS))
+    np.testing.assert_array_equal(p2b.pixel_to_ned_batch(rows, cols, W, H, P2T, CAM, IDENTITY), _reference())
+
+
+def test_to_dlpack_returns_capsule():
+    out = _reference()
+    capsule = p2b.to_dlpack(out)
+    assert type(capsule).__name__ == "PyCapsule"
+
+
+@pytest.mark.skipif(torch is None, reason="PyTorch not installed")
+class TestTorch:
+    def test_tensor_inputs(self):
+        rows = torch.tensor(ROWS, dtype=torch.int32)
+        cols = torch.tensor(COLS, dtype=torch.int32)
+        np.testing.assert_array_equal(p2b.pixel_to_ned_batch(rows, cols, W, H, P2T, CAM, IDENTITY), _reference())
+
+        pairs = torch.stack([rows, cols], dim=1).to(torch.int64)
+        np.testing.assert_array_equal(p2b.pixel_to_ned_batch(pairs, None, W, H, P2T, CAM, IDENTITY), _reference())
+
+    def test_float_tensor_inputs(self):
+        neds = torch.from_numpy(_reference())
+        np.testing.assert_array_equal(
+            p2b.ned_to_pixel_batch(neds, W, H, P2T, CAM, IDENTITY),
+            p2b.ned_to_pixel_batch(_reference(), W, H, P2T, CAM, IDENTITY))
+        np.testing.assert_array_equal(p2b.ned_to_tangents_batch(neds[:, :3]), p2b.ned_to_tangents_batch(_reference()))
+
+    def test_outputs_convert_without_copy(self):
+        out = _reference()
+        tensor = torch.from_dlpack(out)
+        assert tensor.data_ptr() == out.ctypes.data
+        from_capsule = torch.utils.dlpack.from_dlpack(p2b.to_dlpack(out))
+        assert from_capsule.data_ptr() == out.ctypes.data
+
+    def test_unsupported_dtype_rejected(self):
+        with pytest.raises((ValueError, TypeError)):
+            p2b.pixel_to_ned_batch(torch.zeros(3, dtype=torch.uint8), torch.zeros(3, dtype=torch.uint8),
+                                   W, H, P2T, CAM, IDENTITY)
@@ -0,0 +1,67 @@
+"""Tests for the analytic Jacobians of ned_to_pixel and pixel_after_rotation."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 1280, 720
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(70))
+CAM = p2b.cam_to_body_from_angle(math.radians(12))
+ATT = np.array([0.9848, 0.0436, -0.02, 0.1736])
+ATT /= np.linalg.norm(ATT)
+ATT_NEW = np.array([0.9839, 0.0523, 0.0087, 0.1710])
+ATT_NEW /= np.linalg.norm(ATT_NEW)
+PIXELS = [(640, 360), (20, 700), (1250, 30), (300, 500)]
+STEP = 1e-6
+
+
+@pytest.fixture
+def perturbed(quat_mul, rotvec_quat):
+    """q * exp(phi), phi a body-frame rotation vector."""
+    return lambda q, phi: quat_mul(q, rotvec_quat(phi))
+
+
+def central(f):
+    """(2, 3) central differences of f: (3,) step -> (2,) pixel."""
+    return np.column_stack([(f(STEP * e) - f(-STEP * e)) / (2 * STEP) for e in np.eye(3)])
+
+
+def test_ned_to_pixel_jacobian_matches_finite_differences(perturbed):
+    for row, col in PIXELS:
+        ned = p2b.pixel_to_ned(row, col, W, H, P2T, CAM, ATT)
+        pixel, d_dir, d_att = p2b.ned_to_pixel_jacobian(ned, W, H, P2T, CAM, ATT)
+        assert np.all(np.abs(pixel - np.array([row, col])) <= 1.0)
+        project = lambda n, a: p2b.ned_to_pixel_jacobian(n, W, H, P2T, CAM, a)[0]  # noqa: E731
+        np.testing.assert_allclose(d_dir, central(lambda s: project(ned + s, ATT)), rtol=1e-4, atol=1e-2)
+        np.testing.assert_allclose(d_att, central(lambda s: project(ned, perturbed(ATT, s))), rtol=1e-4, atol=1e-2)
+
+
+def test_pixel_after_rotation_jacobian_matches_finite_differences(perturbed):
+    for row, col in PIXELS:
+        pixel, d_old, d_new = p2b.pixel_after_rotation_jacobian(row, col, W, H, P2T, CAM, ATT, ATT_NEW)
+        r, c = p2b.pixel_after_rotation(row, col, W, H, P2T, CAM, ATT, ATT_NEW)
+        assert abs(pixel[0] - r) <= 1.0 and abs(pixel[1] - c) <= 1.0
+        project = lambda qo, qn: p2b.pixel_after_rotation_jacobian(row, col, W, H, P2T, CAM, qo, qn)[0]  # noqa: E731
+        np.testing.assert_allclose(d_old, central(lambda s: project(perturbed(ATT, s), ATT_NEW)), rtol=1e-4, atol=1e-2)
+        np.testing.assert_allclose(d_new, central(lambda s: project(ATT, perturbed(ATT_NEW, s))), rtol=1e-4, atol=1e-2)
+
+
+def test_batch_matches_scalar():
+    rows = np.array([p[0] for p in PIXELS], dtype=np.uint64)
+    cols = np.array([p[1] for p in PIXELS], dtype=np.uint64)
+    neds = p2b.pixel_to_ned_batch(rows, cols, W, H, P2T, CAM, ATT)
+
+    pixels, d_dir, d_att = p2b.ned_to_pixel_jacobian_batch(neds, W, H, P2T, CAM, ATT)
+    assert pixels.shape == (4, 2) and d_dir.shape == (4, 2, 3) and d_att.shape == (4, 2, 3)
+    pixels2, d_old, d_new = p2b.pixel_after_rotation_jacobian_batch(rows, cols, W, H, P2T, CAM, ATT, ATT_NEW)
+    assert pixels2.shape == (4, 2) and d_old.shape == (4, 2, 3) and d_new.shape == (4, 2, 3)
+    for i, (row, col) in enumerate(PIXELS):
+        for got, want in zip((pixels[i], d_dir[i], d_att[i]),
+                             p2b.ned_to_pixel_jacobian(neds[i], W, H, P2T, CAM, ATT)):
+            np.testing.assert_allclose(got, want)
+        for got, want in zip((pixels2[i], d_old[i], d_new[i]),
+                             p2b.pixel_after_rotation_jacobian(row, col, W, H, P2T, CAM, ATT, ATT_NEW)):
+            np.testing.assert_allclose(got, want)
@@ -93,3 +93,41 @@ class TestPixelToTanFromFov:
         for w in [320, 640, 1280, 1920]:
             p2t = p2b.pixel_to_tan_from_fov(w, 480, math.radians(90))
             assert p2t > 0
+
+
+class TestBatchMatchesScalar:
+    PIXELS = [0, 1, 100, 239, 240, 320, 500, 639]
+    TANS = [-0.5, -0.25, 0.0, 0.01, 0.3, 0.5]
+
+    def test_pixel_tan_from_fov_batch(self):
+        fov = math.radians(60)
+        batch = p2b.pixel_tan_from_fov_batch(self.PIXELS, 640, 480, fov)
+        assert batch.shape == (len(self.PIXELS),)
+        for px, value in zip(self.PIXELS, batch):
+            assert value == p2b.pixel_tan_from_fov(px, 640, 480, fov)
+
+    def test_tan_to_pixel_by_fov_batch(self):
+        fov = math.radians(60)
+        batch = p2b.tan_to_pixel_by_fov_batch(self.TANS, 640, 480, fov)
+        assert batch.dtype.name == "uint64"
+        assert list(batch) == [p2b.tan_to_pixel_by_fov(t, 640, 480, fov) for t in self.TANS]
+
+    def test_pixel_to_tan_factor_batches(self):
+        p2t = p2b.pixel_to_tan_from_fov(640, 480, math.radians(90))
+        assert list(p2b.pixel_tan_by_pixel_to_tan_batch(self.PIXELS, 640, 480, p2t)) == [
+            p2b.pixel_tan_by_pixel_to_tan(px, 640, 480, p2t) for px in self.PIXELS]
+        assert list(p2b.angle_tan_to_pixel_batch(self.TANS, 640, 480, p2t)) == [
+            p2b.angle_tan_to_pixel(t, 640, 480, p2t) for t in self.TANS]
+        assert list(p2b.pixel_tan_by_pixel_to_tan_clipped_batch(self.PIXELS, 640, 480, p2t, 0.1)) == [
+            p2b.pixel_tan_by_pixel_to_tan_clipped(px, 640, 480, p2t, 0.1) for px in self.PIXELS]
+        for round_back in (False, True):
+            assert list(p2b.tan_to_pixel_by_pixel_to_tan_batch(self.TANS, 640, 480, p2t, round_back)) == [
+                p2b.tan_to_pixel_by_pixel_to_tan(t, 640, 480, p2t, round_back) for t in self.TANS]
+
+    def test_pixel_to_tan_from_fov_batch(self):
+        fovs = [math.radians(d) for d in (30, 60, 90, 120)]
+        assert list(p2b.pixel_to_tan_from_fov_batch(fovs, 640, 480)) == [
+            p2b.pixel_to_tan_from_fov(640, 480, f) for f in fovs]
+
+    def test_empty_input(self):
+        assert p2b.pixel_tan_from_fov_batch([], 640, 480, 1.0).shape == (0,)
@@ -0,0 +1,95 @@
+"""Tests for the rolling-shutter camera (per-line interpolated attitudes)."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 640, 480
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(60))
+CAM = p2b.cam_to_body_from_angle(math.radians(10))
+
+
+def yaw(deg):
+    half = math.radians(deg) / 2
+    return np.array([math.cos(half), 0.0, 0.0, math.sin(half)])
+
+
+FIRST, LAST = yaw(10.0), yaw(13.0)
+PIXELS = [(0, 0), (320, 240), (639, 479), (100, 400), (500, 50)]
+
+
+@pytest.fixture
+def rs():
+    camera = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    camera.set_attitudes(FIRST, LAST)
+    return camera
+
+
+def test_static_readout_matches_camera():
+    rs = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    rs.set_attitudes(FIRST, FIRST)
+    camera = p2b.Camera(W, H, P2T, CAM, FIRST)
+    for row, col in PIXELS:
+        np.testing.assert_allclose(rs.pixel_to_ned(row, col), camera.pixel_to_ned(row, col), atol=1e-12)
+
+
+def test_line_attitudes(rs):
+    np.testing.assert_allclose(rs.line_attitude(0), FIRST, atol=1e-12)
+    np.testing.assert_allclose(rs.line_attitude(H - 1), LAST, atol=1e-12)
+    np.testing.assert_allclose(rs.line_attitude(H // 2), yaw(10.0 + 3.0 * (H // 2) / (H - 1)), atol=1e-12)
+
+
+def test_pixel_uses_its_line_attitude(rs):
+    for row, col in PIXELS:
+        np.testing.assert_allclose(
+            rs.pixel_to_ned(row, col),
+            p2b.pixel_to_ned(row, col, W, H, P2T, CAM, np.array(rs.line_attitude(col))), atol=1e-12)
+
+
+def test_ned_to_pixel_roundtrip(rs):
+    for row, col in PIXELS:
+        r, c = rs.ned_to_pixel(rs.pixel_to_ned(row, col))
+        assert abs(r - row) <= 1 and abs(c - col) <= 1
+
+
+def test_attitude_series_matches_endpoints(rs):
+    series = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    series.set_attitude_series(np.stack([yaw(10.0), yaw(11.5), yaw(13.0)]), 0.0075, 0.015)
+    for col in range(0, H, 37):
+        np.testing.assert_allclose(series.line_attitude(col), rs.line_attitude(col), atol=1e-12)
+
+
+def test_attitude_series_from_scipy(rs):
+    Rotation = pytest.importorskip("scipy.spatial.transform").Rotation
+    series = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    series.set_attitude_series(Rotation.from_euler("z", [[10.0], [13.0]], degrees=True), 0.015, 0.015)
+    np.testing.assert_allclose(series.line_attitude(H - 1), rs.line_attitude(H - 1), atol=1e-12)
+
+
+def test_batch_matches_scalar(rs):
+    rows = np.array([p[0] for p in PIXELS], dtype=np.uint64)
+    cols = np.array([p[1] for p in PIXELS], dtype=np.uint64)
+    neds = rs.pixel_to_ned_batch(rows, cols)
+    assert neds.shape == (len(PIXELS), 3)
+    for i, (row, col) in enumerate(PIXELS):
+        np.testing.assert_allclose(neds[i], rs.pixel_to_ned(row, col))
+        assert tuple(rs.ned_to_pixel_batch(neds)[i]) == rs.ned_to_pixel(tuple(neds[i]))
+
+    following = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    following.set_attitudes(LAST, yaw(16.0))
+    moved = rs.pixel_after_rotation_batch(rows, cols, following, True)
+    for i, (row, col) in enumerate(PIXELS):
+        assert tuple(moved[i]) == rs.pixel_after_rotation(row, col, following, True)
+
+
+def test_pixel_after_rotation_same_frame_is_identity(rs):
+    assert rs.pixel_after_rotation(320, 240, rs, True) == (320, 240)
+
+
+def test_empty_series_rejected():
+    rs = p2b.RollingShutterCamera(W, H, P2T, CAM)
+    with pytest.raises(ValueError):
+        rs.set_attitude_series(np.zeros((0, 4)), 0.005, 0.015)
@@ -0,0 +1,66 @@
+"""Tests for rotation estimation from pixel correspondences."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 1280, 720
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(70))
+CAM = p2b.cam_to_body_from_angle(math.radians(12))
+Q_OLD = np.array([0.9848, 0.0436, -0.02, 0.1736])
+Q_OLD /= np.linalg.norm(Q_OLD)
+Q_NEW = np.array([0.9839, 0.0523, 0.0087, 0.1710])
+Q_NEW /= np.linalg.norm(Q_NEW)
+
+
+def matches(n, seed=3):
+    """(N, 2) integer pixels in the old frame and their continuous positions in the new one."""
+    rng = np.random.default_rng(seed)
+    rows = rng.integers(20, W - 20, n).astype(np.uint64)
+    cols = rng.integers(20, H - 20, n).astype(np.uint64)
+    moved, _, _ = p2b.pixel_after_rotation_jacobian_batch(rows, cols, W, H, P2T, CAM, Q_OLD, Q_NEW)
+    return np.column_stack([rows, cols]).astype(np.float64), moved
+
+
+def test_recovers_attitude_change(rotation_angle):
+    a, b = matches(500)
+    rotation = p2b.estimate_rotation(a, b, W, H, P2T)
+    assert rotation.shape == (4,) and rotation[0] >= 0.0
+    assert rotation_angle(p2b.attitude_after_rotation(Q_OLD, CAM, rotation), Q_NEW) < 1e-9
+
+
+def test_stabilizes_like_true_attitude():
+    a, b = matches(50)
+    q_new = p2b.attitude_after_rotation(Q_OLD, CAM, p2b.estimate_rotation(a, b, W, H, P2T))
+    rows, cols = a[:, 0].astype(np.uint64), a[:, 1].astype(np.uint64)
+    np.testing.assert_array_equal(p2b.pixel_after_rotation_batch(rows, cols, W, H, P2T, CAM, Q_OLD, q_new),
+                                  p2b.pixel_after_rotation_batch(rows, cols, W, H, P2T, CAM, Q_OLD, Q_NEW))
+
+
+def test_noise_and_weights(rotation_angle):
+    a, b = matches(2000)
+    rng = np.random.default_rng(5)
+    noisy = b + rng.uniform(-0.5, 0.5, b.shape)
+    assert rotation_angle(p2b.attitude_after_rotation(Q_OLD, CAM, p2b.estimate_rotation(a, noisy, W, H, P2T)),
+                          Q_NEW) < 0.05 * P2T
+
+    # Zero-weight outliers are ignored; strided views are read in place
+    noisy[:100] = rng.uniform(0, H, (100, 2))
+    weights = np.ones(len(a))
+    weights[:100] = 0.0
+    both = np.hstack([a, noisy])
+    rotation = p2b.estimate_rotation(both[:, :2], both[:, 2:], W, H, P2T, weights)
+    assert rotation_angle(p2b.attitude_after_rotation(Q_OLD, CAM, rotation), Q_NEW) < 0.05 * P2T
+
+
+def test_rejects_bad_shapes():
+    a, b = matches(10)
+    with pytest.raises(ValueError):
+        p2b.estimate_rotation(a, b[:5], W, H, P2T)
+    with pytest.raises(ValueError):
+        p2b.estimate_rotation(np.zeros((10, 3)), b, W, H, P2T)
+    with pytest.raises(ValueError):
+        p2b.estimate_rotation(a, b, W, H, P2T, np.ones(3))
@@ -0,0 +1,64 @@
+"""Tests for outlier-robust rotation estimation (RANSAC)."""
+
+import math
+
+import numpy as np
+import pytest
+
+import image_to_body_math as p2b
+
+W, H = 1280, 720
+P2T = p2b.pixel_to_tan_from_fov(W, H, math.radians(70))
+CAM = p2b.cam_to_body_from_angle(math.radians(12))
+Q_OLD = np.array([0.9848, 0.0436, -0.02, 0.1736])
+Q_OLD /= np.linalg.norm(Q_OLD)
+Q_NEW = np.array([0.9839, 0.0523, 0.0087, 0.1710])
+Q_NEW /= np.linalg.norm(Q_NEW)
+
+
+def matches(n, outlier_fraction, seed=9):
+    """Old-frame pixels, new-frame matches with 0.3 px jitter, and the outlier mask."""
+    rng = np.random.default_rng(seed)
+    rows = rng.integers(20, W - 20, n).astype(np.uint64)
+    cols = rng.integers(20, H - 20, n).astype(np.uint64)
+    moved, _, _ = p2b.pixel_after_rotation_jacobian_batch(rows, cols, W, H, P2T, CAM, Q_OLD, Q_NEW)
+    moved += rng.uniform(-0.3, 0.3, moved.shape)
+    outlier = rng.random(n) < outlier_fraction
+    moved[outlier] = np.column_stack([rng.uniform(0, W, outlier.sum()), rng.uniform(0, H, outlier.sum())])
+    return np.column_stack([rows, cols]).astype(np.float64), moved, outlier
+
+
+def test_rejects_outliers(rotation_angle):
+    a, b, outlier = matches(1000, 0.4)
+    rotation, mask, iterations = p2b.estimate_rotation_ransac(a, b, W, H, P2T)
+    assert rotation.shape == (4,) and mask.shape == (1000,) and mask.dtype == np.bool_
+    assert 0 < iterations < 256
+    assert rotation_angle(p2b.attitude_after_rotation(Q_OLD, CAM, rotation), Q_NEW) < 0.05 * P2T
+    assert np.count_nonzero(mask == outlier) < 5  # a random outlier can land within a pixel of its match
+
+    # The plain least-squares fit is pulled off by the same outliers
+    plain = p2b.estimate_rotation(a, b, W, H, P2T)
+    assert rotation_angle(p2b.attitude_after_rotation(Q_OLD, CAM, plain), Q_NEW) > 10 * P2T
+
+
+def test_seed_is_deterministic():
+    a, b, _ = matches(300, 0.3)
+    r1, m1, it1 = p2b.estimate_rotation_ransac(a, b, W, H, P2T, seed=5)
+    r2, m2, it2 = p2b.estimate_rotation_ransac(a, b, W, H, P2T, seed=5)
+    np.testing.assert_array_equal(r1, r2)
+    np.testing.assert_array_equal(m1, m2)
+    assert it1 == it2
+
+
+def test_no_consensus():
+    a = np.array([[100.0, 100.0]])
+    _, mask, _ = p2b.estimate_rotation_ransac(a, a, W, H, P2T)
+    assert not mask.any()
+
+
+def test_rejects_bad_shapes():
+    a, b, _ = matches(10, 0.0)
+    with pytest.raises(ValueError):
+        p2b.estimate_rotation_ransac(a, b[:5], W, H, P2T)
+    with pytest.raises(ValueError):
+        p2b.estimate_rotation_ransac(a[:, :1], b, W, H, P2T)